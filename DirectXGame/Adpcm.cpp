@@ -0,0 +1,273 @@
+#include "Adpcm.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ADPCM_USE_SSE2 1
+#endif
+
+namespace {
+
+const int16_t kStepTable[89] = {7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,    31,    34,    37,
+                                41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,
+                                230,   253,   279,   307,   337,   371,   408,   449,   494,   544,   598,   658,   724,   796,   876,   963,   1060,  1166,
+                                1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,
+                                7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+const int8_t kIndexTable[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+uint32_t Read32(const uint8_t* p) {
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+// 1サンプルぶん進めて新しい値を返す
+int DecodeNibble(uint32_t nibble, int& predictor, int& index) {
+	const int step = kStepTable[index];
+	int diff = step >> 3;
+	if (nibble & 4u)
+		diff += step;
+	if (nibble & 2u)
+		diff += step >> 1;
+	if (nibble & 1u)
+		diff += step >> 2;
+	predictor = std::clamp((nibble & 8u) ? predictor - diff : predictor + diff, -32768, 32767);
+	index = std::clamp(index + kIndexTable[nibble], 0, 88);
+	return predictor;
+}
+
+// 1本の列（あるブロックのあるチャンネル）
+struct Lane {
+	const uint8_t* header; // 最初のサンプルとステップ番号
+	const uint8_t* words;  // 本体の最初の 4 バイト
+	uint32_t wordStride;   // 次の 4 バイトまで（4 * チャンネル数）
+	int16_t* out;
+	uint32_t outStride; // チャンネル数
+};
+
+void DecodeLane(const Lane& lane, uint32_t groups) {
+	int predictor = static_cast<int16_t>(lane.header[0] | (lane.header[1] << 8));
+	int index = std::min<int>(lane.header[2], 88);
+	lane.out[0] = static_cast<int16_t>(predictor);
+	int16_t* out = lane.out + lane.outStride;
+	for (uint32_t g = 0; g < groups; ++g) {
+		uint32_t word = Read32(lane.words + size_t(g) * lane.wordStride);
+		for (uint32_t j = 0; j < 8u; ++j, word >>= 4, out += lane.outStride)
+			*out = static_cast<int16_t>(DecodeNibble(word & 0xFu, predictor, index));
+	}
+}
+
+#ifdef ADPCM_USE_SSE2
+// 4本の列を各レーンに載せて同時に展開する（本体の長さは揃っていること）
+void DecodeLanes4(const Lane* lanes, uint32_t groups) {
+	__m128i predictor = _mm_setzero_si128();
+	__m128i index = _mm_setzero_si128();
+	{
+		alignas(16) int32_t p[4];
+		alignas(16) int32_t s[4];
+		for (int k = 0; k < 4; ++k) {
+			p[k] = static_cast<int16_t>(lanes[k].header[0] | (lanes[k].header[1] << 8));
+			s[k] = std::min<int>(lanes[k].header[2], 88);
+			lanes[k].out[0] = static_cast<int16_t>(p[k]);
+		}
+		predictor = _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+		index = _mm_load_si128(reinterpret_cast<const __m128i*>(s));
+	}
+
+	const __m128i mask15 = _mm_set1_epi32(15);
+	const __m128i bit1 = _mm_set1_epi32(1);
+	const __m128i bit2 = _mm_set1_epi32(2);
+	const __m128i bit3 = _mm_set1_epi32(3);
+	const __m128i bit4 = _mm_set1_epi32(4);
+	const __m128i bit8 = _mm_set1_epi32(8);
+	const __m128i minusOne = _mm_set1_epi32(-1);
+	const __m128i maxIndex = _mm_set1_epi32(88);
+
+	alignas(16) int32_t indices[4];
+	alignas(16) int32_t values[8][4];
+	for (uint32_t g = 0; g < groups; ++g) {
+		__m128i word = _mm_set_epi32(static_cast<int32_t>(Read32(lanes[3].words + size_t(g) * lanes[3].wordStride)),
+		                             static_cast<int32_t>(Read32(lanes[2].words + size_t(g) * lanes[2].wordStride)),
+		                             static_cast<int32_t>(Read32(lanes[1].words + size_t(g) * lanes[1].wordStride)),
+		                             static_cast<int32_t>(Read32(lanes[0].words + size_t(g) * lanes[0].wordStride)));
+		for (uint32_t j = 0; j < 8u; ++j) {
+			const __m128i nibble = _mm_and_si128(word, mask15);
+			word = _mm_srli_epi32(word, 4);
+
+			// ステップ表だけは各レーンで引く
+			_mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+			const __m128i step = _mm_set_epi32(kStepTable[indices[3]], kStepTable[indices[2]], kStepTable[indices[1]], kStepTable[indices[0]]);
+
+			const __m128i has4 = _mm_cmpeq_epi32(_mm_and_si128(nibble, bit4), bit4);
+			const __m128i has2 = _mm_cmpeq_epi32(_mm_and_si128(nibble, bit2), bit2);
+			const __m128i has1 = _mm_cmpeq_epi32(_mm_and_si128(nibble, bit1), bit1);
+			const __m128i negative = _mm_cmpeq_epi32(_mm_and_si128(nibble, bit8), bit8);
+			__m128i diff = _mm_srai_epi32(step, 3);
+			diff = _mm_add_epi32(diff, _mm_and_si128(has4, step));
+			diff = _mm_add_epi32(diff, _mm_and_si128(has2, _mm_srai_epi32(step, 1)));
+			diff = _mm_add_epi32(diff, _mm_and_si128(has1, _mm_srai_epi32(step, 2)));
+			// 負なら (diff ^ -1) - (-1) = -diff
+			predictor = _mm_add_epi32(predictor, _mm_sub_epi32(_mm_xor_si128(diff, negative), negative));
+			// int16 へ飽和させて符号拡張で戻す
+			const __m128i packed = _mm_packs_epi32(predictor, predictor);
+			predictor = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+
+			// 番号の増減：下位 3bit が 4 以上なら (n & 3) * 2 + 2、それ以外は -1
+			const __m128i low = _mm_and_si128(nibble, bit3);
+			const __m128i up = _mm_add_epi32(_mm_add_epi32(low, low), bit2);
+			index = _mm_add_epi32(index, _mm_or_si128(_mm_and_si128(has4, up), _mm_andnot_si128(has4, minusOne)));
+			// -1 ～ 96 なので 16bit の min / max で足りる（上位 16bit は 0 か -1）
+			index = _mm_min_epi16(_mm_max_epi16(index, _mm_setzero_si128()), maxIndex);
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(values[j]), predictor);
+		}
+		for (int k = 0; k < 4; ++k) {
+			int16_t* out = lanes[k].out + (1u + g * 8u) * lanes[k].outStride;
+			for (uint32_t j = 0; j < 8u; ++j, out += lanes[k].outStride)
+				*out = static_cast<int16_t>(values[j][k]);
+		}
+	}
+}
+#endif
+
+// firstBlock から blockCount 個のブロックを展開する。長さの揃った列が 4 本たまるごとに流す（確保はしない）
+uint32_t Decode(const WaveFormat& format, const uint8_t* data, size_t dataSize, uint32_t firstBlock, uint32_t blockCount, int16_t* out, bool simd) {
+	const uint32_t channels = format.channels;
+	const uint32_t header = 4u * channels;
+	Lane pending[4];
+	uint32_t pendingCount = 0u;
+	uint32_t pendingGroups = 0u;
+	auto flush = [&]() {
+		for (uint32_t i = 0; i < pendingCount; ++i)
+			DecodeLane(pending[i], pendingGroups);
+		pendingCount = 0u;
+	};
+
+	uint32_t frames = 0u;
+	for (uint32_t b = firstBlock; b < firstBlock + blockCount; ++b) {
+		const size_t offset = size_t(b) * format.blockAlign;
+		if (offset + header > dataSize)
+			break;
+		// 最後のブロックは短いことがある
+		const size_t bytes = std::min<size_t>(format.blockAlign, dataSize - offset);
+		const uint32_t groups = static_cast<uint32_t>((bytes - header) / header);
+		const uint8_t* block = data + offset;
+		for (uint32_t c = 0; c < channels; ++c) {
+			if (pendingCount > 0u && groups != pendingGroups)
+				flush();
+			pending[pendingCount++] = {block + 4u * c, block + header + 4u * c, header, out + size_t(frames) * channels + c, channels};
+			pendingGroups = groups;
+			if (pendingCount == 4u) {
+#ifdef ADPCM_USE_SSE2
+				if (simd) {
+					DecodeLanes4(pending, groups);
+					pendingCount = 0u;
+					continue;
+				}
+#endif
+				flush();
+			}
+		}
+		frames += 1u + groups * 8u;
+	}
+	flush();
+	return frames;
+}
+
+} // namespace
+
+namespace Adpcm {
+
+bool IsValidFormat(const WaveFormat& format) {
+	return format.formatTag == kFormatTag && format.bitsPerSample == 4u && (format.channels == 1u || format.channels == 2u) && format.samplesPerBlock >= 9u &&
+	       (format.samplesPerBlock - 1u) % 8u == 0u && format.blockAlign == BlockBytes(format.channels, format.samplesPerBlock);
+}
+
+uint32_t CountFrames(const WaveFormat& format, size_t dataSize) {
+	if (!IsValidFormat(format))
+		return 0u;
+	const uint32_t header = 4u * format.channels;
+	const size_t full = dataSize / format.blockAlign;
+	const size_t rest = dataSize % format.blockAlign;
+	size_t frames = full * format.samplesPerBlock;
+	if (rest >= header)
+		frames += 1u + (rest - header) / header * 8u;
+	return static_cast<uint32_t>(frames);
+}
+
+uint32_t DecodeBlocks(const WaveFormat& format, const uint8_t* data, size_t dataSize, uint32_t firstBlock, uint32_t blockCount, int16_t* out) {
+	return Decode(format, data, dataSize, firstBlock, blockCount, out, true);
+}
+
+uint32_t DecodeBlocksScalar(const WaveFormat& format, const uint8_t* data, size_t dataSize, uint32_t firstBlock, uint32_t blockCount, int16_t* out) {
+	return Decode(format, data, dataSize, firstBlock, blockCount, out, false);
+}
+
+std::vector<uint8_t> Encode(const int16_t* samples, size_t frames, uint32_t channels, uint32_t samplesPerBlock) {
+	std::vector<uint8_t> out;
+	if (frames == 0u || channels == 0u)
+		return out;
+	const uint32_t header = 4u * channels;
+	std::vector<uint32_t> nibbles(samplesPerBlock);
+	std::vector<uint32_t> best(samplesPerBlock);
+
+	for (size_t start = 0; start < frames; start += samplesPerBlock) {
+		// 最後のブロックは 8 サンプルの組の単位で切り詰め、足りない分は最後の値で埋める
+		const uint32_t count = static_cast<uint32_t>(std::min<size_t>(samplesPerBlock, frames - start));
+		const uint32_t groups = (count - 1u + 7u) / 8u;
+		auto sample = [&](uint32_t i, uint32_t c) { return int(samples[(start + std::min(i, count - 1u)) * channels + c]); };
+
+		const size_t blockOffset = out.size();
+		out.resize(blockOffset + header + size_t(groups) * header, 0u);
+		uint8_t* block = out.data() + blockOffset;
+		for (uint32_t c = 0; c < channels; ++c) {
+			// 最初のステップ番号を全部試して二乗誤差の一番小さいものを使う
+			uint64_t bestError = UINT64_MAX;
+			int bestIndex = 0;
+			for (int first = 0; first <= 88; ++first) {
+				int predictor = sample(0, c);
+				int index = first;
+				uint64_t error = 0u;
+				for (uint32_t i = 1; i <= groups * 8u && error < bestError; ++i) {
+					const int target = sample(i, c);
+					// 符号は差の向きで決め、大きさ 8 通りのうち一番近いもの
+					const uint32_t sign = target < predictor ? 8u : 0u;
+					uint32_t chosen = sign;
+					int chosenError = INT32_MAX;
+					for (uint32_t m = 0; m < 8u; ++m) {
+						int p = predictor;
+						int x = index;
+						const int e = std::abs(DecodeNibble(sign | m, p, x) - target);
+						if (e < chosenError) {
+							chosenError = e;
+							chosen = sign | m;
+						}
+					}
+					DecodeNibble(chosen, predictor, index);
+					nibbles[i - 1u] = chosen;
+					error += uint64_t(chosenError) * uint64_t(chosenError);
+				}
+				if (error < bestError) {
+					bestError = error;
+					bestIndex = first;
+					std::copy(nibbles.begin(), nibbles.begin() + groups * 8u, best.begin());
+				}
+			}
+
+			const int16_t firstSample = static_cast<int16_t>(sample(0, c));
+			std::memcpy(block + 4u * c, &firstSample, sizeof(firstSample));
+			block[4u * c + 2u] = static_cast<uint8_t>(bestIndex);
+			for (uint32_t g = 0; g < groups; ++g) {
+				uint8_t* word = block + header + size_t(g) * header + 4u * c;
+				for (uint32_t j = 0; j < 8u; j += 2u)
+					word[j / 2u] = static_cast<uint8_t>(best[g * 8u + j] | (best[g * 8u + j + 1u] << 4));
+			}
+		}
+	}
+	return out;
+}
+
+} // namespace Adpcm
@@ -0,0 +1,35 @@
+#pragma once
+#include "WaveFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// IMA-ADPCM（WAVE_FORMAT_IMA_ADPCM = 0x11、1サンプル 4bit）の符号化・展開
+// ・ブロックはチャンネルごとのヘッダ 4 バイト（最初のサンプル int16・ステップ番号・0）と、
+//   チャンネルごとに 4 バイト（8 サンプル）ずつ交互に並ぶ本体。ブロックどうしは独立している
+// ・展開は独立した列（ブロック × チャンネル）を 4 本ずつ SIMD の各レーンに載せて同時に進める
+// ・符号化（Tools/AudioConvert の -a）はブロックごとに最初のステップ番号を全部試し、誤差が一番小さいものを使う
+namespace Adpcm {
+
+const uint16_t kFormatTag = 0x11u;
+
+// 1ブロックのバイト数（samplesPerBlock は 8 の倍数 + 1）
+inline uint32_t BlockBytes(uint32_t channels, uint32_t samplesPerBlock) { return channels * (4u + (samplesPerBlock - 1u) / 2u); }
+
+// 展開できる形式か（1 / 2ch、4bit、ブロックの大きさが samplesPerBlock と合っている）
+bool IsValidFormat(const WaveFormat& format);
+
+// data の中のフレーム数（最後のブロックは短くてよい）
+uint32_t CountFrames(const WaveFormat& format, size_t dataSize);
+
+// firstBlock 番から blockCount 個のブロックを展開し、out に LRLR... の int16 で書く。書いたフレーム数を返す
+uint32_t DecodeBlocks(const WaveFormat& format, const uint8_t* data, size_t dataSize, uint32_t firstBlock, uint32_t blockCount, int16_t* out);
+
+// SIMD を使わず1列ずつ展開する（DecodeBlocks と同じ結果。比べる用）
+uint32_t DecodeBlocksScalar(const WaveFormat& format, const uint8_t* data, size_t dataSize, uint32_t firstBlock, uint32_t blockCount, int16_t* out);
+
+// LRLR... の int16 を符号化して data チャンクの中身を返す
+// 最後のブロックは 8 サンプルの組の単位まで短くし、余りは最後の値で埋める（フレーム数が最大 7 増える）
+std::vector<uint8_t> Encode(const int16_t* samples, size_t frames, uint32_t channels, uint32_t samplesPerBlock);
+
+} // namespace Adpcm
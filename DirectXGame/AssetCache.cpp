@@ -0,0 +1,300 @@
+#include "AssetCache.h"
+#include "AssetPack.h"
+#include "FileBytes.h"
+#include "Hash.h"
+#include "MeshBlob.h"
+#include "TextureFile.h"
+#include <chrono>
+
+using namespace KamataEngine;
+
+AssetCache* AssetCache::GetInstance() {
+	static AssetCache instance;
+	return &instance;
+}
+
+namespace {
+
+// パックにあればパックの中身、なければファイルのハッシュ
+bool HashAsset(const std::string& path, uint64_t& hash) {
+	std::vector<uint8_t> storage;
+	std::span<const uint8_t> data;
+	if (!AssetPack::GetInstance()->Load(path, storage, data))
+		return false;
+	hash = HashBytes(data.data(), data.size());
+	return true;
+}
+
+} // namespace
+
+uint64_t AssetCache::ContentHashOf(const std::string& name, bool smoothing) {
+	const std::string base = "Resources/" + name + "/" + name;
+	uint64_t hashes[2] = {};
+	if (!HashAsset(base + ".mesh", hashes[0]) && !HashAsset(base + ".obj", hashes[0]))
+		return 0u; // ファイルが読めない（既定モデルになる）ものは内容で共有しない
+
+	// テクスチャ名は MTL 側にあるので、それも含めて一致したものだけ共有する
+	HashAsset(base + ".mtl", hashes[1]);
+	uint64_t hash = HashBytes(hashes, sizeof(hashes));
+	return smoothing ? HashBytes(&hash, sizeof(hash), 1u) : hash;
+}
+
+std::shared_ptr<ModelAsset> AssetCache::AcquireModel(const std::string& name, bool smoothing, Retention retention) {
+	const std::string key = ModelKey(name, smoothing);
+
+	// 先読み中なら仕上げてから引く
+	if (std::shared_ptr<Pending> pending = TakePending(Pending::Kind::kModel, key))
+		FinishPending(*pending);
+
+	// パスで一致
+	auto it = models_.find(key);
+	if (it != models_.end()) {
+		stats_.hits++;
+		if (retention == Retention::kPersistent)
+			it->second.retention = Retention::kPersistent;
+		return it->second.asset;
+	}
+
+	return InsertModel(key, name, smoothing, retention, ContentHashOf(name, smoothing), {});
+}
+
+std::shared_ptr<ModelAsset> AssetCache::InsertModel(const std::string& key, const std::string& name, bool smoothing, Retention retention, uint64_t contentHash, std::span<const uint8_t> blob) {
+	ModelEntry entry;
+	entry.contentHash = contentHash;
+	entry.retention = retention;
+
+	// 別パスでも中身が同じなら共有（平滑化の有無も一致するものだけ）
+	if (entry.contentHash != 0u) {
+		auto same = modelsByContent_.find(entry.contentHash);
+		if (same != modelsByContent_.end()) {
+			auto src = models_.find(same->second);
+			if (src != models_.end()) {
+				entry.asset = src->second.asset;
+				stats_.shared++;
+			}
+		}
+	}
+
+	if (!entry.asset) {
+		if (!blob.empty())
+			entry.asset.reset(ModelAsset::CreateFromBlob(name, blob.data(), blob.size()));
+		if (!entry.asset)
+			entry.asset.reset(ModelAsset::Load(name, smoothing));
+		stats_.loads++;
+		if (entry.contentHash != 0u)
+			modelsByContent_[entry.contentHash] = key;
+	}
+
+	std::shared_ptr<ModelAsset> asset = entry.asset;
+	models_.emplace(key, std::move(entry));
+	stats_.models = static_cast<uint32_t>(models_.size());
+	return asset;
+}
+
+void AssetCache::PreloadModel(const std::string& name, bool smoothing, Retention retention) { AcquireModel(name, smoothing, retention); }
+
+uint32_t AssetCache::AcquireSound(const std::string& path) {
+	if (std::shared_ptr<Pending> pending = TakePending(Pending::Kind::kSound, path))
+		FinishPending(*pending);
+
+	auto it = sounds_.find(path);
+	if (it != sounds_.end()) {
+		stats_.hits++;
+		return it->second;
+	}
+	uint32_t handle = Audio::GetInstance()->LoadWave(path);
+	stats_.loads++;
+	sounds_.emplace(path, handle);
+	return handle;
+}
+
+void AssetCache::PrefetchModel(const std::string& name, bool smoothing, Retention retention) {
+	const std::string key = ModelKey(name, smoothing);
+	auto it = models_.find(key);
+	if (it != models_.end()) {
+		if (retention == Retention::kPersistent)
+			it->second.retention = Retention::kPersistent;
+		return;
+	}
+	for (const std::shared_ptr<Pending>& p : pending_) {
+		if (p->kind == Pending::Kind::kModel && p->key == key) {
+			if (retention == Retention::kPersistent)
+				p->retention = Retention::kPersistent;
+			return;
+		}
+	}
+
+	std::shared_ptr<Pending> pending = std::make_shared<Pending>();
+	pending->kind = Pending::Kind::kModel;
+	pending->name = name;
+	pending->key = key;
+	pending->smoothing = smoothing;
+	pending->retention = retention;
+	Submit(std::move(pending));
+}
+
+void AssetCache::PrefetchSound(const std::string& path) {
+	if (sounds_.count(path))
+		return;
+	for (const std::shared_ptr<Pending>& p : pending_) {
+		if (p->kind == Pending::Kind::kSound && p->key == path)
+			return;
+	}
+
+	std::shared_ptr<Pending> pending = std::make_shared<Pending>();
+	pending->kind = Pending::Kind::kSound;
+	pending->name = path;
+	pending->key = path;
+	Submit(std::move(pending));
+}
+
+void AssetCache::PrefetchTexture(const std::string& fileName) {
+	for (const std::shared_ptr<Pending>& p : pending_) {
+		if (p->kind == Pending::Kind::kTexture && p->key == fileName)
+			return;
+	}
+
+	std::shared_ptr<Pending> pending = std::make_shared<Pending>();
+	pending->kind = Pending::Kind::kTexture;
+	pending->name = fileName;
+	pending->key = fileName;
+	Submit(std::move(pending));
+}
+
+void AssetCache::Submit(std::shared_ptr<Pending> pending) {
+	// ジョブ側も shared_ptr を持つので、仕上げ前に Clear されても中身は生きている
+	Pending* raw = pending.get();
+	JobSystem::GetInstance()->Submit([pending] { LoadPending(*pending); }, &raw->counter);
+	pending_.push_back(std::move(pending));
+}
+
+void AssetCache::LoadPending(Pending& pending) {
+	std::vector<uint8_t> bytes;
+	switch (pending.kind) {
+	case Pending::Kind::kModel: {
+		// .mesh を読んで検証まで済ませる（壊れていれば仕上げで OBJ から読む）
+		const std::string dir = "Resources/" + pending.name + "/";
+		if (AssetPack::GetInstance()->Load(dir + pending.name + ".mesh", pending.blobStorage, pending.blob)) {
+			const MeshBlob::Header* header = MeshBlob::Validate(pending.blob.data(), pending.blob.size());
+			if (header) {
+				// 仕上げの Material::LoadTexture で待たないよう、テクスチャもファイルキャッシュに載せておく
+				const MeshBlob::Material* materials = MeshBlob::At<MeshBlob::Material>(pending.blob.data(), header->materialsOffset);
+				for (uint32_t i = 0; i < header->materialCount; ++i) {
+					if (materials[i].textureFilename[0] != '\0')
+						CanonicalTexture(pending.name + "/" + materials[i].textureFilename); // 中身のハッシュもここで済ませる
+				}
+			} else {
+				pending.blob = {};
+			}
+		}
+		pending.contentHash = ContentHashOf(pending.name, pending.smoothing);
+		break;
+	}
+	case Pending::Kind::kSound:
+		// LoadWave はパスしか受け取らないので、同じパス（Resources/ 付き）を読んでファイルキャッシュに載せておく
+		ReadFileBytes("Resources/" + pending.name, bytes);
+		break;
+	case Pending::Kind::kTexture:
+		CanonicalTexture(pending.name); // 読んでハッシュまで済ませる（ファイルキャッシュにも載る）
+		break;
+	}
+}
+
+void AssetCache::FinishPending(Pending& pending) {
+	JobSystem::GetInstance()->Wait(pending.counter);
+
+	switch (pending.kind) {
+	case Pending::Kind::kModel: {
+		auto it = models_.find(pending.key);
+		if (it != models_.end()) {
+			if (pending.retention == Retention::kPersistent)
+				it->second.retention = Retention::kPersistent;
+			break;
+		}
+		InsertModel(pending.key, pending.name, pending.smoothing, pending.retention, pending.contentHash, pending.blob);
+		break;
+	}
+	case Pending::Kind::kSound:
+		if (!sounds_.count(pending.key)) {
+			sounds_.emplace(pending.key, Audio::GetInstance()->LoadWave(pending.name));
+			stats_.loads++;
+		}
+		break;
+	case Pending::Kind::kTexture:
+		LoadTextureShared(pending.name); // 読み込み済みなら TextureManager 側で同じハンドルが返る
+		break;
+	}
+	pending.blob = {};
+	pending.blobStorage.clear();
+	pending.blobStorage.shrink_to_fit();
+}
+
+std::shared_ptr<AssetCache::Pending> AssetCache::TakePending(Pending::Kind kind, const std::string& key) {
+	for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+		if ((*it)->kind == kind && (*it)->key == key) {
+			std::shared_ptr<Pending> pending = std::move(*it);
+			pending_.erase(it);
+			return pending;
+		}
+	}
+	return nullptr;
+}
+
+void AssetCache::UpdateLoading(double budgetMs) {
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+	JobSystem* jobs = JobSystem::GetInstance();
+
+	// 依頼順に、読み終わっているものだけ仕上げる
+	for (auto it = pending_.begin(); it != pending_.end();) {
+		if (!jobs->IsDone((*it)->counter)) {
+			++it;
+			continue;
+		}
+		std::shared_ptr<Pending> pending = std::move(*it);
+		it = pending_.erase(it);
+		FinishPending(*pending);
+
+		if (std::chrono::duration<double, std::milli>(Clock::now() - start).count() >= budgetMs)
+			break;
+	}
+}
+
+size_t AssetCache::Trim() {
+	// 実体ごとにキャッシュ自身が持っている参照数（内容共有で複数のパスが同じ実体を指す）
+	std::unordered_map<const ModelAsset*, long> cacheRefs;
+	for (const auto& m : models_)
+		cacheRefs[m.second.asset.get()]++;
+
+	size_t released = 0u;
+	for (auto it = models_.begin(); it != models_.end();) {
+		const ModelEntry& e = it->second;
+		long& refs = cacheRefs[e.asset.get()];
+		// キャッシュ以外からの参照がないもの
+		if (e.retention == Retention::kScene && e.asset.use_count() == refs) {
+			auto byContent = modelsByContent_.find(e.contentHash);
+			if (byContent != modelsByContent_.end() && byContent->second == it->first)
+				modelsByContent_.erase(byContent);
+			refs--;
+			it = models_.erase(it);
+			released++;
+		} else {
+			++it;
+		}
+	}
+	stats_.released += static_cast<uint32_t>(released);
+	stats_.models = static_cast<uint32_t>(models_.size());
+	return released;
+}
+
+void AssetCache::Clear() {
+	// 読み込み中のジョブが終わるのを待ってから捨てる
+	for (const std::shared_ptr<Pending>& pending : pending_)
+		JobSystem::GetInstance()->Wait(pending->counter);
+	pending_.clear();
+
+	models_.clear();
+	modelsByContent_.clear();
+	sounds_.clear();
+	stats_.models = 0u;
+}
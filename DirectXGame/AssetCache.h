@@ -0,0 +1,114 @@
+#pragma once
+#include "JobSystem.h"
+#include "ModelAsset.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace KamataEngine;
+
+// シーンをまたいで共有するアセットキャッシュ
+// ・モデルはパス + 内容ハッシュで引く。別パスでも中身が同じなら同じ実体を返す
+// ・参照は shared_ptr で数え、どこからも参照されなくなったものは Trim で解放する
+// ・保持方針 kPersistent のものは Trim でも残す（Preload で指定する）
+// ・サウンドは Audio 側に解放手段がないので、読み込んだハンドルを終了まで使い回す
+// ・Prefetch はファイル読み込み・検証・内容ハッシュをワーカーで行い、GPU 転送や LoadWave は UpdateLoading（メインスレッド）で少しずつ仕上げる
+class AssetCache {
+public:
+	// 保持方針
+	enum class Retention : uint8_t {
+		kScene,     // 参照がなくなったら Trim で解放
+		kPersistent // 終了まで保持
+	};
+
+	// 統計
+	struct Stats {
+		uint32_t models = 0u;   // 保持しているモデル数
+		uint32_t hits = 0u;     // キャッシュから返した回数
+		uint32_t loads = 0u;    // 実際に読み込んだ回数
+		uint32_t shared = 0u;   // 内容ハッシュの一致で共有した回数
+		uint32_t released = 0u; // Trim で解放した数
+	};
+
+	static AssetCache* GetInstance();
+
+	// モデルを取得（なければ読み込む）
+	std::shared_ptr<ModelAsset> AcquireModel(const std::string& name, bool smoothing = false, Retention retention = Retention::kScene);
+
+	// 先に読み込んでおく（retention は既存のものより強い方を採る）
+	void PreloadModel(const std::string& name, bool smoothing = false, Retention retention = Retention::kPersistent);
+
+	// サウンドを取得（同じパスは1回だけ LoadWave）
+	uint32_t AcquireSound(const std::string& path);
+
+	// 非同期で読み込みを始める（Acquire 前に仕上がっていなければ Acquire がその場で待つ）
+	void PrefetchModel(const std::string& name, bool smoothing = false, Retention retention = Retention::kPersistent);
+	void PrefetchSound(const std::string& path);
+	void PrefetchTexture(const std::string& fileName); // TextureManager::Load に渡す名前
+
+	// 読み終わったものを仕上げる。毎フレーム1回、メインスレッドで呼ぶ
+	// ・budgetMs を超えたら次のフレームへ回す（最低1件は仕上げる）
+	void UpdateLoading(double budgetMs = 4.0);
+
+	// 仕上げ待ちの読み込みがあるか
+	bool IsLoading() const { return !pending_.empty(); }
+
+	// 参照のない kScene のアセットを解放し、解放数を返す。シーン切り替え後に呼ぶ
+	size_t Trim();
+
+	// 全解放（終了時）
+	void Clear();
+
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	struct ModelEntry {
+		std::shared_ptr<ModelAsset> asset;
+		uint64_t contentHash = 0u; // 平滑化ありは別の値になる
+		Retention retention = Retention::kScene;
+	};
+
+	// 読み込み中のもの（ワーカーが書き、counter が 0 になってからメインスレッドが読む）
+	struct Pending {
+		enum class Kind : uint8_t { kModel, kSound, kTexture } kind = Kind::kModel;
+		std::string name; // モデル名 / サウンドのパス / テクスチャ名
+		std::string key;  // models_ / sounds_ のキー
+		bool smoothing = false;
+		Retention retention = Retention::kScene;
+		JobSystem::Counter counter;
+		std::vector<uint8_t> blobStorage; // パック外・圧縮時の読み込み先
+		std::span<const uint8_t> blob;    // 検証済みの .mesh（パックに無圧縮であればマップ上を指す。空なら OBJ から読む）
+		uint64_t contentHash = 0u;
+	};
+
+	AssetCache() = default;
+	~AssetCache() = default;
+	AssetCache(const AssetCache&) = delete;
+	AssetCache& operator=(const AssetCache&) = delete;
+
+	// 名前 → 内容ハッシュ（.mesh があればそれ、なければ .obj）。ワーカーからも呼ぶ
+	static uint64_t ContentHashOf(const std::string& name, bool smoothing);
+
+	// ワーカーで行う読み込み
+	static void LoadPending(Pending& pending);
+
+	// 内容ハッシュ済みのモデルを登録（中身が同じものがあれば共有、なければ blob か OBJ から作る）
+	std::shared_ptr<ModelAsset> InsertModel(const std::string& key, const std::string& name, bool smoothing, Retention retention, uint64_t contentHash, std::span<const uint8_t> blob);
+
+	// 読み終わるのを待って仕上げる（メインスレッド）
+	void FinishPending(Pending& pending);
+	std::shared_ptr<Pending> TakePending(Pending::Kind kind, const std::string& key);
+	void Submit(std::shared_ptr<Pending> pending);
+
+	static std::string ModelKey(const std::string& name, bool smoothing) { return smoothing ? name + "#smooth" : name; }
+
+	std::unordered_map<std::string, ModelEntry> models_;        // パス → 実体
+	std::unordered_map<uint64_t, std::string> modelsByContent_; // 内容ハッシュ → パス
+	std::unordered_map<std::string, uint32_t> sounds_;          // パス → サウンドハンドル
+	std::vector<std::shared_ptr<Pending>> pending_;             // 仕上げ待ち（依頼順）
+	Stats stats_;
+};
@@ -0,0 +1,78 @@
+#include "AssetPack.h"
+#include "Hash.h"
+#include "Lz.h"
+#include <algorithm>
+#include <cstring>
+
+AssetPack* AssetPack::GetInstance() {
+	static AssetPack instance;
+	return &instance;
+}
+
+bool AssetPack::Open(const std::string& path) {
+	Close();
+	if (!file_.Open(path))
+		return false;
+
+	header_ = PackBlob::Validate(file_.GetData(), file_.GetSize());
+	if (!header_) {
+		file_.Close();
+		return false;
+	}
+	entries_ = reinterpret_cast<const PackBlob::Entry*>(file_.GetData() + header_->entriesOffset);
+	names_ = reinterpret_cast<const char*>(file_.GetData() + header_->namesOffset);
+	return true;
+}
+
+void AssetPack::Close() {
+	file_.Close();
+	header_ = nullptr;
+	entries_ = nullptr;
+	names_ = nullptr;
+}
+
+const PackBlob::Entry* AssetPack::Find(const std::string& path) const {
+	if (!header_)
+		return nullptr;
+
+	const std::string key = PackBlob::NormalizePath(path);
+	const uint64_t hash = HashBytes(key.data(), key.size());
+
+	// ハッシュで二分探索し、同じハッシュが並んでいればパス文字列で確かめる
+	const PackBlob::Entry* end = entries_ + header_->entryCount;
+	const PackBlob::Entry* it = std::lower_bound(entries_, end, hash, [](const PackBlob::Entry& e, uint64_t h) { return e.pathHash < h; });
+	for (; it != end && it->pathHash == hash; ++it) {
+		if (it->nameLength == key.size() && std::memcmp(names_ + it->nameOffset, key.data(), key.size()) == 0)
+			return it;
+	}
+	return nullptr;
+}
+
+std::span<const uint8_t> AssetPack::View(const std::string& path) const {
+	const PackBlob::Entry* entry = Find(path);
+	if (!entry || entry->compression != PackBlob::kStored)
+		return {};
+	return {file_.GetData() + entry->offset, entry->size};
+}
+
+bool AssetPack::Load(const std::string& path, std::vector<uint8_t>& storage, std::span<const uint8_t>& data) const {
+	if (const PackBlob::Entry* entry = Find(path)) {
+		const uint8_t* src = file_.GetData() + entry->offset;
+		if (entry->compression == PackBlob::kStored) {
+			data = {src, entry->size};
+			return true;
+		}
+		storage.resize(entry->rawSize);
+		if (Lz::Decompress(src, entry->size, storage.data(), storage.size())) {
+			data = storage;
+			return true;
+		}
+		return false;
+	}
+
+	// パックにないものはファイルから
+	if (!ReadFileBytes(path, storage))
+		return false;
+	data = storage;
+	return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "FileBytes.h"
+#include "MappedFile.h"
+#include "PackBlob.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// アセットパック（Tools/PackBuilder で作る .pak）の読み出し
+// ・起動時に Open でメモリマップし、パスは正規化したパスのハッシュで二分探索して引く
+// ・無圧縮のデータはマップ上をそのまま返すのでコピーしない。パックにないものは従来どおりファイルから読む
+// ・Open / Close はメインスレッドで、ワーカーが動いていない時に呼ぶ（それ以外は読み取りだけなのでどこからでも呼べる）
+class AssetPack {
+public:
+	static AssetPack* GetInstance();
+
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen() const { return header_ != nullptr; }
+
+	bool Contains(const std::string& path) const { return Find(path) != nullptr; }
+
+	// 無圧縮で入っているデータを直接参照（圧縮されているもの・ないものは空）
+	std::span<const uint8_t> View(const std::string& path) const;
+
+	// 中身を得る。パックに無圧縮であればマップ上を、圧縮されていれば展開して、なければファイルを storage に読んで data に入れる
+	bool Load(const std::string& path, std::vector<uint8_t>& storage, std::span<const uint8_t>& data) const;
+
+private:
+	AssetPack() = default;
+	~AssetPack() = default;
+	AssetPack(const AssetPack&) = delete;
+	AssetPack& operator=(const AssetPack&) = delete;
+
+	const PackBlob::Entry* Find(const std::string& path) const;
+
+	MappedFile file_;
+	const PackBlob::Header* header_ = nullptr;
+	const PackBlob::Entry* entries_ = nullptr;
+	const char* names_ = nullptr;
+};
@@ -0,0 +1,360 @@
+#include "AudioMixer.h"
+#include "Adpcm.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// MIXER_NO_SSE を定義すると SIMD なしで比べられる（Tools/MixBench 用）
+#if (defined(_M_X64) || defined(__SSE__)) && !defined(MIXER_NO_SSE)
+#include <xmmintrin.h>
+#define MIXER_USE_SSE 1
+#endif
+
+namespace {
+
+// リミッター：ピークをここまで下げる。ソフトクリップもここから上だけを丸める（出力の最大は 1）
+const float kLimiterCeiling = 0.8f;
+// 利得を 0 から 1 まで戻すのにかける秒数
+const float kLimiterReleaseSeconds = 0.2f;
+
+// 4 の倍数に切り上げて確保する
+void AllocateFrames(std::unique_ptr<float[]>& buffer, uint32_t frames) { buffer = std::make_unique<float[]>((frames + 3u) & ~3u); }
+
+// 元の波形の1サンプルを [-1, 1) の float に
+template<int Type> float ReadSample(const uint8_t* p);
+template<> float ReadSample<0>(const uint8_t* p) {
+	int16_t s;
+	std::memcpy(&s, p, sizeof(s));
+	return float(s) * (1.0f / 32768.0f);
+}
+template<> float ReadSample<1>(const uint8_t* p) {
+	const int32_t s = static_cast<int32_t>((uint32_t(p[0]) << 8) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 24)) >> 8;
+	return float(s) * (1.0f / 8388608.0f);
+}
+template<> float ReadSample<2>(const uint8_t* p) {
+	float s;
+	std::memcpy(&s, p, sizeof(s));
+	return s;
+}
+
+// position から出力の周波数で最大 frames フレームを取り出す（ステレオなら R を right へ、モノラルなら left だけ）
+// 最後のフレームの先は無音として補間する
+template<int Type, uint32_t Channels> uint32_t FetchFrames(const uint8_t* data, uint32_t srcFrames, uint64_t& position, uint64_t step, float* left, float* right, uint32_t frames) {
+	const uint32_t bytes = Type == 0 ? 2u : (Type == 1 ? 3u : 4u);
+	const uint32_t stride = bytes * Channels;
+	const uint64_t end = uint64_t(srcFrames) << 32;
+	if (position >= end)
+		return 0u;
+	const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(frames, (end - position + step - 1u) / step));
+
+	if (step == (uint64_t(1) << 32) && uint32_t(position) == 0u) {
+		// 同じ周波数で補間なし
+		const uint8_t* p = data + (position >> 32) * stride;
+		for (uint32_t i = 0; i < count; ++i, p += stride) {
+			left[i] = ReadSample<Type>(p);
+			if (Channels == 2u)
+				right[i] = ReadSample<Type>(p + bytes);
+		}
+		position += uint64_t(count) << 32;
+		return count;
+	}
+
+	// 次のフレームがある間（末尾の1フレームの手前まで）は分岐なしで補間する
+	const uint64_t lastStart = uint64_t(srcFrames - 1u) << 32;
+	const uint32_t body = position >= lastStart ? 0u : static_cast<uint32_t>(std::min<uint64_t>(count, (lastStart - position + step - 1u) / step));
+	uint64_t pos = position;
+	uint32_t i = 0u;
+	for (; i < body; ++i, pos += step) {
+		const float frac = float(uint32_t(pos)) * (1.0f / 4294967296.0f);
+		const uint8_t* p = data + size_t(pos >> 32) * stride;
+		const float a0 = ReadSample<Type>(p);
+		left[i] = a0 + (ReadSample<Type>(p + stride) - a0) * frac;
+		if (Channels == 2u) {
+			const float a1 = ReadSample<Type>(p + bytes);
+			right[i] = a1 + (ReadSample<Type>(p + stride + bytes) - a1) * frac;
+		}
+	}
+	for (; i < count; ++i, pos += step) {
+		const float frac = float(uint32_t(pos)) * (1.0f / 4294967296.0f);
+		const uint8_t* p = data + size_t(pos >> 32) * stride;
+		left[i] = ReadSample<Type>(p) * (1.0f - frac);
+		if (Channels == 2u)
+			right[i] = ReadSample<Type>(p + bytes) * (1.0f - frac);
+	}
+	position = pos;
+	return count;
+}
+
+// acc[i] += src[i] * gain
+void Accumulate(float* acc, const float* src, float gain, uint32_t count) {
+	uint32_t i = 0u;
+#ifdef MIXER_USE_SSE
+	const __m128 g = _mm_set1_ps(gain);
+	for (; i + 4u <= count; i += 4u)
+		_mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+#endif
+	for (; i < count; ++i)
+		acc[i] += src[i] * gain;
+}
+
+// kLimiterCeiling より上を tanh の近似で 1 に向けて丸める
+float SoftClip(float x) {
+	const float a = std::fabs(x);
+	if (a <= kLimiterCeiling)
+		return x;
+	const float z = std::min((a - kLimiterCeiling) * (1.0f / (1.0f - kLimiterCeiling)), 3.0f);
+	const float z2 = z * z;
+	const float y = kLimiterCeiling + (1.0f - kLimiterCeiling) * (z * (27.0f + z2) / (27.0f + 9.0f * z2));
+	return std::copysign(y, x);
+}
+
+#ifdef MIXER_USE_SSE
+__m128 SoftClip4(__m128 x) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 sign = _mm_and_ps(x, signMask);
+	const __m128 a = _mm_andnot_ps(signMask, x);
+	const __m128 ceiling = _mm_set1_ps(kLimiterCeiling);
+	const __m128 z = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(a, ceiling), _mm_set1_ps(1.0f / (1.0f - kLimiterCeiling))), _mm_setzero_ps()), _mm_set1_ps(3.0f));
+	const __m128 z2 = _mm_mul_ps(z, z);
+	const __m128 t = _mm_div_ps(_mm_mul_ps(z, _mm_add_ps(_mm_set1_ps(27.0f), z2)), _mm_add_ps(_mm_set1_ps(27.0f), _mm_mul_ps(_mm_set1_ps(9.0f), z2)));
+	const __m128 clipped = _mm_add_ps(ceiling, _mm_mul_ps(_mm_set1_ps(1.0f - kLimiterCeiling), t));
+	const __m128 over = _mm_cmpgt_ps(a, ceiling);
+	return _mm_or_ps(_mm_or_ps(_mm_and_ps(over, clipped), _mm_andnot_ps(over, a)), sign);
+}
+#endif
+
+float Peak(const float* samples, uint32_t count) {
+	float peak = 0.0f;
+	uint32_t i = 0u;
+#ifdef MIXER_USE_SSE
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	__m128 m = _mm_setzero_ps();
+	for (; i + 4u <= count; i += 4u)
+		m = _mm_max_ps(m, _mm_andnot_ps(signMask, _mm_loadu_ps(samples + i)));
+	alignas(16) float lanes[4];
+	_mm_store_ps(lanes, m);
+	peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+	for (; i < count; ++i)
+		peak = std::max(peak, std::fabs(samples[i]));
+	return peak;
+}
+
+} // namespace
+
+void AudioMixer::Initialize(uint32_t voiceCount, uint32_t outputRate, uint32_t maxFrames) {
+	voiceCount_ = voiceCount;
+	outputRate_ = outputRate;
+	maxFrames_ = maxFrames;
+	voices_ = std::make_unique<Voice[]>(voiceCount);
+	adpcmCache_ = std::make_unique<int16_t[]>(size_t(voiceCount) * kAdpcmCacheSamples);
+	AllocateFrames(accumL_, maxFrames);
+	AllocateFrames(accumR_, maxFrames);
+	AllocateFrames(scratchL_, maxFrames);
+	AllocateFrames(scratchR_, maxFrames);
+	limiterGain_ = 1.0f;
+	releasePerFrame_ = 1.0f / (kLimiterReleaseSeconds * float(outputRate));
+	stats_ = {};
+}
+
+bool AudioMixer::IsSupported(const WaveFormat& format) {
+	if ((format.channels != 1u && format.channels != 2u) || format.sampleRate == 0u)
+		return false;
+	if (format.formatTag == 1u)
+		return (format.bitsPerSample == 16u || format.bitsPerSample == 24u) && format.blockAlign == format.channels * format.bitsPerSample / 8u;
+	if (format.formatTag == 3u)
+		return format.bitsPerSample == 32u && format.blockAlign == format.channels * 4u;
+	if (format.formatTag == Adpcm::kFormatTag)
+		// キャッシュには前の最後のフレームと2ブロックが入ること
+		return Adpcm::IsValidFormat(format) && (2u * format.samplesPerBlock + 1u) * format.channels <= kAdpcmCacheSamples;
+	return false;
+}
+
+uint32_t AudioMixer::CountFrames(const WaveView& wave) {
+	if (wave.format.formatTag == Adpcm::kFormatTag)
+		return Adpcm::CountFrames(wave.format, wave.samples.size());
+	return wave.format.blockAlign ? static_cast<uint32_t>(wave.samples.size() / wave.format.blockAlign) : 0u;
+}
+
+bool AudioMixer::Start(uint32_t voice, const WaveView& wave, float volume, float pan) {
+	if (voice >= voiceCount_)
+		return false;
+	Voice& v = voices_[voice];
+	v.active = false;
+	if (!IsSupported(wave.format))
+		return false;
+
+	v.data = wave.samples.data();
+	v.frames = CountFrames(wave);
+	if (v.frames == 0u)
+		return false;
+	if (wave.format.formatTag == Adpcm::kFormatTag) {
+		v.type = SampleType::kAdpcm;
+		v.format = wave.format;
+		v.dataBytes = wave.samples.size();
+		v.cacheFirst = 0u;
+		v.cacheFrames = 0u;
+	} else {
+		v.type = wave.format.formatTag == 3u ? SampleType::kFloat : (wave.format.bitsPerSample == 24u ? SampleType::kPcm24 : SampleType::kPcm16);
+	}
+	v.channels = static_cast<uint8_t>(wave.format.channels);
+	v.position = 0u;
+	v.step = (uint64_t(wave.format.sampleRate) << 32) / outputRate_;
+	v.active = true;
+	SetVolume(voice, volume, pan);
+	return true;
+}
+
+void AudioMixer::Stop(uint32_t voice) {
+	if (voice < voiceCount_)
+		voices_[voice].active = false;
+}
+
+void AudioMixer::SetVolume(uint32_t voice, float volume, float pan) {
+	if (voice >= voiceCount_)
+		return;
+	Voice& v = voices_[voice];
+	pan = std::clamp(pan, -1.0f, 1.0f);
+	if (v.channels == 1u) {
+		// モノラルは等パワーで振り分ける（中央で左右とも volume）
+		const float angle = (pan + 1.0f) * 0.78539816f;
+		v.gainL = volume * 1.41421356f * std::cos(angle);
+		v.gainR = volume * 1.41421356f * std::sin(angle);
+	} else {
+		// ステレオは反対側を絞るだけ（中央で元のまま）
+		v.gainL = volume * std::min(1.0f, 1.0f - pan);
+		v.gainR = volume * std::min(1.0f, 1.0f + pan);
+	}
+}
+
+bool AudioMixer::IsActive(uint32_t voice) const { return voice < voiceCount_ && voices_[voice].active; }
+
+uint32_t AudioMixer::GetActiveCount() const {
+	uint32_t count = 0u;
+	for (uint32_t i = 0; i < voiceCount_; ++i)
+		count += voices_[i].active ? 1u : 0u;
+	return count;
+}
+
+uint32_t AudioMixer::Fetch(Voice& v, uint32_t frames) {
+	float* l = scratchL_.get();
+	float* r = scratchR_.get();
+	switch (v.type) {
+	case SampleType::kPcm16:
+		return v.channels == 1u ? FetchFrames<0, 1u>(v.data, v.frames, v.position, v.step, l, r, frames) : FetchFrames<0, 2u>(v.data, v.frames, v.position, v.step, l, r, frames);
+	case SampleType::kPcm24:
+		return v.channels == 1u ? FetchFrames<1, 1u>(v.data, v.frames, v.position, v.step, l, r, frames) : FetchFrames<1, 2u>(v.data, v.frames, v.position, v.step, l, r, frames);
+	case SampleType::kFloat:
+		return v.channels == 1u ? FetchFrames<2, 1u>(v.data, v.frames, v.position, v.step, l, r, frames) : FetchFrames<2, 2u>(v.data, v.frames, v.position, v.step, l, r, frames);
+	case SampleType::kAdpcm:
+		return FetchAdpcm(v, adpcmCache_.get() + size_t(&v - voices_.get()) * kAdpcmCacheSamples, frames);
+	}
+	return 0u;
+}
+
+uint32_t AudioMixer::FetchAdpcm(Voice& v, int16_t* cache, uint32_t frames) {
+	// 1回に展開するブロック数。列（ブロック × チャンネル）が4本そろうと SIMD に載る（モノラルなら4、ステレオなら2）
+	const uint32_t blockFrames = v.format.samplesPerBlock;
+	const uint32_t channels = v.channels;
+	const uint32_t blocksPerFill = std::max(1u, std::min(4u / channels, (kAdpcmCacheSamples - channels) / (blockFrames * channels)));
+	const uint32_t blockCount = static_cast<uint32_t>((v.dataBytes + v.format.blockAlign - 1u) / v.format.blockAlign);
+	const uint8_t* samples = reinterpret_cast<const uint8_t*>(cache);
+	float* l = scratchL_.get();
+	float* r = scratchR_.get();
+
+	uint32_t done = 0u;
+	while (done < frames) {
+		const uint32_t frame = static_cast<uint32_t>(v.position >> 32);
+		if (frame >= v.frames)
+			break;
+		const uint32_t cacheEnd = v.cacheFirst + v.cacheFrames;
+		const bool reachesEnd = cacheEnd >= v.frames;
+		if (frame + 1u == cacheEnd && !reachesEnd && frame >= v.cacheFirst) {
+			// キャッシュの最後のフレームまで来た：それを先頭に残して続きのブロックを展開する（補間に次のフレームが要る）
+			const uint32_t block = cacheEnd / blockFrames;
+			std::copy_n(cache + size_t(frame - v.cacheFirst) * channels, channels, cache);
+			v.cacheFirst = frame;
+			v.cacheFrames = 1u + Adpcm::DecodeBlocks(v.format, v.data, v.dataBytes, block, blocksPerFill, cache + channels);
+			stats_.adpcmBlocks += std::min(blocksPerFill, blockCount - block);
+			continue;
+		}
+		if (frame < v.cacheFirst || frame >= cacheEnd) {
+			// 頭から鳴らし始めたとき：今のフレームのブロックから展開する
+			const uint32_t block = frame / blockFrames;
+			v.cacheFirst = block * blockFrames;
+			v.cacheFrames = Adpcm::DecodeBlocks(v.format, v.data, v.dataBytes, block, blocksPerFill, cache);
+			stats_.adpcmBlocks += std::min(blocksPerFill, blockCount - block);
+			continue;
+		}
+
+		// キャッシュの中の位置で取り出す。波形の最後まで入っていなければ、次のフレームがキャッシュにある所までで止める
+		uint64_t position = v.position - (uint64_t(v.cacheFirst) << 32);
+		uint32_t count = frames - done;
+		if (!reachesEnd)
+			count = static_cast<uint32_t>(std::min<uint64_t>(count, ((uint64_t(v.cacheFrames - 1u) << 32) - position + v.step - 1u) / v.step));
+		const uint32_t fetched = v.channels == 1u ? FetchFrames<0, 1u>(samples, v.cacheFrames, position, v.step, l + done, r + done, count)
+		                                          : FetchFrames<0, 2u>(samples, v.cacheFrames, position, v.step, l + done, r + done, count);
+		v.position = (uint64_t(v.cacheFirst) << 32) + position;
+		done += fetched;
+		if (fetched < count)
+			break;
+	}
+	return done;
+}
+
+void AudioMixer::Mix(float* out, uint32_t frames) {
+	frames = std::min(frames, maxFrames_);
+	std::fill_n(accumL_.get(), frames, 0.0f);
+	std::fill_n(accumR_.get(), frames, 0.0f);
+
+	for (uint32_t i = 0; i < voiceCount_; ++i) {
+		Voice& v = voices_[i];
+		if (!v.active)
+			continue;
+		const uint32_t count = Fetch(v, frames);
+		stats_.voiceFrames += count;
+		// モノラルは同じ波形を左右へ、ステレオはそれぞれへ
+		Accumulate(accumL_.get(), scratchL_.get(), v.gainL, count);
+		Accumulate(accumR_.get(), v.channels == 1u ? scratchL_.get() : scratchR_.get(), v.gainR, count);
+		if (count < frames)
+			v.active = false;
+	}
+
+	ApplyLimiter(out, frames);
+	stats_.framesMixed += frames;
+}
+
+void AudioMixer::ApplyLimiter(float* out, uint32_t frames) {
+	if (frames == 0u)
+		return;
+	const float* l = accumL_.get();
+	const float* r = accumR_.get();
+
+	// ピークが天井を超えるならすぐ下げる。下回っていればゆっくり戻す。ブロックの中は直線で移す
+	const float peak = std::max(Peak(l, frames), Peak(r, frames));
+	const float target = peak > kLimiterCeiling ? kLimiterCeiling / peak : 1.0f;
+	const float from = limiterGain_;
+	const float to = target < from ? target : std::min(target, from + releasePerFrame_ * float(frames));
+	if (target < 1.0f)
+		stats_.limited++;
+	limiterGain_ = to;
+	stats_.gain = to;
+	const float slope = (to - from) / float(frames);
+
+	uint32_t i = 0u;
+#ifdef MIXER_USE_SSE
+	const __m128 ramp = _mm_set_ps(4.0f * slope, 3.0f * slope, 2.0f * slope, slope);
+	for (; i + 4u <= frames; i += 4u) {
+		const __m128 g = _mm_add_ps(_mm_set1_ps(from + slope * float(i)), ramp);
+		const __m128 vl = SoftClip4(_mm_mul_ps(_mm_loadu_ps(l + i), g));
+		const __m128 vr = SoftClip4(_mm_mul_ps(_mm_loadu_ps(r + i), g));
+		_mm_storeu_ps(out + i * 2u, _mm_unpacklo_ps(vl, vr));
+		_mm_storeu_ps(out + i * 2u + 4u, _mm_unpackhi_ps(vl, vr));
+	}
+#endif
+	for (; i < frames; ++i) {
+		const float g = from + slope * float(i + 1u);
+		out[i * 2u] = SoftClip(l[i] * g);
+		out[i * 2u + 1u] = SoftClip(r[i] * g);
+	}
+}
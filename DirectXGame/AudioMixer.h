@@ -0,0 +1,96 @@
+#pragma once
+#include "WaveFile.h"
+#include <cstdint>
+#include <memory>
+
+// 一発ものの効果音をまとめて1本のステレオ float 波形に混ぜるソフトウェアミキサー（VoicePool のオーディオスレッドが使う）
+// ・ボイスは Initialize で数を決めて確保し、番号で指す。鳴らす波形はメモリ上の WaveView を参照するだけ（コピーしない）
+// ・元の波形（PCM 16 / 24bit・float、モノラル / ステレオ、任意のサンプリング周波数）を出力の周波数へ線形補間で変換する
+// ・IMA-ADPCM はボイスごとの小さなキャッシュへ数ブロックずつ展開しながら鳴らす（常駐するのは圧縮したままの 1/4 の大きさ）
+// ・音量とパン（等パワー）を掛けて足し込む処理と、リミッター・インターリーブは SIMD で4サンプルずつ
+// ・リミッターはブロックごとのピークで利得を下げ（すぐ下げてゆっくり戻す）、それでも残る山はソフトクリップで丸める
+class AudioMixer {
+public:
+	static const uint32_t kChannels = 2u;
+	// ADPCM を展開しておくボイスごとのキャッシュ（int16 のサンプル数）。(2ブロック + 1フレーム) × チャンネル数がこれに収まること
+	static const uint32_t kAdpcmCacheSamples = 2048u;
+
+	// 混ぜた結果の統計（累計）
+	struct Stats {
+		uint64_t framesMixed = 0u;  // 出力したフレーム数
+		uint64_t voiceFrames = 0u;  // 各ボイスから取り出したフレーム数の合計
+		uint32_t limited = 0u;      // リミッターが利得を下げたブロック数
+		uint64_t adpcmBlocks = 0u;  // 展開した ADPCM のブロック数
+		float gain = 1.0f;          // 今のリミッターの利得
+	};
+
+	AudioMixer() = default;
+	AudioMixer(const AudioMixer&) = delete;
+	AudioMixer& operator=(const AudioMixer&) = delete;
+
+	// ボイス数・出力の周波数・1回の Mix で出す最大フレーム数を決めて作業用の領域を確保する
+	void Initialize(uint32_t voiceCount, uint32_t outputRate, uint32_t maxFrames);
+
+	// 混ぜられる形式か（PCM 16 / 24bit・float・IMA-ADPCM の 1 / 2ch）
+	static bool IsSupported(const WaveFormat& format);
+	// wave の長さ（フレーム数）
+	static uint32_t CountFrames(const WaveView& wave);
+
+	// voice 番のボイスで wave を頭から鳴らす（鳴っていたものは打ち切る）。wave の中身は鳴り終わるまで呼び出し側が持っておく
+	// pan は -1（左）～ 1（右）
+	bool Start(uint32_t voice, const WaveView& wave, float volume, float pan = 0.0f);
+	void Stop(uint32_t voice);
+	void SetVolume(uint32_t voice, float volume, float pan);
+	bool IsActive(uint32_t voice) const;
+	uint32_t GetActiveCount() const;
+
+	// 鳴っている全ボイスを frames フレームぶん混ぜ、out に LRLR... の float で書く（frames は maxFrames まで）
+	void Mix(float* out, uint32_t frames);
+
+	uint32_t GetOutputRate() const { return outputRate_; }
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	enum class SampleType : uint8_t {
+		kPcm16,
+		kPcm24,
+		kFloat,
+		kAdpcm,
+	};
+
+	struct Voice {
+		const uint8_t* data = nullptr;
+		uint32_t frames = 0u;
+		// ADPCM のみ
+		WaveFormat format;
+		size_t dataBytes = 0u;
+		uint32_t cacheFirst = 0u;  // キャッシュの先頭が元の波形の何フレーム目か
+		uint32_t cacheFrames = 0u; // キャッシュに展開済みのフレーム数
+		SampleType type = SampleType::kPcm16;
+		uint8_t channels = 1u;
+		uint64_t position = 0u; // 元の波形上の位置（32.32 固定小数点）
+		uint64_t step = 0u;     // 出力1フレームで進む量（32.32）
+		float gainL = 0.0f;
+		float gainR = 0.0f;
+		bool active = false;
+	};
+
+	// 元の波形から最大 frames フレームを出力の周波数で取り出して scratchL_ / scratchR_ に書く。書いたフレーム数を返す
+	uint32_t Fetch(Voice& voice, uint32_t frames);
+	uint32_t FetchAdpcm(Voice& voice, int16_t* cache, uint32_t frames);
+	void ApplyLimiter(float* out, uint32_t frames);
+
+	uint32_t voiceCount_ = 0u;
+	uint32_t outputRate_ = 48000u;
+	uint32_t maxFrames_ = 0u;
+	std::unique_ptr<Voice[]> voices_;
+	std::unique_ptr<int16_t[]> adpcmCache_; // voiceCount_ * kAdpcmCacheSamples
+	// 作業用（4 の倍数に切り上げて確保）
+	std::unique_ptr<float[]> accumL_;
+	std::unique_ptr<float[]> accumR_;
+	std::unique_ptr<float[]> scratchL_;
+	std::unique_ptr<float[]> scratchR_;
+	float limiterGain_ = 1.0f;
+	float releasePerFrame_ = 0.0f; // 利得を戻す速さ（1 フレームあたり）
+	Stats stats_;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include "WaveFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// 音声の出力先（StreamingVoice が波形を小分けにして渡す）
+// ・Submit したバッファは渡した順に隙間なく再生する。再生し終えるまで中身は呼び出し側が持っておく
+// ・再生し終えるたびに Open で渡した onBufferEnd を呼ぶ（オーディオのスレッドから呼ばれることがある）
+// ・実装は XAudio2Sink（ゲーム）と NullAudioSink（音を出さない・Linux での確認用）
+class AudioSink {
+public:
+	using BufferEndCallback = std::function<void()>;
+
+	virtual ~AudioSink() = default;
+
+	// 形式に合った再生口を用意する。対応しない形式なら false
+	virtual bool Open(const WaveFormat& format, BufferEndCallback onBufferEnd) = 0;
+	// 再生を止めて片付ける（戻ったあとは onBufferEnd は呼ばれない）
+	virtual void Close() = 0;
+
+	// endOfStream は最後のバッファに付ける
+	virtual bool Submit(const uint8_t* data, size_t size, bool endOfStream) = 0;
+
+	virtual void Start() = 0;
+	virtual void Stop() = 0;
+	virtual void SetVolume(float volume) = 0;
+};
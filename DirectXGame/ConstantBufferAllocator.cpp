@@ -0,0 +1,44 @@
+#include "ConstantBufferAllocator.h"
+#include <cassert>
+
+using namespace KamataEngine;
+
+ConstantBufferAllocator* ConstantBufferAllocator::GetInstance() {
+	static ConstantBufferAllocator instance;
+	return &instance;
+}
+
+void ConstantBufferAllocator::Initialize(uint64_t capacityPerFrame) {
+	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	uint32_t frameCount = static_cast<uint32_t>(dxCommon->GetBackBufferCount());
+	if (frameCount == 0u)
+		frameCount = 2u;
+	ring_.Initialize(capacityPerFrame, frameCount);
+
+	// 全区画ぶんを1本のアップロードバッファで確保して常時マップ
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(ring_.GetTotalSize());
+	HRESULT result = dxCommon->GetDevice()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer_));
+	assert(SUCCEEDED(result));
+
+	result = buffer_->Map(0, nullptr, reinterpret_cast<void**>(&mapped_));
+	assert(SUCCEEDED(result));
+}
+
+void ConstantBufferAllocator::BeginFrame() { ring_.BeginFrame(fence_); }
+
+void ConstantBufferAllocator::EndFrame() { ring_.EndFrame(fence_.Signal()); }
+
+ConstantBufferAllocator::Allocation ConstantBufferAllocator::Allocate(size_t size) {
+	Allocation a;
+	if (!mapped_)
+		return a;
+
+	uint64_t offset = ring_.Allocate(size);
+	if (offset == FrameRingAllocator::kInvalidOffset)
+		return a;
+
+	a.cpu = mapped_ + offset;
+	a.gpu = buffer_->GetGPUVirtualAddress() + offset;
+	return a;
+}
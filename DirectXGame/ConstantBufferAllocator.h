@@ -0,0 +1,66 @@
+#pragma once
+#include "FrameRingAllocator.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <cstring>
+
+// フレーム単位で使い捨てる定数バッファ領域（256 バイト境界のスライスを配る）
+// ・オブジェクトごとに定数バッファを作らず、描画時に1本の大きなアップロードバッファへ書き込む
+// ・区画はバックバッファ数ぶん持ち、フレーム開始時に GPU の完了を確認してから再利用する
+class ConstantBufferAllocator {
+public:
+	// 確保したスライス
+	struct Allocation {
+		void* cpu = nullptr;                 // 書き込み先
+		D3D12_GPU_VIRTUAL_ADDRESS gpu = 0u; // ルート CBV に渡すアドレス
+		bool IsValid() const { return cpu != nullptr; }
+	};
+
+	static ConstantBufferAllocator* GetInstance();
+
+	// 1フレームあたりの容量で初期化（区画数はバックバッファ数）
+	void Initialize(uint64_t capacityPerFrame);
+
+	// dxCommon->PreDraw の前後で呼ぶ
+	void BeginFrame();
+
+	// dxCommon->PostDraw の後で呼ぶ
+	void EndFrame();
+
+	// size バイトのスライスを確保
+	Allocation Allocate(size_t size);
+
+	// 値を書き込んだスライスを確保
+	template<class T> Allocation Push(const T& data) {
+		Allocation a = Allocate(sizeof(T));
+		if (a.IsValid())
+			std::memcpy(a.cpu, &data, sizeof(T));
+		return a;
+	}
+
+	uint64_t GetUsedThisFrame() const { return ring_.GetUsedThisFrame(); }
+
+private:
+	// DirectXCommon::PostDraw は GPU の完了を待ってから戻るので、
+	// PostDraw 後に発行した値 = 完了済みの値として扱うフェンス
+	class PostDrawFence : public FrameFence {
+	public:
+		uint64_t Signal() { return completed_ = ++next_; }
+		uint64_t GetCompletedValue() const override { return completed_; }
+		void Wait(uint64_t /*value*/) override {}
+
+	private:
+		uint64_t next_ = 0u;
+		uint64_t completed_ = 0u;
+	};
+
+	ConstantBufferAllocator() = default;
+	~ConstantBufferAllocator() = default;
+	ConstantBufferAllocator(const ConstantBufferAllocator&) = delete;
+	ConstantBufferAllocator& operator=(const ConstantBufferAllocator&) = delete;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer_;
+	uint8_t* mapped_ = nullptr;
+	FrameRingAllocator ring_;
+	PostDrawFence fence_;
+};
@@ -3,11 +3,8 @@
 
 void Fade::Initialize() {
 	// 02_13 10枚目
-	//	sprite_ = new Sprite();
-	sprite_ = Sprite::Create(0, Vector2{});
-
-	sprite_->SetSize(Vector2(WinApp::kWindowWidth, WinApp::kWindowHeight));
-	sprite_->SetColor(Vector4(0, 0, 0, 1.f));
+	batch_.Initialize(1);
+	color_ = Vector4(0, 0, 0, 1.f);
 }
 
 void Fade::Update() {
@@ -27,7 +24,7 @@ void Fade::Update() {
 			counter_ = duration_;
 		}
 		// 0.0fから1.0fの間で、経過時間がフェード継続時間に近づくほどアルファ値を大きくする
-		sprite_->SetColor(Vector4(0, 0, 0, std::clamp(1.0f - counter_ / duration_, 0.0f, 1.0f)));
+		color_ = Vector4(0, 0, 0, std::clamp(1.0f - counter_ / duration_, 0.0f, 1.0f));
 
 		break;
 	case Status::FadeOut:
@@ -40,7 +37,7 @@ void Fade::Update() {
 			counter_ = duration_;
 		}
 		// 0.0fから1.0fの間で、経過時間がフェード継続時間に近づくほどアルファ値を大きくする
-		sprite_->SetColor(Vector4(0, 0, 0, std::clamp(counter_ / duration_, 0.0f, 1.0f)));
+		color_ = Vector4(0, 0, 0, std::clamp(counter_ / duration_, 0.0f, 1.0f));
 		break;
 	}
 }
@@ -53,9 +50,9 @@ void Fade::Draw() {
 	}
 
 	// 02_13 11枚目
-	Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
-	sprite_->Draw();
-	Sprite::PostDraw();
+	batch_.Begin(DirectXCommon::GetInstance()->GetCommandList());
+	batch_.Draw(0, Vector2{}, Vector2(WinApp::kWindowWidth, WinApp::kWindowHeight), color_);
+	batch_.End();
 }
 
 // 02_13 18枚目 フェード開始
@@ -1,5 +1,6 @@
 #pragma once
 #include "KamataEngine.h"
+#include "SpriteBatch.h"
 
 using namespace KamataEngine;
 
@@ -27,7 +28,9 @@ public:
 	bool IsFinished() const;
 
 private:
-	Sprite* sprite_ = nullptr;
+	// 全画面の黒い矩形（テクスチャ 0 番 = 白1x1 を色で塗る）
+	SpriteBatch batch_;
+	Vector4 color_ = {0.0f, 0.0f, 0.0f, 1.0f};
 
 	// 02_13 16枚目 現在のフェードの状態
 	Status status_ = Status::None;
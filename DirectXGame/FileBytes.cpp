@@ -0,0 +1,15 @@
+#include "FileBytes.h"
+#include <cstdio>
+
+bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& data) {
+	FILE* fp = std::fopen(path.c_str(), "rb");
+	if (!fp)
+		return false;
+	std::fseek(fp, 0, SEEK_END);
+	long size = std::ftell(fp);
+	std::fseek(fp, 0, SEEK_SET);
+	data.resize(size > 0 ? static_cast<size_t>(size) : 0u);
+	bool ok = data.empty() || std::fread(data.data(), 1, data.size(), fp) == data.size();
+	std::fclose(fp);
+	return ok;
+}
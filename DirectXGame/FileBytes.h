@@ -0,0 +1,7 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ファイル全体をメモリへ読む（どのスレッドからでも呼べる・ツールからも使う）。読めなければ false
+bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& data);
@@ -0,0 +1,69 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+// GPU の進み具合（フェンス値）を問い合わせる窓口
+// ・D3D12 に依存しないので、偽フェンスを差し込めばロジック単体で検証できる
+class FrameFence {
+public:
+	virtual ~FrameFence() = default;
+
+	// GPU が完了したフェンス値
+	virtual uint64_t GetCompletedValue() const = 0;
+
+	// value が完了するまで待つ
+	virtual void Wait(uint64_t value) = 0;
+};
+
+// フレームごとに区画を持つリング型の線形アロケータ（オフセットだけを扱う）
+// ・区画数 = バックバッファ数。フレーム開始時、その区画を最後に使ったフレームの完了を待って巻き戻す
+// ・確保は先頭からずらすだけで、個別の解放はない
+class FrameRingAllocator {
+public:
+	static const uint64_t kAlignment = 256u;                // 定数バッファの配置境界
+	static const uint64_t kInvalidOffset = ~uint64_t(0); // 確保失敗
+
+	// 1フレームあたりの容量（kAlignment に切り上げ）と区画数
+	void Initialize(uint64_t capacityPerFrame, uint32_t frameCount) {
+		assert(frameCount > 0);
+		capacityPerFrame_ = AlignUp(capacityPerFrame);
+		fenceValues_.assign(frameCount, 0u);
+		frameIndex_ = 0u;
+		head_ = 0u;
+	}
+
+	// フレーム開始：次の区画へ進み、GPU がその区画を使い終わるまで待つ
+	void BeginFrame(FrameFence& fence) {
+		frameIndex_ = (frameIndex_ + 1u) % static_cast<uint32_t>(fenceValues_.size());
+		uint64_t last = fenceValues_[frameIndex_];
+		if (last != 0u && fence.GetCompletedValue() < last)
+			fence.Wait(last);
+		head_ = 0u;
+	}
+
+	// フレーム終了：このフレームの描画が終わったことを示すフェンス値を記録
+	void EndFrame(uint64_t fenceValue) { fenceValues_[frameIndex_] = fenceValue; }
+
+	// size バイトを確保して全体バッファ内のオフセットを返す
+	uint64_t Allocate(uint64_t size) {
+		uint64_t aligned = AlignUp(size);
+		if (aligned == 0u || head_ + aligned > capacityPerFrame_)
+			return kInvalidOffset;
+		uint64_t offset = static_cast<uint64_t>(frameIndex_) * capacityPerFrame_ + head_;
+		head_ += aligned;
+		return offset;
+	}
+
+	uint64_t GetTotalSize() const { return capacityPerFrame_ * fenceValues_.size(); }
+	uint64_t GetUsedThisFrame() const { return head_; }
+	uint32_t GetFrameIndex() const { return frameIndex_; }
+
+	static uint64_t AlignUp(uint64_t size) { return (size + kAlignment - 1u) & ~(kAlignment - 1u); }
+
+private:
+	uint64_t capacityPerFrame_ = 0u;
+	std::vector<uint64_t> fenceValues_; // 区画ごとに最後に使ったフレームのフェンス値
+	uint32_t frameIndex_ = 0u;
+	uint64_t head_ = 0u;
+};
@@ -0,0 +1,83 @@
+#include "Frustum.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE__)
+#include <xmmintrin.h>
+#define FRUSTUM_USE_SSE 1
+#endif
+
+using namespace KamataEngine;
+
+void Frustum::Extract(const Matrix4x4& matView, const Matrix4x4& matProjection) {
+	// viewProj = matView * matProjection
+	float m[4][4] = {};
+	for (int i = 0; i < 4; ++i)
+		for (int j = 0; j < 4; ++j)
+			for (int k = 0; k < 4; ++k)
+				m[i][j] += matView.m[i][k] * matProjection.m[k][j];
+
+	// clip = v * M なので、各平面は列の組み合わせになる
+	for (int i = 0; i < 4; ++i) {
+		planes_[0][i] = m[i][3] + m[i][0]; // 左
+		planes_[1][i] = m[i][3] - m[i][0]; // 右
+		planes_[2][i] = m[i][3] + m[i][1]; // 下
+		planes_[3][i] = m[i][3] - m[i][1]; // 上
+		planes_[4][i] = m[i][2];           // 手前（z >= 0）
+		planes_[5][i] = m[i][3] - m[i][2]; // 奥
+	}
+
+	// 距離を比較できるよう正規化
+	for (auto& p : planes_) {
+		float len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+		if (len > 1e-6f) {
+			p[0] /= len;
+			p[1] /= len;
+			p[2] /= len;
+			p[3] /= len;
+		}
+	}
+}
+
+bool Frustum::IsVisible(const Vector3& center, float radius) const {
+	for (const auto& p : planes_) {
+		if (p[0] * center.x + p[1] * center.y + p[2] * center.z + p[3] < -radius)
+			return false;
+	}
+	return true;
+}
+
+size_t Frustum::CullSpheres(const float* xs, const float* ys, const float* zs, const float* radii, size_t count, uint8_t* visible) const {
+	size_t numVisible = 0u;
+	size_t i = 0u;
+
+#ifdef FRUSTUM_USE_SSE
+	// 4個ずつ：全平面で「距離 >= -半径」なら可視
+	for (; i + 4u <= count; i += 4u) {
+		__m128 x = _mm_loadu_ps(xs + i);
+		__m128 y = _mm_loadu_ps(ys + i);
+		__m128 z = _mm_loadu_ps(zs + i);
+		__m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i));
+
+		__m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps()); // 全ビット1
+		for (const auto& p : planes_) {
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(p[0])), _mm_mul_ps(y, _mm_set1_ps(p[1]))), _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(p[2])), _mm_set1_ps(p[3])));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+		}
+
+		int mask = _mm_movemask_ps(inside);
+		for (size_t k = 0; k < 4u; ++k) {
+			uint8_t v = static_cast<uint8_t>((mask >> k) & 1);
+			visible[i + k] = v;
+			numVisible += v;
+		}
+	}
+#endif
+
+	// 端数（SIMD なしの環境では全部）
+	for (; i < count; ++i) {
+		uint8_t v = IsVisible({xs[i], ys[i], zs[i]}, radii[i]) ? 1u : 0u;
+		visible[i] = v;
+		numVisible += v;
+	}
+	return numVisible;
+}
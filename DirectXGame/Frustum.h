@@ -0,0 +1,32 @@
+#pragma once
+#include <KamataEngine.h>
+#include <cstddef>
+#include <cstdint>
+
+using namespace KamataEngine;
+
+// 視錐台（6平面）と球の可視判定
+// ・平面は Camera の matView * matProjection から取り出す（行ベクトル規約、D3D の z∈[0,1]）
+// ・判定は SoA 配列を4個ずつ SIMD で処理する
+class Frustum {
+public:
+	// 判定結果の集計
+	struct Stats {
+		uint32_t tested = 0u;
+		uint32_t culled = 0u;
+	};
+
+	// ビュー行列・射影行列から平面を取り出す
+	void Extract(const Matrix4x4& matView, const Matrix4x4& matProjection);
+	void Extract(const Camera& camera) { Extract(camera.matView, camera.matProjection); }
+
+	// 球1個の判定
+	bool IsVisible(const Vector3& center, float radius) const;
+
+	// 球 count 個をまとめて判定し、visible[i] に 0/1 を書く。可視数を返す
+	size_t CullSpheres(const float* xs, const float* ys, const float* zs, const float* radii, size_t count, uint8_t* visible) const;
+
+private:
+	// 平面 nx*x + ny*y + nz*z + d >= 0 が内側（法線は正規化済み）
+	float planes_[6][4] = {};
+};
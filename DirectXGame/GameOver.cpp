@@ -1,11 +1,25 @@
 #include "GameOver.h"
+#include "AssetCache.h"
+#include "Leaderboard.h"
+#include "XAudio2Sink.h"
 #include <numbers>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
 
 using namespace KamataEngine;
 
-GameOverScene::~GameOverScene() {
-	delete modelGameOver_;
-	modelGameOver_ = nullptr;
+namespace {
+// ハイスコア表の左上（スコアの下）
+const Vector2 kRankingPos = {800.0f, 120.0f};
+} // namespace
+
+GameOverScene::~GameOverScene() = default;
+
+void GameOverScene::PrefetchAssets() {
+	AssetCache* cache = AssetCache::GetInstance();
+	cache->PrefetchModel("GameOverFont", true);
+	cache->PrefetchModel("TitleSkydome");
 }
 
 void GameOverScene::Initialize() {
@@ -18,8 +32,8 @@ void GameOverScene::Initialize() {
 
 
 	// GameOver OBJ
-	modelGameOver_ = Model::CreateFromOBJ("GameOverFont", true);
-	modelSkydome_ = Model::CreateFromOBJ("TitleSkydome");
+	modelGameOver_ = AssetCache::GetInstance()->AcquireModel("GameOverFont", true);
+	modelSkydome_ = AssetCache::GetInstance()->AcquireModel("TitleSkydome");
 
 	// Transform
 	wt_ = std::make_unique<WorldTransform>();
@@ -28,7 +42,7 @@ void GameOverScene::Initialize() {
 	wt_->scale_ = {1, 1, 1};
 
 	// ★ HUD
-	hud_.Initialize("Font.png");
+	hud_.Initialize();
 	
 
 	// フェード
@@ -39,17 +53,11 @@ void GameOverScene::Initialize() {
 	step_ = Step::FadeIn;
 
 
-	// Audio のインスタンス取得
-	auto* audio = Audio::GetInstance();
-
-	// BGM 読み込み（WAV形式）
-	bgmHandle_ = audio->LoadWave("./BGM/EVOLUTION.wav");
-
-	// ループ再生 (volume=0.5)
-	bgmVoice_ = audio->PlayWave(bgmHandle_, true, 0.5f);
+	// BGM をストリーミングでループ再生 (volume=0.5)
+	bgm_.Play("./BGM/EVOLUTION.wav", std::make_unique<XAudio2Sink>(), true, 0.5f);
 
-	skydome_ = new Skydome();
-	skydome_->Initialize(modelSkydome_, cameraPtr_);
+	skydome_ = std::make_unique<Skydome>();
+	skydome_->Initialize(modelSkydome_.get(), cameraPtr_);
 }
 
 void GameOverScene::Update() {
@@ -74,14 +82,9 @@ void GameOverScene::Update() {
 			fade_->Start(Fade::Status::FadeOut, 0.5f);
 			step_ = Step::FadeOut;
 
-			// BGM停止（安全版）
-			if (!bgmStoppedOnGameOver_ && bgmVoice_ != 0) {
-				try {
-					Audio::GetInstance()->StopWave(bgmVoice_);
-				} catch (...) {
-					// 無視
-				}
-				bgmVoice_ = 0;
+			// BGM停止
+			if (!bgmStoppedOnGameOver_) {
+				bgm_.Stop();
 				bgmStoppedOnGameOver_ = true;
 			}
 		}
@@ -94,6 +97,16 @@ void GameOverScene::Update() {
 	case Step::Done:
 		break;
 	}
+
+#ifdef USE_IMGUI
+	const Leaderboard* leaderboard = Leaderboard::GetInstance();
+	const Leaderboard::Stats& lb = leaderboard->GetStats();
+	ImGui::Begin("Leaderboard");
+	ImGui::Text("runs       : %llu (snapshot %u / journal %u / compactions %u / truncated %u B)", static_cast<unsigned long long>(leaderboard->GetCount()), lb.snapshotRuns, lb.journalRuns,
+	            lb.compactions, lb.truncatedBytes);
+	ImGui::Text("this run   : %d, rank %llu, percentile %.1f", finalScore_, static_cast<unsigned long long>(rank_), percentile_);
+	ImGui::End();
+#endif
 }
 
 void GameOverScene::Draw() {
@@ -109,12 +122,29 @@ void GameOverScene::Draw() {
 	Model::PostDraw();
 
 	 // ★ リザルト（スコア表示）
-	Sprite::PreDraw(dxCommon->GetCommandList());
+	hud_.Begin(dxCommon->GetCommandList());
 	hud_.DrawScore(finalScore_); // ここで大きく出したければHUD側で倍率対応を
-	Sprite::PostDraw();
+	// 上位3件と、入っていなければその下に今回の順位
+	hud_.DrawRankingTop3(top3_, kRankingPos);
+	if (rank_ > top3_.size())
+		hud_.DrawRankingRow(rank_, finalScore_, {kRankingPos.x, kRankingPos.y + hud_.GetRankingRowHeight() * static_cast<float>(top3_.size())});
+	hud_.End();
 
 	if (fade_)
 		fade_->Draw();
 }
 
+void GameOverScene::SetScore(int s) {
+	finalScore_ = s;
+
+	// 今回のぶんは追記済み。同点は同じ順位
+	const Leaderboard* leaderboard = Leaderboard::GetInstance();
+	Leaderboard::Run top[3];
+	const size_t count = leaderboard->GetTop(top3_.size(), top);
+	for (size_t i = 0; i < top3_.size(); ++i)
+		top3_[i] = i < count ? top[i].score : 0;
+	rank_ = leaderboard->GetRank(s);
+	percentile_ = leaderboard->GetPercentile(s);
+}
+
 bool GameOverScene::IsFinished() const { return step_ == Step::Done; }
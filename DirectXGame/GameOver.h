@@ -2,7 +2,9 @@
 #include "Fade.h"
 #include "Hud.h"
 #include "Skydome.h"
+#include "StreamingVoice.h"
 #include <KamataEngine.h>
+#include <array>
 #include <memory>                   // ★ unique_ptr 使うので追加
 
 using namespace KamataEngine;
@@ -12,13 +14,16 @@ public:
 	GameOverScene() = default;
 	~GameOverScene();
 
+	// 使うアセットの非同期読み込みを始める（前のシーンから呼ぶ）
+	static void PrefetchAssets();
+
 	void Initialize();
 	void Update();
 	void Draw();
 
 	bool IsFinished() const; // Space押したらタイトルに戻る
 	//スコア取得
-	void SetScore(int s) { finalScore_ = s; } // ★ リザルト用スコア受け取り
+	void SetScore(int s); // ★ リザルト用スコア受け取り（ハイスコア表での順位もここで引く）
 
 private:
 	enum class Step {
@@ -29,26 +34,30 @@ private:
 	} step_ = Step::FadeIn;
 
 	Camera camera_{};
-	Model* modelGameOver_ = nullptr;
+	std::shared_ptr<ModelAsset> modelGameOver_;
 	std::unique_ptr<WorldTransform> wt_;
 
 	std::unique_ptr<Fade> fade_;
 
 	//model
-	Model* modelSkydome_ = nullptr;     // 天球
+	std::shared_ptr<ModelAsset> modelSkydome_;     // 天球
 	Camera* cameraPtr_ = nullptr;       // ★ Skydome が参照するのでポインタでも持つ
 
 	// ★ 追加
 	int finalScore_ = 0;
 
+	// ハイスコア表（SetScore の時点のもの）
+	std::array<int, 3> top3_{};
+	uint64_t rank_ = 0u;
+	double percentile_ = 0.0;
+
 	// ★ ポインタではなく値で持つ（これがエラーの主因）
 	Hud hud_;
 
 	// ▼ BGM用
-	uint32_t bgmHandle_ = 0u;  // 読み込んだBGMデータ
-	uint32_t bgmVoice_ = 0u;  // 再生中のハンドル
+	StreamingVoice bgm_; // 少しずつ読みながら再生する
 	bool bgmStoppedOnGameOver_ = false;
 
 	// ============ 天球 ============
-	Skydome* skydome_ = nullptr;
+	std::unique_ptr<Skydome> skydome_;
 };
@@ -1,10 +1,20 @@
 #include "GameScene.h"
+#include "AssetCache.h"
+#include "AssetPack.h"
+#include "GameOver.h"
+#include "MeshGenerator.h"
+#include "TextureFile.h"
+#include "VoicePool.h"
+#include "XAudio2Sink.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <limits>
 #include <numbers>
 #include <string>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
 
 using namespace KamataEngine;
 
@@ -30,6 +40,18 @@ bool GameScene::FindNearestEnemy(const Vector3& from, Vector3& outPos) const {
 	return found;
 }
 
+void GameScene::PrefetchAssets() {
+	// Initialize で Acquire するものと揃える
+	AssetCache* cache = AssetCache::GetInstance();
+	cache->PrefetchModel("base");
+	cache->PrefetchModel("circle");
+	cache->PrefetchModel("paddle");
+	cache->PrefetchModel("PlayerBullet");
+	cache->PrefetchModel("meteorite");
+	cache->PrefetchModel("universedome");
+	cache->PrefetchTexture(UiAtlas::kTextureFile);
+}
+
 void GameScene::Initialize() {
 	// カメラ（真上俯瞰）
 	camera_.Initialize();
@@ -39,74 +61,68 @@ void GameScene::Initialize() {
 	cameraPtr_ = &camera_; // Skydome に渡す用
 
 	// モデル
-	modelBase_ = Model::CreateFromOBJ("base");          // コア見た目
-	modelBlockRing_ = Model::CreateFromOBJ("circle");   // リング
-	modelBlockPaddle_ = Model::CreateFromOBJ("paddle"); // パドル
-	modelShot_ = Model::CreateFromOBJ("PlayerBullet");  // 弾
-	modelEnemy_ = Model::CreateFromOBJ("meteorite");    // 敵
-	modelSkydome_ = Model::CreateFromOBJ("universedome");
+	AssetCache* cache = AssetCache::GetInstance();
+	modelBase_ = cache->AcquireModel("base");          // コア見た目
+	modelBlockRing_ = cache->AcquireModel("circle");   // リング
+	modelBlockPaddle_ = cache->AcquireModel("paddle"); // パドル
+	modelShot_ = cache->AcquireModel("PlayerBullet");  // 弾
+	modelEnemy_ = cache->AcquireModel("meteorite");    // 敵
+	modelSkydome_ = cache->AcquireModel("universedome");
 
 	// HUD
-	hud_.Initialize("Font.png");
-
-	// 円環 WT
-	ringSegWT_.reserve(kRingSegments);
-	for (int i = 0; i < kRingSegments; ++i) {
-		auto wt = std::make_unique<WorldTransform>();
-		wt->Initialize();
-		ringSegWT_.push_back(std::move(wt));
-	}
+	hud_.Initialize();
 
-	paddleSegWT_.reserve(kPaddleSegments);
-	for (int i = 0; i < kPaddleSegments; ++i) {
-		auto wt = std::make_unique<WorldTransform>();
-		wt->Initialize();
-		paddleSegWT_.push_back(std::move(wt));
-	}
+	// 円環・パドル（手続き生成メッシュ）
+	ringMesh_.Initialize((kRingSegments + 1) * 2, kRingSegments * 6);
+	paddleMesh_.Initialize((kPaddleSegments + 1) * 2 * 2, kPaddleSegments * 6 * 2); // 2本分
+	meshVertices_.reserve((kRingSegments + 1) * 2);
+	meshIndices_.reserve(kRingSegments * 6);
 
-	// 2本目パドル用
-	paddleSegWT2_.reserve(kPaddleSegments);
-	for (int i = 0; i < kPaddleSegments; ++i) {
-		auto wt = std::make_unique<WorldTransform>();
-		wt->Initialize();
-		paddleSegWT2_.push_back(std::move(wt));
-	}
-
-	coreWT_ = std::make_unique<WorldTransform>();
-	coreWT_->Initialize();
+	// 見た目（テクスチャ・マテリアル）は OBJ のものを借りる
+	if (modelBlockRing_)
+		ringMaterial_ = modelBlockRing_->GetMaterial();
+	if (modelBlockPaddle_)
+		paddleMaterial_ = modelBlockPaddle_->GetMaterial();
+	ringMeshDirty_ = true;
 
 	// コンテナ確保
 	shots_.reserve(128);
 	enemies_.reserve(128);
+	renderQueue_.Initialize(512);
+	cullX_.reserve(256);
+	cullY_.reserve(256);
+	cullZ_.reserve(256);
+	cullR_.reserve(256);
+	cullVisible_.reserve(256);
 
 	// 初期配置計算
 	RecomputePaddleHalfWidth();
 	UpdateRingAndPaddle(0.0f);
 
+	// 障害物マップ（リングの中心に合わせて置く）
+	LoadTileMap();
+
 	score_ = 0;
 	skill_ = 0;
 	timer_ = 0;
+	maxCombo_ = 0;
 	life_ = 3;
 	shield_ = 0;
 	timerAcc_ = 0.0f;
 
 	//----------BGM----------///
-	// Audio のインスタンス取得
-	auto* audio = Audio::GetInstance();
-	// BGM 読み込み（WAV形式）
-	bgmHandle_ = audio->LoadWave("./BGM/EVOLUTION.wav");
-	// ループ再生 (volume=0.5)
-	bgmVoice_ = audio->PlayWave(bgmHandle_, true, 0.5f);
+	// ストリーミングでループ再生 (volume=0.5)
+	bgm_.Play("./BGM/EVOLUTION.wav", std::make_unique<XAudio2Sink>(), true, 0.5f);
 
 	// 天球
-	skydome_ = new Skydome();
-	skydome_->Initialize(modelSkydome_, cameraPtr_);
-
-	// スキル砲台テクスチャ（出現時にスプライト生成）
-	texSkillCannon_ = TextureManager::Load("SkillCannon.png");
+	skydome_ = std::make_unique<Skydome>();
+	skydome_->Initialize(modelSkydome_.get(), cameraPtr_);
 
 	// 生成フラグ
 	skillCannonSpawned_ = false;
+
+	// ゲームオーバー画面のぶんをプレイ中に読んでおく
+	GameOverScene::PrefetchAssets();
 }
 
 void GameScene::Update() {
@@ -173,6 +189,8 @@ void GameScene::Update() {
 	}
 
 	// 更新
+	tileQueries_ = 0u;
+	tileBlocked_ = 0u;
 	UpdateRingAndPaddle(dt);
 	UpdateShots(dt); // ★ホーミング制御
 	UpdateEnemies(dt);
@@ -188,22 +206,55 @@ void GameScene::Update() {
 	UpdateSkillCannon(dt);
 
 	camera_.UpdateMatrix();
+
+#ifdef USE_IMGUI
+	// 描画キューの統計（前フレーム分）
+	const RenderQueue::Stats& rq = renderQueue_.GetStats();
+	ImGui::Begin("RenderQueue");
+	ImGui::Text("packets    : %u", rq.packets);
+	ImGui::Text("binds      : %u", rq.binds);
+	ImGui::Text("bindsSaved : %d", rq.bindsSaved);
+	ImGui::Text("culled     : %u / %u", cullStats_.culled, cullStats_.tested);
+	const SpriteBatch::Stats& hudStats = hud_.GetBatchStats();
+	ImGui::Text("hud quads  : %u (draws %u)", hudStats.quads, hudStats.draws);
+	const AssetCache::Stats& cacheStats = AssetCache::GetInstance()->GetStats();
+	ImGui::Text("assets     : %u (hit %u / load %u / shared %u / released %u)", cacheStats.models, cacheStats.hits, cacheStats.loads, cacheStats.shared, cacheStats.released);
+	const TextureDedupStats dedup = GetTextureDedupStats();
+	ImGui::Text("textures   : %u files / %u unique (saved %u SRV, %llu KB)", dedup.files, dedup.unique, dedup.descriptorsSaved, static_cast<unsigned long long>(dedup.gpuBytesSaved / 1024u));
+	const VoicePool::Stats& se = VoicePool::GetInstance()->GetStats();
+	ImGui::Text("se voices  : %u (played %u / stolen %u / dropped %u / queueFull %u / underruns %u)", VoicePool::GetInstance()->GetActiveCount(), se.played, se.stolen, se.dropped,
+	            se.queueFull, VoicePool::GetInstance()->GetUnderrunCount());
+	ImGui::End();
+
+	ImGui::Begin("TileMap");
+	ImGui::Checkbox("obstacles", &tileObstacles_);
+	ImGui::Text("map        : %u x %u, %u solid", tileMap_.GetWidth(), tileMap_.GetHeight(), tileMap_.CountSolid());
+	ImGui::Text("queries    : %u (blocked %u)", tileQueries_, tileBlocked_);
+	ImGui::End();
+#endif
 }
 
 void GameScene::Draw() {
 	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
 
+	// カリング用の視錐台
+	frustum_.Extract(camera_);
+	cullStats_ = {};
+
 	// === 3D ===
 	Model::PreDraw(dxCommon->GetCommandList());
 	if (skydome_)
-		skydome_->Draw();
+		skydome_->Draw(renderQueue_);
 	DrawRingAndPaddle();
 	DrawShots();
 	DrawEnemies();
+	if (tileObstacles_ && tileMesh_.GetIndexCount())
+		renderQueue_.Push(tileMesh_, ringMaterial_, tileMatWorld_);
+	renderQueue_.Submit(camera_); // ソートしてまとめて発行
 	Model::PostDraw();
 
-	// === HUD ===
-	Sprite::PreDraw(dxCommon->GetCommandList());
+	// === HUD（テクスチャごとにまとめて発行） ===
+	hud_.Begin(dxCommon->GetCommandList());
 
 	// スキル砲台アイコン（スコアの“横”に表示）
 	DrawSkillCannon();
@@ -213,81 +264,67 @@ void GameScene::Draw() {
 	hud_.DrawLife(life_);
 	hud_.DrawSkill(skill_);
 
-	Sprite::PostDraw();
+	hud_.End();
+}
+
+Leaderboard::Run GameScene::GetRun() const {
+	Leaderboard::Run run;
+	run.score = score_;
+	run.playSeconds = static_cast<uint32_t>(timer_);
+	run.maxCombo = static_cast<uint32_t>(maxCombo_);
+	run.seed = 0u;     // 不明（rand() はプロセスを通して続けて引くので、プレイごとの種はない）
+	run.replayId = 0u; // リプレイはまだ保存しない
+	return run;
 }
 
 void GameScene::StopBGMOnGameOver() {
 	if (bgmStoppedOnGameOver_)
 		return; // 二重停止防止
 
-	auto* audio = Audio::GetInstance();
-	if (bgmVoice_ != 0) {
-		try {
-			audio->StopWave(bgmVoice_);
-		} catch (...) {
-			// 念のため例外は無視
-		}
-		bgmVoice_ = 0; // 無効化
-	}
+	bgm_.Stop();
 	bgmStoppedOnGameOver_ = true;
 }
 
 // ==================== 円環 ====================
 void GameScene::UpdateRingAndPaddle(float /*dt*/) {
-	// リング
-	const int N = kRingSegments;
-	for (int i = 0; i < N; ++i) {
-		float a = -PI + (2.0f * PI) * (i / static_cast<float>(N));
-		float inner = ringR_ - ringThickness_ * 0.5f;
-		float outer = ringR_ + ringThickness_ * 0.5f;
-		float mid = (inner + outer) * 0.5f;
+	// リング（半径が変わった時だけ作り直す）
+	if (ringMeshDirty_)
+		RebuildRingMesh();
 
-		auto& wt = *ringSegWT_[i];
-		wt.translation_ = {ringC_.x + mid * std::cos(a), 0.0f, ringC_.z + mid * std::sin(a)};
-		wt.rotation_.y = a + PI / 2.0f;
-		wt.scale_ = {ringThickness_, 0.1f, (2.0f * PI * ringR_) / N};
-		WorldTransformUpdate(wt);
-	}
+	// パドル（幅・半径・本数が変わった時だけ作り直し、角度は回転で与える）
+	if (paddleMeshHalfWidth_ != paddle_.halfWidth || paddleMeshRingR_ != ringR_ || paddleMeshDouble_ != doublePaddle_)
+		RebuildPaddleMesh();
 
-	// パドル（1本目）
-	const int P = kPaddleSegments;
-	for (int i = 0; i < P; ++i) {
-		float a = paddle_.angle - paddle_.halfWidth + (2.0f * paddle_.halfWidth) * (i / static_cast<float>(P - 1));
-		float inner = ringR_ - ringThickness_ * 0.5f;
-		float outer = ringR_ + ringThickness_ * 0.5f;
-		float mid = (inner + outer) * 0.5f;
+	// メッシュは角度0基準なので、Y回転 -angle で paddle_.angle 方向へ向ける
+	paddleMatWorld_ = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.0f, -paddle_.angle, 0.0f}, ringC_);
 
-		auto& wt = *paddleSegWT_[i];
-		wt.translation_ = {ringC_.x + mid * std::cos(a), 0.0f, ringC_.z + mid * std::sin(a)};
-		wt.rotation_.y = a + PI / 2.0f;
-		wt.scale_ = {ringThickness_ * 1.2f, 0.2f, (2.0f * paddle_.halfWidth * ringR_) / P * 1.2f};
-		WorldTransformUpdate(wt);
-	}
+	// コア（見た目は小さめ／当たりは coreR_ で管理）
+	coreMatWorld_ = MakeAffineMatrix({coreR_ * 0.1f, 0.1f, coreR_ * 0.1f}, {0.0f, 0.0f, 0.0f}, ringC_);
+}
 
-	// パドル（2本目：反対側）
-	if (doublePaddle_) {
-		float angle2 = paddle_.angle + PI; // 180度反対
-		const int Q = kPaddleSegments;
-		for (int i = 0; i < Q; ++i) {
-			float a = angle2 - paddle_.halfWidth + (2.0f * paddle_.halfWidth) * (i / static_cast<float>(Q - 1));
-			float inner = ringR_ - ringThickness_ * 0.5f;
-			float outer = ringR_ + ringThickness_ * 0.5f;
-			float mid = (inner + outer) * 0.5f;
-
-			auto& wt = *paddleSegWT2_[i];
-			wt.translation_ = {ringC_.x + mid * std::cos(a), 0.0f, ringC_.z + mid * std::sin(a)};
-			wt.rotation_.y = a + PI / 2.0f;
-			wt.scale_ = {ringThickness_ * 1.2f, 0.2f, (2.0f * paddle_.halfWidth * ringR_) / Q * 1.2f};
-			WorldTransformUpdate(wt);
-		}
-	}
+void GameScene::RebuildRingMesh() {
+	float inner = ringR_ - ringThickness_ * 0.5f;
+	float outer = ringR_ + ringThickness_ * 0.5f;
+	BuildAnnulus(meshVertices_, meshIndices_, inner, outer, kRingSegments, 0.1f);
+	ringMesh_.Upload(meshVertices_, meshIndices_);
 
-	// コア（見た目は小さめ／当たりは coreR_ で管理）
-	auto& cwt = *coreWT_;
-	cwt.translation_ = ringC_;
-	cwt.rotation_ = {0, 0, 0};
-	cwt.scale_ = {coreR_ * 0.1f, 0.1f, coreR_ * 0.1f};
-	WorldTransformUpdate(cwt);
+	ringMatWorld_ = MakeTranslateMatrix(ringC_);
+	ringMeshDirty_ = false;
+}
+
+void GameScene::RebuildPaddleMesh() {
+	// 従来の箱並べと同じく、リング厚の 1.2 倍の幅でリングより少し上に置く
+	float halfT = ringThickness_ * 1.2f * 0.5f;
+	meshVertices_.clear();
+	meshIndices_.clear();
+	AppendArc(meshVertices_, meshIndices_, 0.0f, paddle_.halfWidth, ringR_ - halfT, ringR_ + halfT, kPaddleSegments, 0.2f);
+	if (doublePaddle_)
+		AppendArc(meshVertices_, meshIndices_, PI, paddle_.halfWidth, ringR_ - halfT, ringR_ + halfT, kPaddleSegments, 0.2f); // 180度反対
+	paddleMesh_.Upload(meshVertices_, meshIndices_);
+
+	paddleMeshHalfWidth_ = paddle_.halfWidth;
+	paddleMeshRingR_ = ringR_;
+	paddleMeshDouble_ = doublePaddle_;
 }
 
 // ==================== 弾（プレイヤー発射・直進） ====================
@@ -312,11 +349,7 @@ void GameScene::SpawnShot() {
 	s.speed = kPlayerShotSpeed; // 一定速度
 	s.vel = {dir.x * s.speed * (1.0f / 60.0f), 0.0f, dir.z * s.speed * (1.0f / 60.0f)};
 
-	s.wt = std::make_unique<WorldTransform>();
-	s.wt->Initialize();
-	s.wt->translation_ = s.pos;
-	s.wt->scale_ = {kShotVisualScale, kShotVisualScale, kShotVisualScale};
-	WorldTransformUpdate(*s.wt);
+	s.matWorld = MakeAffineMatrix({kShotVisualScale, kShotVisualScale, kShotVisualScale}, {0.0f, 0.0f, 0.0f}, s.pos);
 
 	// 当たり半径は見た目から算出して保持
 	s.radius = kShotVisualScale * kShotCollisionFromVisual;
@@ -375,6 +408,16 @@ void GameScene::UpdateShots(float dt) {
 			// ターゲットが居ないときは直進維持
 		}
 
+		// 障害物マップに当たる弾は消える（このフレームに進む線分で調べる）
+		if (tileObstacles_) {
+			tileQueries_++;
+			if (tileMap_.Raycast(ToTileX(s.pos.x), ToTileY(s.pos.z), ToTileX(s.pos.x + s.vel.x), ToTileY(s.pos.z + s.vel.z))) {
+				tileBlocked_++;
+				s.active = false;
+				continue;
+			}
+		}
+
 		// 位置更新
 		s.pos += s.vel;
 
@@ -387,10 +430,7 @@ void GameScene::UpdateShots(float dt) {
 			continue;
 		}
 
-		if (s.wt) {
-			s.wt->translation_ = s.pos;
-			WorldTransformUpdate(*s.wt);
-		}
+		s.matWorld = MakeAffineMatrix({kShotVisualScale, kShotVisualScale, kShotVisualScale}, {0.0f, 0.0f, 0.0f}, s.pos);
 	}
 
 	// inactive を削除
@@ -406,9 +446,19 @@ void GameScene::SpawnEnemy() {
 	e.active = true;
 
 	float angle = RandomRange(0.0f, 2.0f * PI);
-	float radius = ringR_ * 2.5f;
+	float radius = ringR_ * kEnemySpawnRScale;
 	e.pos = {ringC_.x + radius * std::cos(angle), 0.0f, ringC_.z + radius * std::sin(angle)};
 
+	// 障害物マップの埋まりマスに出たら、一番近い空きマスの中心へずらす
+	if (tileObstacles_ && EnemyHitsTiles(e.pos)) {
+		int32_t freeX = 0;
+		int32_t freeY = 0;
+		if (tileMap_.FindNearestFree(static_cast<int32_t>(std::floor(ToTileX(e.pos.x))), static_cast<int32_t>(std::floor(ToTileY(e.pos.z))), freeX, freeY)) {
+			e.pos.x = tileOrigin_.x + (float(freeX) + 0.5f) * tileSize_;
+			e.pos.z = tileOrigin_.z - (float(freeY) + 0.5f) * tileSize_;
+		}
+	}
+
 	Vector3 dir = {ringC_.x - e.pos.x, 0.0f, ringC_.z - e.pos.z};
 	float len = std::sqrt(dir.x * dir.x + dir.z * dir.z);
 	if (len > 1e-5f) {
@@ -419,11 +469,7 @@ void GameScene::SpawnEnemy() {
 	float speed = 2.0f;
 	e.vel = {dir.x * speed * (1.0f / 60.0f), 0.0f, dir.z * speed * (1.0f / 60.0f)};
 
-	e.wt = std::make_unique<WorldTransform>();
-	e.wt->Initialize();
-	e.wt->translation_ = e.pos;
-	e.wt->scale_ = {0.5f, 0.5f, 0.5f};
-	WorldTransformUpdate(*e.wt);
+	e.matWorld = MakeAffineMatrix({0.5f, 0.5f, 0.5f}, {0.0f, 0.0f, 0.0f}, e.pos);
 }
 
 void GameScene::UpdateEnemies(float dt) {
@@ -457,7 +503,10 @@ void GameScene::UpdateEnemies(float dt) {
 		}
 
 		// 移動
-		e.pos += e.vel;
+		if (tileObstacles_)
+			MoveEnemyOnTiles(e);
+		else
+			e.pos += e.vel;
 
 		float dx = e.pos.x - ringC_.x;
 		float dz = e.pos.z - ringC_.z;
@@ -566,17 +615,16 @@ void GameScene::UpdateEnemies(float dt) {
 				e.active = false;
 				// コンボと倍率
 				paddleCombo_++;
+				maxCombo_ = (std::max)(maxCombo_, paddleCombo_);
 				comboTimer_ = comboTimeout_;
 				scoreMul_ = 1.0f + 0.2f * float(paddleCombo_);
 				score_ += int(std::round(50.0f * scoreMul_));
 			}
 		}
 
-		// Transform 更新
-		if (e.active && e.wt) {
-			e.wt->translation_ = e.pos;
-			WorldTransformUpdate(*e.wt);
-		}
+		// 行列更新
+		if (e.active)
+			e.matWorld = MakeAffineMatrix({0.5f, 0.5f, 0.5f}, {0.0f, 0.0f, 0.0f}, e.pos);
 	}
 
 	// inactive を削除
@@ -585,42 +633,135 @@ void GameScene::UpdateEnemies(float dt) {
 	}
 }
 
+// ==================== 障害物マップ ====================
+void GameScene::LoadTileMap() {
+	std::vector<uint8_t> storage;
+	std::span<const uint8_t> text;
+	if (!AssetPack::GetInstance()->Load("Resources/blocks.csv", storage, text) || !tileMap_.Parse(text))
+		return; // なければ障害物なし（tileMap_ は空のまま）
+
+	// 1マスの大きさは、リングが広がりきったときの出現円（と敵の箱）が外周1マスの内側に収まるように決める
+	// （100x20 のマップなら短い辺の内側 18 マスで直径 48.5 を覆うので、約 2.7）
+	const uint32_t shortSide = (std::min)(tileMap_.GetWidth(), tileMap_.GetHeight());
+	const float spawnRMax = (ringRBase_ + kRingRGrowthMax) * kEnemySpawnRScale + kEnemyTileHalf;
+	tileSize_ = 2.0f * spawnRMax / float(shortSide > 2u ? shortSide - 2u : 1u);
+
+	// マップの中心をリングの中心に合わせる
+	tileOrigin_ = {ringC_.x - float(tileMap_.GetWidth()) * tileSize_ * 0.5f, 0.0f, ringC_.z + float(tileMap_.GetHeight()) * tileSize_ * 0.5f};
+
+	// 横につながった埋まりマスを1枚の板にして、1回で描けるメッシュにする
+	std::vector<TileMap::Span> spans;
+	tileMap_.GetSpans(spans);
+	if (spans.empty())
+		return;
+	meshVertices_.clear();
+	meshIndices_.clear();
+	for (const TileMap::Span& span : spans) {
+		const float z0 = tileOrigin_.z - float(span.y + 1) * tileSize_;
+		AppendRect(meshVertices_, meshIndices_, tileOrigin_.x + float(span.x0) * tileSize_, z0, tileOrigin_.x + float(span.x1) * tileSize_, z0 + tileSize_, 0.05f);
+	}
+	tileMesh_.Initialize(static_cast<uint32_t>(meshVertices_.size()), static_cast<uint32_t>(meshIndices_.size()));
+	tileMesh_.Upload(meshVertices_, meshIndices_);
+	tileMatWorld_ = MakeIdentityMatrix();
+}
+
+bool GameScene::EnemyHitsTiles(const Vector3& pos) const {
+	// マスの y は -z 向きなので、箱の上端（+z）が小さい y になる
+	return tileMap_.OverlapsBox(ToTileX(pos.x - kEnemyTileHalf), ToTileY(pos.z + kEnemyTileHalf), ToTileX(pos.x + kEnemyTileHalf), ToTileY(pos.z - kEnemyTileHalf));
+}
+
+void GameScene::MoveEnemyOnTiles(Enemy& e) {
+	tileQueries_++;
+	Vector3 next = e.pos + e.vel;
+	if (!EnemyHitsTiles(next)) {
+		e.pos = next;
+		return;
+	}
+
+	// 途中で切り替えて既に埋まりマスに掛かっているものは、抜けられるようそのまま動かす
+	if (EnemyHitsTiles(e.pos)) {
+		e.pos = next;
+		return;
+	}
+
+	// x だけ・z だけ動かしてみて、入れる向きがあればそちらへ滑る（どちらもだめならその場で止まる）
+	tileBlocked_++;
+	if (!EnemyHitsTiles({next.x, e.pos.y, e.pos.z}))
+		e.pos.x = next.x;
+	else if (!EnemyHitsTiles({e.pos.x, e.pos.y, next.z}))
+		e.pos.z = next.z;
+}
+
 // ==================== 描画 ====================
 void GameScene::DrawRingAndPaddle() {
-	if (!modelBlockRing_ && !modelBlockPaddle_)
+	// リング1回＋パドル1回（2本目も同じメッシュ内）
+	// リング全体を包む球で判定（パドルはリング上にあるので同じ結果）
+	cullStats_.tested++;
+	if (!frustum_.IsVisible(ringC_, ringR_ + ringThickness_)) {
+		cullStats_.culled++;
 		return;
-
-	for (auto& up : ringSegWT_)
-		modelBlockRing_->Draw(*up, camera_);
-	for (auto& up : paddleSegWT_)
-		modelBlockPaddle_->Draw(*up, camera_);
-	if (doublePaddle_) {
-		for (auto& up : paddleSegWT2_)
-			modelBlockPaddle_->Draw(*up, camera_);
 	}
 
+	renderQueue_.Push(ringMesh_, ringMaterial_, ringMatWorld_);
+	renderQueue_.Push(paddleMesh_, paddleMaterial_, paddleMatWorld_);
+
 	// コア見た目
-	if (modelBase_ && coreWT_)
-		modelBase_->Draw(*coreWT_, camera_);
+	if (modelBase_)
+		renderQueue_.Push(modelBase_.get(), coreMatWorld_);
+}
+
+size_t GameScene::CullGathered() {
+	size_t count = cullX_.size();
+	cullVisible_.resize(count);
+	size_t visible = frustum_.CullSpheres(cullX_.data(), cullY_.data(), cullZ_.data(), cullR_.data(), count, cullVisible_.data());
+	cullStats_.tested += static_cast<uint32_t>(count);
+	cullStats_.culled += static_cast<uint32_t>(count - visible);
+	return visible;
 }
 
 void GameScene::DrawShots() {
 	if (!modelShot_)
 		return;
+
+	cullX_.clear();
+	cullY_.clear();
+	cullZ_.clear();
+	cullR_.clear();
 	for (auto& s : shots_) {
-		if (!s.active || !s.wt)
+		cullX_.push_back(s.pos.x);
+		cullY_.push_back(s.pos.y);
+		cullZ_.push_back(s.pos.z);
+		cullR_.push_back(kShotVisualScale);
+	}
+	CullGathered();
+
+	for (size_t i = 0; i < shots_.size(); ++i) {
+		if (!shots_[i].active || !cullVisible_[i])
 			continue;
-		modelShot_->Draw(*s.wt, camera_);
+		renderQueue_.Push(modelShot_.get(), shots_[i].matWorld);
 	}
 }
 
 void GameScene::DrawEnemies() {
 	if (!modelEnemy_)
 		return;
+
+	cullX_.clear();
+	cullY_.clear();
+	cullZ_.clear();
+	cullR_.clear();
 	for (auto& e : enemies_) {
-		if (!e.active || !e.wt)
+		cullX_.push_back(e.pos.x);
+		cullY_.push_back(e.pos.y);
+		cullZ_.push_back(e.pos.z);
+		cullR_.push_back(kEnemyRadius); // 見た目より大きめの当たり半径で安全側に
+	}
+	CullGathered();
+
+	for (size_t i = 0; i < enemies_.size(); ++i) {
+		if (!enemies_[i].active || !cullVisible_[i])
 			continue;
-		modelEnemy_->Draw(*e.wt, camera_);
+		renderQueue_.Push(modelEnemy_.get(), enemies_[i].matWorld);
 	}
 }
 
@@ -640,7 +781,7 @@ void GameScene::ApplyProgression() {
 	if (score_ >= 1200)
 		newRingR += 0.5f; // 合計 +1.0
 	if (score_ >= 2000)
-		newRingR += 0.5f; // 合計 +1.5
+		newRingR += 0.5f; // 合計 +1.5（kRingRGrowthMax）
 
 	// 強化発生判定（上方向の変化のみ）
 	bool strengthened = false;
@@ -669,8 +810,10 @@ void GameScene::ApplyProgression() {
 	slowActive_ = newSlow;
 	turretActive_ = newTurret;
 
-	if (std::abs(newRingR - ringR_) > 1e-4f)
+	if (std::abs(newRingR - ringR_) > 1e-4f) {
 		ringR_ = newRingR;
+		ringMeshDirty_ = true; // リングメッシュはここでだけ作り直す
+	}
 	coreR_ = newCoreR;
 
 	// 強化時にライフ回復（上限3、3のときは回復しない）
@@ -738,11 +881,7 @@ void GameScene::UpdateTurret(float dt) {
 
 	s.vel = {dir.x * s.speed * (1.0f / 60.0f), 0.0f, dir.z * s.speed * (1.0f / 60.0f)};
 
-	s.wt = std::make_unique<WorldTransform>();
-	s.wt->Initialize();
-	s.wt->translation_ = s.pos;
-	s.wt->scale_ = {kShotVisualScale, kShotVisualScale, kShotVisualScale};
-	WorldTransformUpdate(*s.wt);
+	s.matWorld = MakeAffineMatrix({kShotVisualScale, kShotVisualScale, kShotVisualScale}, {0.0f, 0.0f, 0.0f}, s.pos);
 
 	s.radius = kShotVisualScale * kShotCollisionFromVisual;
 
@@ -755,12 +894,6 @@ void GameScene::UpdateTurret(float dt) {
 void GameScene::SpawnSkillCannon() {
 	skillCannon_.active = true;
 	skillCannon_.timer = 0.0f;
-
-	// 見た目（HUD用アイコン）
-	skillCannon_.sprite = Sprite::Create(texSkillCannon_, {0.0f, 0.0f});
-	if (skillCannon_.sprite) {
-		skillCannon_.sprite->SetAnchorPoint({0.0f, 0.0f});
-	}
 }
 
 void GameScene::FireSkillCannonShot() {
@@ -794,11 +927,7 @@ void GameScene::FireSkillCannonShot() {
 
 	s.vel = {dir.x * s.speed * (1.0f / 60.0f), 0.0f, dir.z * s.speed * (1.0f / 60.0f)};
 
-	s.wt = std::make_unique<WorldTransform>();
-	s.wt->Initialize();
-	s.wt->translation_ = s.pos;
-	s.wt->scale_ = {kShotVisualScale, kShotVisualScale, kShotVisualScale};
-	WorldTransformUpdate(*s.wt);
+	s.matWorld = MakeAffineMatrix({kShotVisualScale, kShotVisualScale, kShotVisualScale}, {0.0f, 0.0f, 0.0f}, s.pos);
 
 	s.radius = kShotVisualScale * kShotCollisionFromVisual;
 
@@ -823,8 +952,6 @@ void GameScene::UpdateSkillCannon(float dt) {
 void GameScene::DrawSkillCannon() {
 	if (!skillCannon_.active)
 		return;
-	if (!skillCannon_.sprite)
-		return;
 
 	// ★Skill ラベルの位置・サイズを使う（Scoreではなく）
 	const Vector2& skillPos = hud_.GetSkillLabelPos();
@@ -839,7 +966,5 @@ void GameScene::DrawSkillCannon() {
 	    skillPos.y + (skillSize.y - iconH) * 0.5f // 縦中央揃え
 	};
 
-	skillCannon_.sprite->SetSize({iconW, iconH});
-	skillCannon_.sprite->SetPosition(iconPos);
-	skillCannon_.sprite->Draw();
+	hud_.DrawIcon(UiAtlas::kSkillCannon, iconPos, {iconW, iconH});
 }
@@ -1,7 +1,13 @@
 #pragma once
+#include "Frustum.h"
+#include "GpuMesh.h"
 #include "Hud.h"
+#include "Leaderboard.h"
 #include "Math.h"
+#include "RenderQueue.h"
 #include "Skydome.h"
+#include "StreamingVoice.h"
+#include "TileMap.h"
 #include <KamataEngine.h>
 #include <algorithm>
 #include <memory>
@@ -11,16 +17,20 @@ using namespace KamataEngine;
 
 class GameScene {
 public:
+	// 使うアセットの非同期読み込みを始める（前のシーンから呼ぶ）
+	static void PrefetchAssets();
+
 	void Initialize();
 	void Update();
 	void Draw();
 
 	int GetScore() const { return score_; }
+	// ハイスコア表に残す今回のプレイ
+	Leaderboard::Run GetRun() const;
 	bool IsGameOver() const { return life_ <= 0; }
 
 	// ▼ BGM用
-	uint32_t bgmHandle_ = 0u; // 読み込んだBGMデータ
-	uint32_t bgmVoice_ = 0u;  // 再生中のハンドル
+	StreamingVoice bgm_; // 少しずつ読みながら再生する
 	bool bgmStoppedOnGameOver_ = false;
 	void StopBGMOnGameOver();
 
@@ -28,14 +38,21 @@ private:
 	// ============ リソース ============
 	Camera* cameraPtr_ = nullptr;       // Skydome が参照するのでポインタでも持つ
 	Camera camera_;                     // 実体
-	Model* modelBase_ = nullptr;        // コア見た目用
-	Model* modelBlockRing_ = nullptr;   // リング用
-	Model* modelBlockPaddle_ = nullptr; // パドル用
-	Model* modelShot_ = nullptr;        // 弾
-	Model* modelEnemy_ = nullptr;       // 敵
-	Model* modelSkydome_ = nullptr;     // 天球
+	std::shared_ptr<ModelAsset> modelBase_;        // コア見た目用
+	std::shared_ptr<ModelAsset> modelBlockRing_;   // リング用
+	std::shared_ptr<ModelAsset> modelBlockPaddle_; // パドル用
+	std::shared_ptr<ModelAsset> modelShot_;        // 弾
+	std::shared_ptr<ModelAsset> modelEnemy_;       // 敵
+	std::shared_ptr<ModelAsset> modelSkydome_;     // 天球
 
 	Hud hud_;
+	RenderQueue renderQueue_; // 3D 描画はここに積んでまとめて発行
+
+	// 視錐台カリング（見えるものだけ描画キューへ積む）
+	Frustum frustum_;
+	Frustum::Stats cullStats_;
+	std::vector<float> cullX_, cullY_, cullZ_, cullR_; // 判定用 SoA 作業領域
+	std::vector<uint8_t> cullVisible_;
 	int score_ = 0;
 	int skill_ = 0; // 予備
 	int timer_ = 0; // 経過秒
@@ -51,10 +68,22 @@ private:
 	int life_ = 3;
 	int shield_ = 0;
 
-	std::vector<std::unique_ptr<WorldTransform>> ringSegWT_;
-	std::vector<std::unique_ptr<WorldTransform>> paddleSegWT_;  // 1本目
-	std::vector<std::unique_ptr<WorldTransform>> paddleSegWT2_; // 2本目（有効時のみ描画）
-	std::unique_ptr<WorldTransform> coreWT_;
+	// リング・パドルは手続き生成メッシュ1枚ずつで描く（形状が変わった時だけ再生成）
+	GpuMesh ringMesh_;
+	GpuMesh paddleMesh_; // 2本目は同じメッシュに焼き込む
+	Matrix4x4 ringMatWorld_{};
+	Matrix4x4 paddleMatWorld_{}; // 回転だけでパドル角度を反映
+	Matrix4x4 coreMatWorld_{};
+	Material* ringMaterial_ = nullptr;   // circle モデルのマテリアルを借用
+	Material* paddleMaterial_ = nullptr; // paddle モデルのマテリアルを借用
+
+	// 再生成判定用
+	bool ringMeshDirty_ = true;
+	float paddleMeshHalfWidth_ = -1.0f;
+	float paddleMeshRingR_ = -1.0f;
+	bool paddleMeshDouble_ = false;
+	std::vector<GpuMesh::Vertex> meshVertices_; // 生成用の作業領域
+	std::vector<uint32_t> meshIndices_;
 
 	struct Paddle {
 		float angle = 0.0f;
@@ -73,6 +102,7 @@ private:
 
 	// 連続反射コンボ
 	int paddleCombo_ = 0;
+	int maxCombo_ = 0; // このプレイでの最大
 	float comboTimer_ = 0.0f;
 	float comboTimeout_ = 3.0f;
 	float scoreMul_ = 1.0f;
@@ -92,18 +122,12 @@ private:
 		Vector3 pos{};
 		Vector3 vel{};
 		float radius = 0.0f; // 当たり半径（見た目から算出）
-		std::unique_ptr<WorldTransform> wt;
+		Matrix4x4 matWorld{}; // 描画用（定数バッファは描画時にフレーム領域へ書く）
 
 		// ★ホーミング用（固定砲台の弾だけ true）
 		bool homing = false;                      // ホーミングするか
 		float speed = 0.0f;                       // m/s（一定）
 		float homingTurnRate = ToRadians(540.0f); // 旋回角速度（rad/s）
-
-		Shot() = default;
-		Shot(const Shot&) = delete;
-		Shot& operator=(const Shot&) = delete;
-		Shot(Shot&&) noexcept = default;
-		Shot& operator=(Shot&&) noexcept = default;
 	};
 	std::vector<Shot> shots_;
 
@@ -112,12 +136,7 @@ private:
 		bool active = false;
 		Vector3 pos{};
 		Vector3 vel{};
-		std::unique_ptr<WorldTransform> wt;
-		Enemy() = default;
-		Enemy(const Enemy&) = delete;
-		Enemy& operator=(const Enemy&) = delete;
-		Enemy(Enemy&&) noexcept = default;
-		Enemy& operator=(Enemy&&) noexcept = default;
+		Matrix4x4 matWorld{}; // 描画用
 	};
 	std::vector<Enemy> enemies_;
 
@@ -141,29 +160,48 @@ private:
 		bool active = false;
 		float interval = 0.6f; // 発射間隔
 		float timer = 0.0f;
-		// 見た目（HUDアイコン）
-		KamataEngine::Sprite* sprite = nullptr;
 	} skillCannon_;
-	uint32_t texSkillCannon_ = 0u;
 
 	// ★60秒の瞬間だけ一度きり生成するためのフラグ
 	bool skillCannonSpawned_ = false;
 
+	// ============ 障害物マップ（Resources/blocks.csv） ============
+	static inline const float kEnemyTileHalf = 0.5f; // 敵がマップに当たる箱の半分の大きさ（見た目と同じ）
+	TileMap tileMap_;
+	bool tileObstacles_ = false; // 弾と敵をマップで止めるか（ImGui で切り替え）
+	float tileSize_ = 2.0f;      // 1マスの大きさ（LoadTileMap で、広がりきったリングの出現円が外周の内側に収まるように決める）
+	Vector3 tileOrigin_{};       // マス (0, 0) の左上の角（マスの y は -z 向き）
+	GpuMesh tileMesh_;           // 埋まりマスを横につないだ板
+	Matrix4x4 tileMatWorld_{};
+	uint32_t tileQueries_ = 0u; // 1フレームの問い合わせ数（ImGui 表示用）
+	uint32_t tileBlocked_ = 0u; // そのうち止めた数
+
+	float ToTileX(float x) const { return (x - tileOrigin_.x) / tileSize_; }
+	float ToTileY(float z) const { return (tileOrigin_.z - z) / tileSize_; }
+
 	// ============ 天球 ============
-	Skydome* skydome_ = nullptr;
+	std::unique_ptr<Skydome> skydome_;
 
 	// ============ 内部処理 ============
 	void UpdateRingAndPaddle(float dt);
+	void RebuildRingMesh();
+	void RebuildPaddleMesh();
 	void SpawnShot();
 	void UpdateShots(float dt);
 	void DrawRingAndPaddle();
 	void DrawShots();
+	size_t CullGathered(); // cullX_～cullR_ に集めた球を判定
 
 	// 敵
 	void SpawnEnemy();
 	void UpdateEnemies(float dt);
 	void DrawEnemies();
 
+	// 障害物マップ
+	void LoadTileMap();
+	bool EnemyHitsTiles(const Vector3& pos) const;
+	void MoveEnemyOnTiles(Enemy& e); // 埋まりマスに入る向きの成分だけ止め、壁沿いに滑らせる
+
 	// 強化・進化の段階適用（スコア等）
 	void ApplyProgression();
 	void RecomputePaddleHalfWidth();
@@ -186,6 +224,8 @@ private:
 
 	// リング基本半径（成長の基点）
 	float ringRBase_ = 8.0f;
+	static inline const float kRingRGrowthMax = 1.5f;  // ApplyProgression で基本半径から広がる最大量
+	static inline const float kEnemySpawnRScale = 2.5f; // 敵の出現円の半径（リング半径の何倍か）
 
 	// ============ 敵出現スケーリング ============
 	float enemySpawnBaseRate_ = 1.0f;          // 初期の毎秒スポーン数
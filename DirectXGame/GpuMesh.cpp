@@ -0,0 +1,91 @@
+#include "GpuMesh.h"
+#include "QuantizedPipeline.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace KamataEngine;
+
+// アップロードヒープにバッファを作ってマップする
+static Microsoft::WRL::ComPtr<ID3D12Resource> CreateUploadBuffer(size_t sizeInBytes, void** mapped) {
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeInBytes);
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+	HRESULT result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer));
+	assert(SUCCEEDED(result));
+
+	result = buffer->Map(0, nullptr, mapped);
+	assert(SUCCEEDED(result));
+	return buffer;
+}
+
+void GpuMesh::Initialize(uint32_t maxVertices, uint32_t maxIndices, DXGI_FORMAT indexFormat, Layout layout) {
+	assert(maxVertices > 0 && maxIndices > 0);
+	assert(indexFormat == DXGI_FORMAT_R32_UINT || indexFormat == DXGI_FORMAT_R16_UINT);
+	maxVertices_ = maxVertices;
+	maxIndices_ = maxIndices;
+	indexCount_ = 0u;
+	layout_ = layout;
+
+	// 頂点バッファ
+	vertexStride_ = layout_ == Layout::kQuantized ? sizeof(VertexQuant::Vertex) : sizeof(Vertex);
+	const UINT sizeVB = static_cast<UINT>(vertexStride_ * maxVertices_);
+	vertBuff_ = CreateUploadBuffer(sizeVB, reinterpret_cast<void**>(&vertMap_));
+	vbView_.BufferLocation = vertBuff_->GetGPUVirtualAddress();
+	vbView_.SizeInBytes = sizeVB;
+	vbView_.StrideInBytes = vertexStride_;
+
+	// インデックスバッファ
+	indexStride_ = indexFormat == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) : sizeof(uint32_t);
+	const UINT sizeIB = static_cast<UINT>(indexStride_ * maxIndices_);
+	indexBuff_ = CreateUploadBuffer(sizeIB, reinterpret_cast<void**>(&indexMap_));
+	ibView_.BufferLocation = indexBuff_->GetGPUVirtualAddress();
+	ibView_.Format = indexFormat;
+	ibView_.SizeInBytes = sizeIB;
+}
+
+void GpuMesh::Upload(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) { Upload(vertices.data(), vertices.size(), indices.data(), indices.size()); }
+
+void GpuMesh::Upload(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+	assert(layout_ == Layout::kFloat && indexStride_ == sizeof(uint32_t));
+	UploadRaw(vertices, vertexCount, indices, indexCount);
+}
+
+void GpuMesh::UploadRaw(const void* vertices, size_t vertexCount, const void* indices, size_t indexCount) {
+	assert(vertexCount <= maxVertices_ && indexCount <= maxIndices_);
+	if (!vertMap_ || !indexMap_)
+		return;
+
+	const size_t vn = (std::min)(vertexCount, static_cast<size_t>(maxVertices_));
+	const size_t in = (std::min)(indexCount, static_cast<size_t>(maxIndices_));
+	std::memcpy(vertMap_, vertices, vn * vertexStride_);
+	std::memcpy(indexMap_, indices, in * indexStride_);
+
+	// 三角形単位に切り詰める
+	indexCount_ = static_cast<uint32_t>(in - in % 3);
+}
+
+void GpuMesh::Draw(const WorldTransform& worldTransform, const Camera& camera, Material* material) const {
+	if (indexCount_ == 0u || !material)
+		return;
+
+	ModelCommon* common = ModelCommon::GetInstance();
+	ID3D12GraphicsCommandList* commandList = common->GetCommandList();
+
+	// 量子化頂点は呼び出し側で QuantizedPipeline に切り替えてある（展開値だけメッシュごとに積む）
+	if (layout_ == Layout::kQuantized)
+		QuantizedPipeline::SetQuantization(commandList, quantization_);
+
+	// Model::Draw と同じ順でルートパラメータを積む
+	common->LightCommand();
+	common->TransformCommand(worldTransform, camera);
+	common->GetObjectColor()->SetGraphicsCommand(commandList, static_cast<UINT>(Model::RoomParameter::kObjectColor));
+
+	commandList->IASetVertexBuffers(0, 1, &vbView_);
+	commandList->IASetIndexBuffer(&ibView_);
+	material->SetGraphicsCommand(commandList, static_cast<UINT>(Model::RoomParameter::kMaterial), static_cast<UINT>(Model::RoomParameter::kTexture));
+	commandList->DrawIndexedInstanced(indexCount_, 1, 0, 0, 0);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "VertexQuant.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 頂点/インデックスを自前で持つメッシュ（Model と同じパイプラインで描画する）
+// ・バッファはアップロードヒープに確保し、常時マップしておく
+// ・Upload で中身だけ差し替えられるので、形状が変わった時だけ書き換えればよい
+// ・頂点は Vertex（32 バイト）か VertexQuant::Vertex（16 バイト。QuantizedPipeline で描く）
+class GpuMesh {
+public:
+	using Vertex = Mesh::VertexPosNormalUv;
+
+	// 頂点の形式
+	enum class Layout {
+		kFloat,     // Vertex
+		kQuantized, // VertexQuant::Vertex（SetQuantization で位置の展開値を渡す）
+	};
+
+	// 最大頂点数・最大インデックス数でバッファを確保（indexFormat は R32_UINT か R16_UINT）
+	void Initialize(uint32_t maxVertices, uint32_t maxIndices, DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT, Layout layout = Layout::kFloat);
+
+	// CPU 側の形状を転送（容量を超えた分は切り捨て）
+	void Upload(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+	void Upload(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount);
+	// Initialize で決めた頂点形式・インデックス形式のまま転送（.mesh の中身をそのまま渡す用）
+	void UploadRaw(const void* vertices, size_t vertexCount, const void* indices, size_t indexCount);
+
+	void SetQuantization(const VertexQuant::Quantization& quantization) { quantization_ = quantization; }
+	const VertexQuant::Quantization& GetQuantization() const { return quantization_; }
+	Layout GetLayout() const { return layout_; }
+
+	// 描画（Model::PreDraw ～ Model::PostDraw の間で呼ぶ）
+	// kQuantized は QuantizedPipeline::Bind ～ Restore の間で呼ぶ（切り替えは呼び出し側でまとめて1回）
+	void Draw(const WorldTransform& worldTransform, const Camera& camera, Material* material) const;
+
+	const D3D12_VERTEX_BUFFER_VIEW& GetVBView() const { return vbView_; }
+	const D3D12_INDEX_BUFFER_VIEW& GetIBView() const { return ibView_; }
+	uint32_t GetIndexCount() const { return indexCount_; }
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertBuff_;
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff_;
+	uint8_t* vertMap_ = nullptr;
+	uint8_t* indexMap_ = nullptr;
+	D3D12_VERTEX_BUFFER_VIEW vbView_{};
+	D3D12_INDEX_BUFFER_VIEW ibView_{};
+
+	uint32_t maxVertices_ = 0u;
+	uint32_t maxIndices_ = 0u;
+	uint32_t vertexStride_ = sizeof(Vertex);
+	uint32_t indexStride_ = sizeof(uint32_t);
+	Layout layout_ = Layout::kFloat;
+	VertexQuant::Quantization quantization_{};
+	uint32_t indexCount_ = 0u;
+};
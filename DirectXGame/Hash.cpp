@@ -0,0 +1,101 @@
+#include "Hash.h"
+#include "FileBytes.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const uint64_t kPrime1 = 11400714785074694791ull;
+const uint64_t kPrime2 = 14029467366897019727ull;
+const uint64_t kPrime3 = 1609587929392839161ull;
+const uint64_t kPrime4 = 9650029242287828579ull;
+const uint64_t kPrime5 = 2870177450012600261ull;
+
+uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+uint64_t Read64(const uint8_t* p) {
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+uint32_t Read32(const uint8_t* p) {
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+uint64_t Round(uint64_t acc, uint64_t input) {
+	acc += input * kPrime2;
+	acc = Rotl(acc, 31);
+	return acc * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t acc, uint64_t val) {
+	acc ^= Round(0, val);
+	return acc * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	const uint8_t* end = p + size;
+	uint64_t h = 0u;
+
+	// 32 バイトずつ4レーンで回す
+	if (size >= 32u) {
+		uint64_t v1 = seed + kPrime1 + kPrime2;
+		uint64_t v2 = seed + kPrime2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - kPrime1;
+		const uint8_t* limit = end - 32;
+		do {
+			v1 = Round(v1, Read64(p));
+			v2 = Round(v2, Read64(p + 8));
+			v3 = Round(v3, Read64(p + 16));
+			v4 = Round(v4, Read64(p + 24));
+			p += 32;
+		} while (p <= limit);
+
+		h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+		h = MergeRound(h, v1);
+		h = MergeRound(h, v2);
+		h = MergeRound(h, v3);
+		h = MergeRound(h, v4);
+	} else {
+		h = seed + kPrime5;
+	}
+	h += static_cast<uint64_t>(size);
+
+	// 残り
+	for (; p + 8 <= end; p += 8) {
+		h ^= Round(0, Read64(p));
+		h = Rotl(h, 27) * kPrime1 + kPrime4;
+	}
+	if (p + 4 <= end) {
+		h ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+		h = Rotl(h, 23) * kPrime2 + kPrime3;
+		p += 4;
+	}
+	for (; p < end; ++p) {
+		h ^= (*p) * kPrime5;
+		h = Rotl(h, 11) * kPrime1;
+	}
+
+	// 仕上げ
+	h ^= h >> 33;
+	h *= kPrime2;
+	h ^= h >> 29;
+	h *= kPrime3;
+	h ^= h >> 32;
+	return h;
+}
+
+bool HashFile(const std::string& path, uint64_t& hash) {
+	std::vector<uint8_t> data;
+	if (!ReadFileBytes(path, data))
+		return false;
+	hash = HashBytes(data.data(), data.size());
+	return true;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 内容ハッシュ（XXH64 互換・64bit）
+// ・アセットの同一判定用。暗号用途には使わない
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0u);
+
+// ファイル全体のハッシュ。読めなければ false
+bool HashFile(const std::string& path, uint64_t& hash);
@@ -1,56 +1,42 @@
 #include "Hud.h"
+#include <cstdio>
 #include <string>
 
-using KamataEngine::Sprite;
-using KamataEngine::TextureManager;
 using KamataEngine::Vector2;
 
-void Hud::Initialize(const std::string& textureFile) {
-	texHandle_ = TextureManager::Load(textureFile);
+void Hud::Initialize() {
+	atlas_.Initialize(UiAtlas::kTextureFile, UiAtlas::kRects, UiAtlas::kCount);
+	batch_.Initialize(kMaxQuads);
 
 	// 表示スケール
 	const float s = kLabelScale;
 
 	// --- Timer (左上) ---
 	posTimer_ = {0.0f, 0.0f};
-	sprTimer_ = Sprite::Create(texHandle_, posTimer_);
-	sprTimer_->SetTextureRect({0.0f, 0.0f}, {136.0f, static_cast<float>(kLabelH)});
-	sprTimer_->SetSize({136.0f * s, static_cast<float>(kLabelH) * s});
-	sprTimer_->SetAnchorPoint({0.0f, 0.0f}); // 左上基準
+	texBaseTimer_ = atlas_.ToAtlas(UiAtlas::kFont, {0.0f, 0.0f});
+	texSizeTimer_ = {136.0f, static_cast<float>(kLabelH)};
 	sizeTimer_ = {136.0f * s, static_cast<float>(kLabelH) * s};
 
 	// --- Life (左下) ---
 	posLife_ = {0.0f, 650.0f};
-	sprLife_ = Sprite::Create(texHandle_, posLife_);
-	sprLife_->SetTextureRect({144.0f, 0.0f}, {84.0f, static_cast<float>(kLabelH)});
-	sprLife_->SetSize({84.0f * s, static_cast<float>(kLabelH) * s});
-	sprLife_->SetAnchorPoint({0.0f, 0.0f});
+	texBaseLife_ = atlas_.ToAtlas(UiAtlas::kFont, {144.0f, 0.0f});
+	texSizeLife_ = {84.0f, static_cast<float>(kLabelH)};
 	sizeLife_ = {84.0f * s, static_cast<float>(kLabelH) * s};
 
 	// --- Score (右上) ---
 	// ※ユーザー提供の値に合わせて 800,0 に配置
 	posScore_ = {800.0f, 0.0f};
-	sprScore_ = Sprite::Create(texHandle_, posScore_);
-	sprScore_->SetTextureRect({288.0f, 0.0f}, {136.0f, static_cast<float>(kLabelH)});
-	sprScore_->SetSize({136.0f * s, static_cast<float>(kLabelH) * s});
-	sprScore_->SetAnchorPoint({0.0f, 0.0f});
+	texBaseScore_ = atlas_.ToAtlas(UiAtlas::kFont, {288.0f, 0.0f});
+	texSizeScore_ = {136.0f, static_cast<float>(kLabelH)};
 	sizeScore_ = {136.0f * s, static_cast<float>(kLabelH) * s};
 
 	// --- Skill (右下) ---
 	posSkill_ = {900.0f, 650.0f};
-	sprSkill_ = Sprite::Create(texHandle_, posSkill_);
-	sprSkill_->SetTextureRect({432.0f, 0.0f}, {100.0f, static_cast<float>(kLabelH)});
-	sprSkill_->SetSize({100.0f * s, static_cast<float>(kLabelH) * s});
-	sprSkill_->SetAnchorPoint({0.0f, 0.0f});
+	texBaseSkill_ = atlas_.ToAtlas(UiAtlas::kFont, {432.0f, 0.0f});
+	texSizeSkill_ = {100.0f, static_cast<float>(kLabelH)};
 	sizeSkill_ = {100.0f * s, static_cast<float>(kLabelH) * s};
 
-	// 事前確保（数字）
-	EnsureDigits(digitsTimer_, 5);
-	EnsureDigits(digitsScore_, 7);
-
 	// ===== Lifeアイコンの準備 =====
-	texLifeIcon_ = TextureManager::Load("Life.png");
-
 	// アイコンサイズは「Lifeラベル高さの 90%」で正方形
 	float iconH = sizeLife_.y * kLifeIconScale;
 	float iconW = iconH;
@@ -60,82 +46,78 @@ void Hud::Initialize(const std::string& textureFile) {
 	float y = posLife_.y + (sizeLife_.y - iconH) * 0.5f;
 	posLifeIconsBase_ = {posLife_.x + sizeLife_.x + kLifeLeftMargin, y};
 
-	// 3つ分のスプライト生成
-	for (auto& sp : sprLifeIcons_) {
-		sp = Sprite::Create(texLifeIcon_, posLifeIconsBase_);
-		sp->SetAnchorPoint({0.0f, 0.0f}); // 左上
-		sp->SetSize(sizeLifeIcon_);
-	}
-}
+	// ===== 数値欄（ラベルの右横・垂直中央） =====
+	HudNumberText::Layout layout{};
+	layout.glyphSize = {static_cast<float>(kDigitW) * kDigitScale, static_cast<float>(kDigitH) * kDigitScale};
+	layout.glyphTexSize = {static_cast<float>(kDigitW), static_cast<float>(kDigitH)};
+	layout.glyphsTexBase = atlas_.ToAtlas(UiAtlas::kFont, {0.0f, static_cast<float>(kDigitsY)});
+	layout.textureSize = {static_cast<float>(UiAtlas::kWidth), static_cast<float>(UiAtlas::kHeight)};
 
-void Hud::EnsureDigits(std::vector<Sprite*>& pool, size_t count) {
-	while (pool.size() < count) {
-		Sprite* sp = Sprite::Create(texHandle_, {0.0f, 0.0f});
-		sp->SetTextureRect({0.0f, static_cast<float>(kDigitsY)}, {static_cast<float>(kDigitW), static_cast<float>(kDigitH)});
-		sp->SetSize({static_cast<float>(kDigitW) * kDigitScale, static_cast<float>(kDigitH) * kDigitScale});
-		sp->SetAnchorPoint({0.0f, 0.0f}); // 左上基準
-		pool.push_back(sp);
-	}
-}
+	layout.origin = {posTimer_.x + sizeTimer_.x + kNumLeftMargin, posTimer_.y + (sizeTimer_.y - layout.glyphSize.y) * 0.5f};
+	timerText_.Initialize(layout);
 
-int Hud::GlyphIndexFromChar(char c) const {
-	if (c >= '0' && c <= '9')
-		return static_cast<int>(c - '0'); // 0-9
-	if (c == 'x' || c == 'X' || c == '*')
-		return 11; // ×
-	if (c == '.')
-		return 10; // 中黒・
-	return 0;      // デフォルト '0'
+	layout.origin = {posScore_.x + sizeScore_.x + kNumLeftMargin, posScore_.y + (sizeScore_.y - layout.glyphSize.y) * 0.5f};
+	scoreText_.Initialize(layout);
 }
 
-void Hud::DrawString(const std::string& text, const Vector2& anchorLeftTop, std::vector<Sprite*>& pool) {
-	EnsureDigits(pool, text.size());
+void Hud::Begin(ID3D12GraphicsCommandList* commandList) { batch_.Begin(commandList); }
+
+void Hud::End() { batch_.End(); }
 
+void Hud::DrawLabel(const Vector2& pos, const Vector2& size, const Vector2& texBase, const Vector2& texSize) { batch_.Draw(atlas_.GetTextureHandle(), pos, size, {1.0f, 1.0f, 1.0f, 1.0f}, texBase, texSize); }
+
+void Hud::DrawString(const std::string& text, const Vector2& anchorLeftTop) {
 	const Vector2 glyphSize = {static_cast<float>(kDigitW) * kDigitScale, static_cast<float>(kDigitH) * kDigitScale};
+	const Vector2 glyphTexSize = {static_cast<float>(kDigitW), static_cast<float>(kDigitH)};
 
 	for (size_t i = 0; i < text.size(); ++i) {
-		int gi = GlyphIndexFromChar(text[i]);
+		int gi = HudGlyphIndexFromChar(text[i]);
 		float tx = static_cast<float>(gi * kDigitW);
 
-		Sprite* sp = pool[i];
 		Vector2 pos = {anchorLeftTop.x + static_cast<float>(i) * glyphSize.x, anchorLeftTop.y};
-		sp->SetPosition(pos);
-		sp->SetTextureRect({tx, static_cast<float>(kDigitsY)}, {static_cast<float>(kDigitW), static_cast<float>(kDigitH)});
-		sp->SetSize(glyphSize);
-		sp->Draw();
+		DrawLabel(pos, glyphSize, atlas_.ToAtlas(UiAtlas::kFont, {tx, static_cast<float>(kDigitsY)}), glyphTexSize);
 	}
 }
 
-void Hud::DrawTimer(int seconds) {
-	if (sprTimer_)
-		sprTimer_->Draw();
+void Hud::DrawNumber(const HudNumberText& text) {
+	const HudNumberText::Glyph* glyphs = text.GetGlyphs();
+	for (size_t i = 0; i < text.GetLength(); ++i)
+		batch_.DrawUV(atlas_.GetTextureHandle(), glyphs[i].pos, text.GetGlyphSize(), glyphs[i].uvMin, glyphs[i].uvMax);
+}
 
-	std::string s = std::to_string(seconds);
+void Hud::DrawNumberString(const std::string& text, const Vector2& pos) { DrawString(text, pos); }
 
-	float numH = static_cast<float>(kDigitH) * kDigitScale;
-	float y = posTimer_.y + (sizeTimer_.y - numH) * 0.5f;
+void Hud::DrawRankingRow(uint64_t rank, int score, const Vector2& pos) {
+	// 「12・3450」（中黒は '.'）
+	char text[32];
+	std::snprintf(text, sizeof(text), "%llu.%d", static_cast<unsigned long long>(rank), score);
+	DrawString(text, pos);
+}
 
-	Vector2 anchor = {posTimer_.x + sizeTimer_.x + kNumLeftMargin, y};
-	DrawString(s, anchor, digitsTimer_);
+void Hud::DrawRankingTop3(const std::array<int, 3>& hs, const Vector2& topLeft) {
+	for (size_t i = 0; i < hs.size(); ++i)
+		DrawRankingRow(i + 1u, hs[i], {topLeft.x, topLeft.y + GetRankingRowHeight() * static_cast<float>(i)});
 }
 
-void Hud::DrawScore(int score) {
-	if (sprScore_)
-		sprScore_->Draw();
+void Hud::DrawIcon(UiAtlas::Id id, const Vector2& pos, const Vector2& size) { DrawLabel(pos, size, atlas_.GetBase(id), atlas_.GetSize(id)); }
 
-	std::string s = std::to_string(score);
+void Hud::DrawTimer(int seconds) {
+	DrawLabel(posTimer_, sizeTimer_, texBaseTimer_, texSizeTimer_);
 
-	float numH = static_cast<float>(kDigitH) * kDigitScale;
-	float y = posScore_.y + (sizeScore_.y - numH) * 0.5f;
+	timerText_.Set(seconds);
+	DrawNumber(timerText_);
+}
 
-	Vector2 anchor = {posScore_.x + sizeScore_.x + kNumLeftMargin, y};
-	DrawString(s, anchor, digitsScore_);
+void Hud::DrawScore(int score) {
+	DrawLabel(posScore_, sizeScore_, texBaseScore_, texSizeScore_);
+
+	scoreText_.Set(score);
+	DrawNumber(scoreText_);
 }
 
 void Hud::DrawLife(int life) {
 	// ラベル本体
-	if (sprLife_)
-		sprLife_->Draw();
+	DrawLabel(posLife_, sizeLife_, texBaseLife_, texSizeLife_);
 
 	// 表示するアイコン数（0〜3にクランプ）
 	int n = life;
@@ -146,17 +128,9 @@ void Hud::DrawLife(int life) {
 
 	// アイコンを左から n 個だけ描画
 	for (int i = 0; i < n; ++i) {
-		if (!sprLifeIcons_[i])
-			continue;
 		Vector2 pos = {posLifeIconsBase_.x + static_cast<float>(i) * (sizeLifeIcon_.x + kLifeIconSpacing), posLifeIconsBase_.y};
-		sprLifeIcons_[i]->SetPosition(pos);
-		sprLifeIcons_[i]->SetSize(sizeLifeIcon_);
-		sprLifeIcons_[i]->Draw();
+		DrawIcon(UiAtlas::kLife, pos, sizeLifeIcon_);
 	}
 }
 
-void Hud::DrawSkill(int /*skill*/) {
-	if (sprSkill_)
-		sprSkill_->Draw();
-}
-
+void Hud::DrawSkill(int /*skill*/) { DrawLabel(posSkill_, sizeSkill_, texBaseSkill_, texSizeSkill_); }
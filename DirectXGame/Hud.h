@@ -1,12 +1,20 @@
 #pragma once
+#include "HudText.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+#include "UiAtlas.h"
 #include <KamataEngine.h>
 #include <array>
 #include <string>
-#include <vector>
 
 class Hud {
 public:
-	void Initialize(const std::string& textureFile);
+	// UI アトラス（UiAtlas.png）1枚から全部描く
+	void Initialize();
+
+	// HUD 描画の開始・終了（間の Draw* はまとめて発行される）
+	void Begin(ID3D12GraphicsCommandList* commandList);
+	void End();
 
 	void DrawTimer(int seconds);
 	void DrawScore(int score);
@@ -15,20 +23,39 @@ public:
 
 	// ★ 追加：任意位置に数値文字列描画 / ランキング表示
 	void DrawNumberString(const std::string& text, const KamataEngine::Vector2& pos);
+	// 1行に「順位・スコア」を上から3行（topLeft は1行目の左上）
 	void DrawRankingTop3(const std::array<int, 3>& hs, const KamataEngine::Vector2& topLeft);
+	// 順位・スコアの1行
+	void DrawRankingRow(uint64_t rank, int score, const KamataEngine::Vector2& pos);
+	float GetRankingRowHeight() const { return static_cast<float>(kDigitH) * kDigitScale + kRankingRowSpacing; }
+
+	// アトラス内の画像をアイコンとして描く（スキル砲台など）
+	void DrawIcon(UiAtlas::Id id, const KamataEngine::Vector2& pos, const KamataEngine::Vector2& size);
 
 	// 既存
 	const KamataEngine::Vector2& GetSkillLabelPos() const { return posSkill_; }
 	const KamataEngine::Vector2& GetSkillLabelSize() const { return sizeSkill_; }
 	const KamataEngine::Vector2& GetScoreLabelPos() const { return posScore_; }
 	const KamataEngine::Vector2& GetScoreLabelSize() const { return sizeScore_; }
+	const SpriteBatch::Stats& GetBatchStats() const { return batch_.GetStats(); }
 
 private:
-	uint32_t texHandle_ = 0u;
-	KamataEngine::Sprite* sprTimer_ = nullptr;
-	KamataEngine::Sprite* sprScore_ = nullptr;
-	KamataEngine::Sprite* sprLife_ = nullptr;
-	KamataEngine::Sprite* sprSkill_ = nullptr;
+	TextureAtlas atlas_;
+	SpriteBatch batch_;
+
+	// ラベルの切り出し範囲（アトラス上のピクセル）
+	KamataEngine::Vector2 texBaseTimer_{0.0f, 0.0f};
+	KamataEngine::Vector2 texBaseScore_{0.0f, 0.0f};
+	KamataEngine::Vector2 texBaseLife_{0.0f, 0.0f};
+	KamataEngine::Vector2 texBaseSkill_{0.0f, 0.0f};
+	KamataEngine::Vector2 texSizeTimer_{0.0f, 0.0f};
+	KamataEngine::Vector2 texSizeScore_{0.0f, 0.0f};
+	KamataEngine::Vector2 texSizeLife_{0.0f, 0.0f};
+	KamataEngine::Vector2 texSizeSkill_{0.0f, 0.0f};
+
+	// 数値欄（値が変わった桁だけ矩形を作り直す）
+	HudNumberText timerText_;
+	HudNumberText scoreText_;
 
 	KamataEngine::Vector2 posTimer_{0.0f, 0.0f};
 	KamataEngine::Vector2 posScore_{0.0f, 0.0f};
@@ -40,12 +67,6 @@ private:
 	KamataEngine::Vector2 sizeLife_{0.0f, 0.0f};
 	KamataEngine::Vector2 sizeSkill_{0.0f, 0.0f};
 
-	std::vector<KamataEngine::Sprite*> digitsTimer_;
-	std::vector<KamataEngine::Sprite*> digitsScore_;
-
-	// ▼ ランキングや任意文字列描画用の一時プール
-	std::vector<KamataEngine::Sprite*> digitsScratch_; // ★ 追加
-
 	static inline const int kLabelH = 53;
 	static inline const int kDigitsY = 53;
 	static inline const int kDigitW = 48;
@@ -58,14 +79,17 @@ private:
 	static inline const float kNumLeftMargin = 8.0f;
 	static inline const float kLifeLeftMargin = 10.0f;
 
-	uint32_t texLifeIcon_ = 0u;
-	std::array<KamataEngine::Sprite*, 3> sprLifeIcons_{nullptr};
 	KamataEngine::Vector2 posLifeIconsBase_{0.0f, 0.0f};
 	KamataEngine::Vector2 sizeLifeIcon_{0.0f, 0.0f};
 	static inline const float kLifeIconScale = 0.9f;
 	static inline const float kLifeIconSpacing = 6.0f;
 
-	void EnsureDigits(std::vector<KamataEngine::Sprite*>& pool, size_t count);
-	int GlyphIndexFromChar(char c) const;
-	void DrawString(const std::string& text, const KamataEngine::Vector2& anchorLeftTop, std::vector<KamataEngine::Sprite*>& pool);
+	static inline const float kRankingRowSpacing = 6.0f;
+
+	// 1フレームに積む矩形の上限（ラベル4 + 数字 + アイコン）
+	static inline const uint32_t kMaxQuads = 128u;
+
+	void DrawLabel(const KamataEngine::Vector2& pos, const KamataEngine::Vector2& size, const KamataEngine::Vector2& texBase, const KamataEngine::Vector2& texSize);
+	void DrawString(const std::string& text, const KamataEngine::Vector2& anchorLeftTop);
+	void DrawNumber(const HudNumberText& text);
 };
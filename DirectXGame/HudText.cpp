@@ -0,0 +1,107 @@
+#include "HudText.h"
+#include <cstring>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 2桁ずつ変換するための表 "00" "01" … "99"
+struct DigitPairs {
+	char chars[200];
+	DigitPairs() {
+		for (int i = 0; i < 100; ++i) {
+			chars[i * 2] = static_cast<char>('0' + i / 10);
+			chars[i * 2 + 1] = static_cast<char>('0' + i % 10);
+		}
+	}
+};
+const DigitPairs kDigitPairs;
+
+} // namespace
+
+size_t FormatInt(int value, char* out) {
+	// INT_MIN も扱えるよう符号なしで計算する
+	uint32_t u = static_cast<uint32_t>(value);
+	size_t length = 0u;
+	if (value < 0) {
+		out[length++] = '-';
+		u = 0u - u;
+	}
+
+	// 後ろから2桁ずつ埋めて、最後に前へ詰める
+	char tmp[10];
+	size_t pos = sizeof(tmp);
+	while (u >= 100u) {
+		const uint32_t pair = (u % 100u) * 2u;
+		u /= 100u;
+		tmp[--pos] = kDigitPairs.chars[pair + 1];
+		tmp[--pos] = kDigitPairs.chars[pair];
+	}
+	if (u >= 10u) {
+		tmp[--pos] = kDigitPairs.chars[u * 2u + 1];
+		tmp[--pos] = kDigitPairs.chars[u * 2u];
+	} else {
+		tmp[--pos] = static_cast<char>('0' + u);
+	}
+
+	const size_t digits = sizeof(tmp) - pos;
+	std::memcpy(out + length, tmp + pos, digits);
+	return length + digits;
+}
+
+int HudGlyphIndexFromChar(char c) {
+	if (c >= '0' && c <= '9')
+		return static_cast<int>(c - '0'); // 0-9
+	if (c == 'x' || c == 'X' || c == '*')
+		return 11; // ×
+	if (c == '.')
+		return 10; // 中黒・
+	return 0;      // デフォルト '0'
+}
+
+void HudNumberText::Initialize(const Layout& layout) {
+	layout_ = layout;
+	invTextureSize_ = {
+	    layout.textureSize.x > 0.0f ? 1.0f / layout.textureSize.x : 0.0f,
+	    layout.textureSize.y > 0.0f ? 1.0f / layout.textureSize.y : 0.0f,
+	};
+
+	// 位置は桁で決まるので先に並べておく
+	for (size_t i = 0; i < kIntCharsMax; ++i) {
+		glyphs_[i].pos = {layout_.origin.x + static_cast<float>(i) * layout_.glyphSize.x, layout_.origin.y};
+		text_[i] = '\0';
+	}
+	length_ = 0u;
+	valid_ = false;
+}
+
+void HudNumberText::SetGlyphChar(size_t index, char c) {
+	const float tx = layout_.glyphsTexBase.x + static_cast<float>(HudGlyphIndexFromChar(c)) * layout_.glyphTexSize.x;
+	const float ty = layout_.glyphsTexBase.y;
+	Glyph& g = glyphs_[index];
+	g.uvMin = {tx * invTextureSize_.x, ty * invTextureSize_.y};
+	g.uvMax = {(tx + layout_.glyphTexSize.x) * invTextureSize_.x, (ty + layout_.glyphTexSize.y) * invTextureSize_.y};
+	text_[index] = c;
+	rebuiltGlyphs_++;
+}
+
+bool HudNumberText::Set(int value) {
+	if (valid_ && value == value_)
+		return false;
+
+	char text[kIntCharsMax];
+	const size_t length = FormatInt(value, text);
+
+	// 変わった桁だけ作り直す（桁数が伸びた分は text_ が '\0' なので必ず作り直される）
+	for (size_t i = 0; i < length; ++i) {
+		if (text[i] != text_[i])
+			SetGlyphChar(i, text[i]);
+	}
+	for (size_t i = length; i < length_; ++i)
+		text_[i] = '\0';
+
+	length_ = length;
+	value_ = value;
+	valid_ = true;
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <KamataEngine.h>
+#include <cstddef>
+#include <cstdint>
+
+using namespace KamataEngine;
+
+// 整数 → 10進文字列（終端なし）。out は kIntCharsMax 文字以上。書いた文字数を返す
+static const size_t kIntCharsMax = 11; // "-2147483648"
+size_t FormatInt(int value, char* out);
+
+// HUD の数値表示1欄ぶんの文字矩形キャッシュ
+// ・文字位置は Initialize で全桁ぶん並べておき、値が変わったときは変わった桁の UV だけ作り直す
+// ・ヒープを使わない（毎フレーム呼んでも確保なし）
+class HudNumberText {
+public:
+	// 欄の配置とフォントの切り出し方
+	struct Layout {
+		Vector2 origin;        // 1文字目の左上（スクリーン）
+		Vector2 glyphSize;     // 1文字の表示サイズ
+		Vector2 glyphTexSize;  // 1文字の切り出しサイズ（ピクセル）
+		Vector2 glyphsTexBase; // 数字列 '0' の左上（ピクセル）
+		Vector2 textureSize;   // フォントテクスチャのサイズ（ピクセル）
+	};
+
+	// 1文字ぶんの矩形
+	struct Glyph {
+		Vector2 pos;
+		Vector2 uvMin;
+		Vector2 uvMax;
+	};
+
+	void Initialize(const Layout& layout);
+
+	// 値を設定。前回と同じなら何もしない。変わったら true
+	bool Set(int value);
+
+	size_t GetLength() const { return length_; }
+	const Glyph* GetGlyphs() const { return glyphs_; }
+	const Vector2& GetGlyphSize() const { return layout_.glyphSize; }
+
+	// 作り直した文字数の累計（キャッシュの効き具合の確認用）
+	uint32_t GetRebuiltGlyphs() const { return rebuiltGlyphs_; }
+
+private:
+	Layout layout_{};
+	Vector2 invTextureSize_{0.0f, 0.0f};
+	Glyph glyphs_[kIntCharsMax] = {};
+	char text_[kIntCharsMax] = {};
+	size_t length_ = 0u;
+	int value_ = 0;
+	bool valid_ = false;
+	uint32_t rebuiltGlyphs_ = 0u;
+
+	void SetGlyphChar(size_t index, char c);
+};
+
+// Font.png の数字列での文字の並び（0-9, 中黒, ×）
+int HudGlyphIndexFromChar(char c);
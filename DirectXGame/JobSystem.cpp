@@ -0,0 +1,95 @@
+#include "JobSystem.h"
+
+JobSystem* JobSystem::GetInstance() {
+	static JobSystem instance;
+	return &instance;
+}
+
+void JobSystem::Initialize(uint32_t workerCount) {
+	if (!workers_.empty())
+		return;
+
+	if (workerCount == 0u) {
+		const uint32_t cores = std::thread::hardware_concurrency();
+		workerCount = cores > 1u ? cores - 1u : 1u;
+	}
+
+	quit_ = false;
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+		workers_.emplace_back([this] { WorkerMain(); });
+}
+
+void JobSystem::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		quit_ = true;
+	}
+	wake_.notify_all();
+	for (std::thread& worker : workers_)
+		worker.join();
+	workers_.clear();
+
+	// ワーカーなしで積まれたものも含めて実行しきる
+	while (RunOne()) {
+	}
+}
+
+void JobSystem::Submit(Job job, Counter* counter) {
+	if (counter)
+		counter->pending.fetch_add(1u, std::memory_order_relaxed);
+
+	// ワーカーがいなければその場で実行
+	if (workers_.empty()) {
+		Entry entry{std::move(job), counter};
+		Execute(entry);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		queue_.push_back({std::move(job), counter});
+	}
+	wake_.notify_one();
+}
+
+void JobSystem::Wait(const Counter& counter) {
+	while (!IsDone(counter)) {
+		if (!RunOne())
+			std::this_thread::yield();
+	}
+}
+
+bool JobSystem::RunOne() {
+	Entry entry;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (queue_.empty())
+			return false;
+		entry = std::move(queue_.front());
+		queue_.pop_front();
+	}
+	Execute(entry);
+	return true;
+}
+
+void JobSystem::Execute(Entry& entry) {
+	entry.job();
+	if (entry.counter)
+		entry.counter->pending.fetch_sub(1u, std::memory_order_release);
+}
+
+void JobSystem::WorkerMain() {
+	for (;;) {
+		Entry entry;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			wake_.wait(lock, [this] { return quit_ || !queue_.empty(); });
+			if (queue_.empty())
+				return; // quit_
+			entry = std::move(queue_.front());
+			queue_.pop_front();
+		}
+		Execute(entry);
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 少数のワーカースレッドで小さな処理を順に実行するジョブシステム
+// ・ファイル読み込みや CPU だけで済む下処理に使う。D3D12 / Audio などエンジンの呼び出しはメインスレッドで行う
+// ・完了は Counter で待つ（Submit で +1、実行後に -1）
+class JobSystem {
+public:
+	using Job = std::function<void()>;
+
+	// 完了待ち用のカウンタ（ジョブより長く生かしておく）
+	struct Counter {
+		std::atomic<uint32_t> pending{0u};
+	};
+
+	static JobSystem* GetInstance();
+
+	// workerCount が 0 なら論理コア数 - 1（最低1）
+	void Initialize(uint32_t workerCount = 0u);
+
+	// 残っているジョブを実行し終えてからワーカーを止める
+	void Finalize();
+
+	void Submit(Job job, Counter* counter = nullptr);
+
+	bool IsDone(const Counter& counter) const { return counter.pending.load(std::memory_order_acquire) == 0u; }
+
+	// 完了まで待つ（待っている間は呼び出し側もジョブを実行する）
+	void Wait(const Counter& counter);
+
+private:
+	struct Entry {
+		Job job;
+		Counter* counter = nullptr;
+	};
+
+	JobSystem() = default;
+	~JobSystem() { Finalize(); }
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// キューから1つ取り出して実行。空なら false
+	bool RunOne();
+	static void Execute(Entry& entry);
+	void WorkerMain();
+
+	std::vector<std::thread> workers_;
+	std::deque<Entry> queue_;
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	bool quit_ = false;
+};
@@ -0,0 +1,425 @@
+#include "Leaderboard.h"
+#include "FileBytes.h"
+#include "Hash.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+namespace fs = std::filesystem;
+
+const char kMagic[4] = {'L', 'B', 'R', 'D'};
+const uint32_t kVersion = 1u;
+
+// ファイルの先頭
+struct FileHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t snapshotRuns;
+	uint32_t reserved;
+	uint64_t snapshotHash; // スナップショット全体
+	uint64_t headerHash;   // ここより前
+};
+
+// 日誌の1件。check は Run と通し番号から作る（古いレコードやゴミを読んでも通らない）
+struct JournalRecord {
+	Leaderboard::Run run;
+	uint64_t check;
+};
+
+static_assert(sizeof(Leaderboard::Run) == 24u, "Run はファイルにそのまま書く");
+static_assert(sizeof(FileHeader) == 32u && sizeof(JournalRecord) == 32u, "ファイルの並び");
+
+uint64_t RecordCheck(const Leaderboard::Run& run, uint64_t number) { return HashBytes(&run, sizeof(run), number); }
+
+// OS のキャッシュからディスクまで書き出す
+bool FlushToDisk(FILE* fp) {
+	if (std::fflush(fp) != 0)
+		return false;
+#ifdef _WIN32
+	return _commit(_fileno(fp)) == 0;
+#else
+	return fsync(fileno(fp)) == 0;
+#endif
+}
+
+} // namespace
+
+Leaderboard* Leaderboard::GetInstance() {
+	static Leaderboard instance;
+	return &instance;
+}
+
+bool Leaderboard::Open(const std::string& path, const std::string& legacyPath) {
+	Close();
+	path_ = path;
+	stats_ = {};
+
+	// 作り直すのは本当にないときだけ（使用中や権限で読めないだけなら、取り込みで上書きしないよう失敗にする）
+	std::error_code existsError;
+	const bool exists = fs::exists(path, existsError);
+	if (existsError)
+		return false;
+	std::vector<uint8_t> bytes;
+	if (exists) {
+		if (!ReadFileBytes(path, bytes))
+			return false;
+		size_t validSize = 0u;
+		if (!Parse(bytes, validSize)) {
+			std::error_code ec;
+			fs::rename(path, path + ".bad", ec);
+			runs_.clear();
+			snapshotRuns_ = 0u;
+			stats_ = {};
+			Build();
+			if (ec)
+				return false; // 退避できなければ、壊れたファイルが唯一の写しなので上書きしない
+			return Compact();
+		}
+		if (validSize < bytes.size()) {
+			// 追記の途中で落ちた末尾を捨てる
+			stats_.truncatedBytes = static_cast<uint32_t>(bytes.size() - validSize);
+			std::error_code ec;
+			fs::resize_file(path, validSize, ec);
+			if (ec) {
+				// 切り詰められないまま追記すると壊れた末尾の後ろに書いてしまうので、末尾抜きで書き直す
+				if (Compact())
+					return true;
+				if (journal_) {
+					std::fclose(journal_);
+					journal_ = nullptr;
+				}
+				return false;
+			}
+		}
+		if (!OpenJournal())
+			return false;
+		if (NeedsCompaction())
+			return Compact();
+		return true;
+	}
+
+	// 新しく作る：前の形式のスコアがあれば記録として取り込む
+	runs_.clear();
+	snapshotRuns_ = 0u;
+	if (!legacyPath.empty()) {
+		std::ifstream legacy(legacyPath);
+		int32_t score = 0;
+		while (legacy >> score) {
+			Run run;
+			run.score = score;
+			runs_.push_back(run);
+		}
+	}
+	// 並べ直してから書くので、ここでは記録順のまま木を作る
+	std::vector<Run> legacyRuns;
+	legacyRuns.swap(runs_);
+	nodes_.clear();
+	root_ = kNil;
+	for (const Run& run : legacyRuns)
+		Append(run);
+	return Compact();
+}
+
+void Leaderboard::Close() {
+	if (journal_ && NeedsCompaction())
+		Compact();
+	if (journal_) {
+		std::fclose(journal_);
+		journal_ = nullptr;
+	}
+	runs_.clear();
+	nodes_.clear();
+	root_ = kNil;
+	snapshotRuns_ = 0u;
+}
+
+bool Leaderboard::Parse(const std::vector<uint8_t>& bytes, size_t& validSize) {
+	FileHeader header;
+	if (bytes.size() < sizeof(header))
+		return false;
+	std::memcpy(&header, bytes.data(), sizeof(header));
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion || header.headerHash != HashBytes(&header, offsetof(FileHeader, headerHash)))
+		return false;
+	const size_t snapshotBytes = size_t(header.snapshotRuns) * sizeof(Run);
+	if (bytes.size() - sizeof(header) < snapshotBytes || header.snapshotHash != HashBytes(bytes.data() + sizeof(header), snapshotBytes))
+		return false;
+
+	runs_.resize(header.snapshotRuns);
+	if (snapshotBytes)
+		std::memcpy(runs_.data(), bytes.data() + sizeof(header), snapshotBytes);
+	snapshotRuns_ = header.snapshotRuns;
+	stats_.snapshotRuns = header.snapshotRuns;
+	Build();
+
+	// 日誌はハッシュが合わなくなったところまで
+	size_t offset = sizeof(header) + snapshotBytes;
+	JournalRecord record;
+	while (bytes.size() - offset >= sizeof(record)) {
+		std::memcpy(&record, bytes.data() + offset, sizeof(record));
+		if (record.check != RecordCheck(record.run, runs_.size()))
+			break;
+		Append(record.run);
+		stats_.journalRuns++;
+		offset += sizeof(record);
+	}
+	validSize = offset;
+	return true;
+}
+
+bool Leaderboard::OpenJournal() {
+	journal_ = std::fopen(path_.c_str(), "ab");
+	return journal_ != nullptr;
+}
+
+bool Leaderboard::Add(const Run& run) {
+	if (!journal_)
+		return false;
+	// 書けなかったときに戻す長さ（追記モードは書く直前に末尾へ移るので、ここで末尾を調べておく）
+	if (std::fseek(journal_, 0, SEEK_END) != 0)
+		return false;
+	const long end = std::ftell(journal_);
+	if (end < 0)
+		return false;
+
+	JournalRecord record;
+	record.run = run;
+	record.check = RecordCheck(run, runs_.size());
+	if (std::fwrite(&record, sizeof(record), 1, journal_) != 1u || !FlushToDisk(journal_)) {
+		// 書きかけを残したまま次を追記すると、開き直したときにそこから後ろが読めなくなるので元の長さに戻す
+		// （閉じてから切り詰める。バッファに残った分が後から書かれないように）
+		std::fclose(journal_);
+		journal_ = nullptr;
+		std::error_code ec;
+		fs::resize_file(path_, static_cast<uintmax_t>(end), ec);
+		if (!ec && OpenJournal())
+			return false;
+		// 戻せなければ今の表（このプレイ抜き）で書き直す。それもできなければ追記をやめる
+		if (!Compact() && journal_) {
+			std::fclose(journal_);
+			journal_ = nullptr;
+		}
+		return false;
+	}
+
+	Append(run);
+	stats_.journalRuns++;
+	return true;
+}
+
+bool Leaderboard::Compact() {
+	if (path_.empty())
+		return false;
+
+	// 順位順に並べ直したものを別名に書く
+	std::vector<uint32_t> order;
+	CollectInOrder(runs_.size(), order);
+	std::vector<Run> sorted(order.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		sorted[i] = runs_[order[i]];
+
+	FileHeader header{};
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.snapshotRuns = static_cast<uint32_t>(sorted.size());
+	header.snapshotHash = HashBytes(sorted.data(), sorted.size() * sizeof(Run));
+	header.headerHash = HashBytes(&header, offsetof(FileHeader, headerHash));
+
+	const std::string temp = path_ + ".tmp";
+	FILE* fp = std::fopen(temp.c_str(), "wb");
+	if (!fp)
+		return false;
+	bool ok = std::fwrite(&header, sizeof(header), 1, fp) == 1u;
+	if (ok && !sorted.empty())
+		ok = std::fwrite(sorted.data(), sizeof(Run), sorted.size(), fp) == sorted.size();
+	ok = FlushToDisk(fp) && ok;
+	ok = std::fclose(fp) == 0 && ok;
+
+	// 追記用に開いているままだと置き換えられない
+	if (journal_) {
+		std::fclose(journal_);
+		journal_ = nullptr;
+	}
+	std::error_code ec;
+	if (ok)
+		fs::rename(temp, path_, ec);
+	if (!ok || ec) {
+		fs::remove(temp, ec);
+		OpenJournal();
+		return false;
+	}
+
+	runs_ = std::move(sorted);
+	snapshotRuns_ = static_cast<uint32_t>(runs_.size());
+	stats_.snapshotRuns = snapshotRuns_;
+	stats_.journalRuns = 0u;
+	stats_.compactions++;
+	Build();
+	return OpenJournal();
+}
+
+size_t Leaderboard::GetTop(size_t count, Run* out) const {
+	std::vector<uint32_t> order;
+	CollectInOrder(count, order);
+	for (size_t i = 0; i < order.size(); ++i)
+		out[i] = runs_[order[i]];
+	return order.size();
+}
+
+const Leaderboard::Run& Leaderboard::GetByRank(uint64_t rank) const {
+	// 左の部分木の大きさで降りる
+	uint64_t k = rank - 1u;
+	uint32_t node = root_;
+	while (true) {
+		const uint32_t left = Size(nodes_[node].left);
+		if (k < left) {
+			node = nodes_[node].left;
+		} else if (k == left) {
+			return runs_[node];
+		} else {
+			k -= left + 1u;
+			node = nodes_[node].right;
+		}
+	}
+}
+
+uint64_t Leaderboard::GetRank(int32_t score) const { return CountAbove(score, false) + 1u; }
+
+double Leaderboard::GetPercentile(int32_t score) const {
+	if (runs_.empty())
+		return 100.0;
+	const uint64_t above = CountAbove(score, false);
+	const uint64_t atLeast = CountAbove(score, true);
+	const uint64_t below = runs_.size() - atLeast;
+	return 100.0 * (double(below) + 0.5 * double(atLeast - above)) / double(runs_.size());
+}
+
+uint32_t Leaderboard::Priority(uint32_t node) {
+	// 番号をよく混ぜる（murmur3 の仕上げ）。並び順と無関係な値なら treap の深さは期待値で O(log n)
+	uint32_t h = node * 0x9E3779B1u;
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35u;
+	h ^= h >> 16;
+	return h;
+}
+
+void Leaderboard::Append(const Run& run) {
+	runs_.push_back(run);
+	nodes_.emplace_back();
+	nodes_.back().score = run.score;
+	Insert(static_cast<uint32_t>(runs_.size() - 1u));
+}
+
+void Leaderboard::Build() {
+	// 並び順に右の背骨を積みながら、優先度が大きいものほど上になるよう付け替える（Cartesian tree）
+	const uint32_t count = static_cast<uint32_t>(runs_.size());
+	nodes_.assign(count, Node{});
+	std::vector<uint32_t> spine;
+	for (uint32_t i = 0; i < count; ++i) {
+		nodes_[i].score = runs_[i].score;
+		const uint32_t priority = Priority(i);
+		uint32_t last = kNil;
+		while (!spine.empty() && Priority(spine.back()) < priority) {
+			last = spine.back();
+			spine.pop_back();
+		}
+		nodes_[i].left = last;
+		if (!spine.empty())
+			nodes_[spine.back()].right = i;
+		spine.push_back(i);
+	}
+	root_ = spine.empty() ? kNil : spine.front();
+
+	// 部分木の大きさ：子は親より後に積まれるとは限らないので、帰りがけ順で数える
+	std::vector<std::pair<uint32_t, bool>> stack;
+	if (root_ != kNil)
+		stack.push_back({root_, false});
+	while (!stack.empty()) {
+		auto [node, visited] = stack.back();
+		stack.pop_back();
+		Node& n = nodes_[node];
+		if (visited) {
+			n.size = 1u + Size(n.left) + Size(n.right);
+			continue;
+		}
+		stack.push_back({node, true});
+		if (n.left != kNil)
+			stack.push_back({n.left, false});
+		if (n.right != kNil)
+			stack.push_back({n.right, false});
+	}
+}
+
+void Leaderboard::Insert(uint32_t index) {
+	// 優先度が自分より大きいところまで降り、その下の部分木を自分で分ける
+	const uint32_t priority = Priority(index);
+	uint32_t* link = &root_;
+	while (*link != kNil && Priority(*link) > priority) {
+		Node& n = nodes_[*link];
+		n.size++;
+		link = Before(index, *link) ? &n.left : &n.right;
+	}
+	Node& x = nodes_[index];
+	Split(*link, index, x.left, x.right);
+	x.size = 1u + Size(x.left) + Size(x.right);
+	*link = index;
+}
+
+void Leaderboard::Split(uint32_t node, uint32_t key, uint32_t& left, uint32_t& right) {
+	if (node == kNil) {
+		left = right = kNil;
+		return;
+	}
+	Node& n = nodes_[node];
+	if (Before(node, key)) {
+		Split(n.right, key, n.right, right);
+		left = node;
+	} else {
+		Split(n.left, key, left, n.left);
+		right = node;
+	}
+	n.size = 1u + Size(n.left) + Size(n.right);
+}
+
+void Leaderboard::CollectInOrder(size_t count, std::vector<uint32_t>& out) const {
+	out.clear();
+	out.reserve(std::min<size_t>(count, runs_.size()));
+	std::vector<uint32_t> stack;
+	uint32_t node = root_;
+	while (out.size() < count && (node != kNil || !stack.empty())) {
+		while (node != kNil) {
+			stack.push_back(node);
+			node = nodes_[node].left;
+		}
+		node = stack.back();
+		stack.pop_back();
+		out.push_back(node);
+		node = nodes_[node].right;
+	}
+}
+
+uint64_t Leaderboard::CountAbove(int32_t score, bool orEqual) const {
+	uint64_t count = 0u;
+	uint32_t node = root_;
+	while (node != kNil) {
+		const int32_t s = nodes_[node].score;
+		if (s > score || (orEqual && s == score)) {
+			count += Size(nodes_[node].left) + 1u;
+			node = nodes_[node].right;
+		} else {
+			node = nodes_[node].left;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ローカルのハイスコア表（全プレイを残す）
+// ・ファイルは「順位順のスナップショット + 追記だけの日誌」。1プレイごとに日誌へ 32 バイト追記し、ディスクまで書き出してから戻る
+//   書き込み中に落ちて壊れた末尾はレコードごとのハッシュで見分け、次に開いたときに切り詰める
+// ・日誌が長くなったら（開く・閉じるとき）全体をスナップショットに書き直す。別名に書いてから置き換えるので、途中で落ちても元のファイルが残る
+// ・メモリ上は部分木の大きさを持つ treap（順位順の二分探索木）で、上位 N 件・順位・パーセンタイルを O(log n) で引く
+//   並びはスコアの高い順、同点は先に記録したほうが上
+class Leaderboard {
+public:
+	// 1プレイぶん（ファイルにもこのまま書く）
+	struct Run {
+		int32_t score = 0;
+		uint32_t playSeconds = 0u;
+		uint32_t maxCombo = 0u;
+		uint32_t seed = 0u;     // ゲームの乱数の種（0 = 不明）
+		uint64_t replayId = 0u; // リプレイの ID（0 = なし）
+	};
+
+	struct Stats {
+		uint32_t snapshotRuns = 0u;   // スナップショットから読んだ件数
+		uint32_t journalRuns = 0u;    // 日誌にある件数
+		uint32_t truncatedBytes = 0u; // 開いたときに切り詰めた壊れた末尾
+		uint32_t compactions = 0u;
+	};
+
+	// 日誌がこの件数以上、かつスナップショットの半分以上になったら書き直す
+	static const uint32_t kCompactMinJournal = 1024u;
+
+	static Leaderboard* GetInstance();
+
+	// path を開く（なければ作る）。作るときに legacyPath（"260 160 60" のような空白区切りのスコア）があれば取り込む
+	// ヘッダかスナップショットが壊れていたら path.bad に退避して空から始める
+	// path があるのに読めない（ほかのプロセスが使用中・権限がない）ときは何も書かずに false
+	bool Open(const std::string& path, const std::string& legacyPath = {});
+	// 必要なら書き直してから閉じる
+	void Close();
+
+	// 日誌に追記してから表に加える。書けなければ false（表にも加えない。書きかけは切り詰め、できなければ書き直すか追記をやめる）
+	bool Add(const Run& run);
+	// 今の全件を順位順のスナップショットに書き直し、日誌を空にする
+	bool Compact();
+
+	uint64_t GetCount() const { return runs_.size(); }
+	// 上位 count 件を out に書く。書いた件数を返す
+	size_t GetTop(size_t count, Run* out) const;
+	// rank 位（1 始まり、GetCount 以下）のプレイ
+	const Run& GetByRank(uint64_t rank) const;
+	// score を取ったら何位か（1 + score より高いプレイの数。同点は同じ順位）
+	uint64_t GetRank(int32_t score) const;
+	// score より低いプレイの割合（同点は半分として数える）を 0 ～ 100 で。空なら 100
+	double GetPercentile(int32_t score) const;
+
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	static const uint32_t kNil = 0xFFFFFFFFu;
+
+	// treap の節点。番号は runs_ の番号と同じ。降りるときに runs_ を見なくて済むようスコアも持つ（16 バイト）
+	// 優先度は番号のハッシュ（持たない）
+	struct Node {
+		uint32_t left = kNil;
+		uint32_t right = kNil;
+		uint32_t size = 1u; // 部分木の件数
+		int32_t score = 0;
+	};
+
+	Leaderboard() = default;
+	Leaderboard(const Leaderboard&) = delete;
+	Leaderboard& operator=(const Leaderboard&) = delete;
+
+	bool Parse(const std::vector<uint8_t>& bytes, size_t& validSize);
+	bool OpenJournal();
+	bool NeedsCompaction() const { return stats_.journalRuns >= kCompactMinJournal && stats_.journalRuns * 2u >= snapshotRuns_; }
+
+	// a が b より上か
+	bool Before(uint32_t a, uint32_t b) const { return nodes_[a].score != nodes_[b].score ? nodes_[a].score > nodes_[b].score : a < b; }
+	uint32_t Size(uint32_t node) const { return node == kNil ? 0u : nodes_[node].size; }
+	static uint32_t Priority(uint32_t node);
+	// runs_ の末尾に加えたものを木に入れる
+	void Append(const Run& run);
+	// runs_ が順位順に並んでいるときに木を O(n) で作る
+	void Build();
+	void Insert(uint32_t index);
+	// node の部分木を key より上（left）とそれ以外（right）に分ける
+	void Split(uint32_t node, uint32_t key, uint32_t& left, uint32_t& right);
+	// 上から順に番号を書く
+	void CollectInOrder(size_t count, std::vector<uint32_t>& out) const;
+	// score より高い（orEqual なら以上の）プレイの数
+	uint64_t CountAbove(int32_t score, bool orEqual) const;
+
+	std::string path_;
+	FILE* journal_ = nullptr;
+	std::vector<Run> runs_; // 記録順（Compact で順位順に並べ直す）
+	std::vector<Node> nodes_;
+	uint32_t root_ = kNil;
+	uint32_t snapshotRuns_ = 0u; // runs_ の先頭から何件がスナップショットか（日誌のハッシュの番号はここから続く）
+	Stats stats_;
+};
@@ -0,0 +1,127 @@
+#include "Lz.h"
+#include <cstring>
+
+namespace Lz {
+
+namespace {
+
+const size_t kMinMatch = 4u;
+const size_t kMaxOffset = 65535u;
+const int kHashBits = 16;
+
+uint32_t Read32(const uint8_t* p) {
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+uint32_t HashOf(uint32_t v) { return (v * 2654435761u) >> (32 - kHashBits); }
+
+// 15 以上の長さの続きを書く
+void WriteLength(size_t length, std::vector<uint8_t>& out) {
+	for (; length >= 255u; length -= 255u)
+		out.push_back(255u);
+	out.push_back(static_cast<uint8_t>(length));
+}
+
+void WriteSequence(const uint8_t* literals, size_t literalLength, size_t matchLength, size_t offset, std::vector<uint8_t>& out) {
+	const size_t ml = matchLength ? matchLength - kMinMatch : 0u;
+	out.push_back(static_cast<uint8_t>(((literalLength < 15u ? literalLength : 15u) << 4) | (ml < 15u ? ml : 15u)));
+	if (literalLength >= 15u)
+		WriteLength(literalLength - 15u, out);
+	out.insert(out.end(), literals, literals + literalLength);
+	if (!matchLength)
+		return;
+	out.push_back(static_cast<uint8_t>(offset & 0xFFu));
+	out.push_back(static_cast<uint8_t>(offset >> 8));
+	if (ml >= 15u)
+		WriteLength(ml - 15u, out);
+}
+
+// 続きの長さを読む
+bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+	uint8_t b;
+	do {
+		if (ip >= end)
+			return false;
+		b = *ip++;
+		length += b;
+	} while (b == 255u);
+	return true;
+}
+
+} // namespace
+
+size_t Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+	const size_t start = out.size();
+	std::vector<uint32_t> table(size_t(1) << kHashBits, 0xFFFFFFFFu);
+
+	size_t anchor = 0u; // まだ書いていないリテラルの先頭
+	size_t pos = 0u;
+	while (size >= kMinMatch && pos + kMinMatch <= size) {
+		const uint32_t h = HashOf(Read32(src + pos));
+		const uint32_t candidate = table[h];
+		table[h] = static_cast<uint32_t>(pos);
+
+		if (candidate == 0xFFFFFFFFu || pos - candidate > kMaxOffset || Read32(src + candidate) != Read32(src + pos)) {
+			++pos;
+			continue;
+		}
+
+		size_t length = kMinMatch;
+		while (pos + length < size && src[candidate + length] == src[pos + length])
+			++length;
+
+		WriteSequence(src + anchor, pos - anchor, length, pos - candidate, out);
+		pos += length;
+		anchor = pos;
+	}
+
+	// 残りはリテラルだけの並び
+	WriteSequence(src + anchor, size - anchor, 0u, 0u, out);
+	return out.size() - start;
+}
+
+bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dstSize) {
+	const uint8_t* ip = src;
+	const uint8_t* const end = src + size;
+	size_t op = 0u;
+
+	while (ip < end) {
+		const uint8_t token = *ip++;
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15u && !ReadLength(ip, end, literalLength))
+			return false;
+		if (literalLength > static_cast<size_t>(end - ip) || literalLength > dstSize - op)
+			return false;
+		if (literalLength)
+			std::memcpy(dst + op, ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		// 最後の並び
+		if (ip == end)
+			break;
+
+		if (end - ip < 2)
+			return false;
+		const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+		ip += 2;
+		size_t matchLength = token & 0x0Fu;
+		if (matchLength == 15u && !ReadLength(ip, end, matchLength))
+			return false;
+		matchLength += kMinMatch;
+		if (offset == 0u || offset > op || matchLength > dstSize - op)
+			return false;
+
+		// 重なりうるので1バイトずつ
+		const uint8_t* from = dst + op - offset;
+		for (size_t i = 0; i < matchLength; ++i)
+			dst[op + i] = from[i];
+		op += matchLength;
+	}
+	return op == dstSize;
+}
+
+} // namespace Lz
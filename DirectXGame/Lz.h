@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// アセットパック用の小さな LZ77 圧縮（LZ4 と同系統のバイト単位の形式）
+// ・[トークン][リテラル長の続き][リテラル][オフセット 2byte][一致長の続き] の繰り返し。最後の並びはリテラルだけ
+// ・トークン上位4bit = リテラル長、下位4bit = 一致長 - 4（15 なら 255 が続く限り足す）
+// ・展開は出力先を事前に確保して書くだけなので、展開後サイズは別に持っておく
+namespace Lz {
+
+// 圧縮して out に追記し、書いたバイト数を返す
+size_t Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+// dst へちょうど dstSize バイト展開できたら true（壊れたデータでも範囲外は触らない）
+bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dstSize);
+
+} // namespace Lz
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 読み取り専用のメモリマップドファイル
+// ・Open に成功している間だけ GetData() が有効。破棄で自動的に閉じる
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile() { Close(); }
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const { return data_ != nullptr; }
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+
+private:
+	void* file_ = nullptr;    // HANDLE（Windows のみ）
+	void* mapping_ = nullptr; // HANDLE（Windows のみ）
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0u;
+};
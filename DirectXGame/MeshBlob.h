@@ -0,0 +1,111 @@
+#pragma once
+#include "VertexQuant.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 事前変換済みメッシュ（.mesh）のファイル形式
+// ・Tools/MeshBaker が OBJ/MTL から作り、実行時はメモリマップしてそのまま GPU へ転送する
+// ・リトルエンディアン。各ブロックは 16 バイト境界から始まる
+//   [Header][Part × partCount][Material × materialCount][Vertex × vertexCount][index × indexCount]
+// ・インデックスは Part ごとに vertexStart からの相対値。uint32（kFlagIndex16 なら uint16）
+// ・頂点は Vertex（kFlagQuantized なら VertexQuant::Vertex。位置の展開値は Header に入る）
+// ・MeshBaker が頂点の統合・キャッシュ順への並べ替えを済ませている
+namespace MeshBlob {
+
+const uint32_t kMagic = 0x48534D4Bu; // "KMSH"
+const uint32_t kVersion = 3u;
+const size_t kAlignment = 16u;
+
+// フラグ
+const uint32_t kFlagSmoothed = 1u << 0;  // 法線を平滑化済み
+const uint32_t kFlagIndex16 = 1u << 1;   // インデックスが uint16（どの Part も頂点数が 65536 以下）
+const uint32_t kFlagQuantized = 1u << 2; // 頂点が VertexQuant::Vertex
+
+struct Header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t fileSize;
+	uint32_t flags;
+	uint32_t partCount;
+	uint32_t materialCount;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t partsOffset;
+	uint32_t materialsOffset;
+	uint32_t verticesOffset;
+	uint32_t indicesOffset;
+	float quantOffset[3]; // kFlagQuantized のときの VertexQuant::Quantization
+	float quantScale[3];
+	uint32_t reserved[2];
+};
+
+// 1マテリアルぶんの描画範囲（Model の Mesh 1個に相当）
+struct Part {
+	uint32_t vertexStart;
+	uint32_t vertexCount;
+	uint32_t indexStart;
+	uint32_t indexCount;
+	uint32_t materialIndex;
+	uint32_t reserved[3];
+};
+
+// MTL の内容（文字列は UTF-8・終端あり）
+struct Material {
+	char name[64];
+	char textureFilename[64];
+	float ambient[3];
+	float diffuse[3];
+	float specular[3];
+	float alpha;
+};
+
+// Mesh::VertexPosNormalUv と同じ並び
+struct Vertex {
+	float pos[3];
+	float normal[3];
+	float uv[2];
+};
+
+static_assert(sizeof(Header) == 80, "MeshBlob::Header layout");
+static_assert(sizeof(Part) == 32, "MeshBlob::Part layout");
+static_assert(sizeof(Material) == 168, "MeshBlob::Material layout");
+static_assert(sizeof(Vertex) == 32, "MeshBlob::Vertex layout");
+
+inline size_t AlignUp(size_t value) { return (value + kAlignment - 1u) & ~(kAlignment - 1u); }
+
+inline size_t IndexStride(const Header& h) { return (h.flags & kFlagIndex16) ? sizeof(uint16_t) : sizeof(uint32_t); }
+inline size_t VertexStride(const Header& h) { return (h.flags & kFlagQuantized) ? sizeof(VertexQuant::Vertex) : sizeof(Vertex); }
+
+// ブロックが範囲内に収まっているか
+inline bool BlockFits(uint32_t offset, uint32_t count, size_t stride, size_t size) {
+	if (offset % kAlignment != 0u || offset > size)
+		return false;
+	return static_cast<uint64_t>(count) * stride <= size - offset;
+}
+
+// 先頭を検証してヘッダを返す（壊れていれば nullptr）
+inline const Header* Validate(const void* data, size_t size) {
+	if (!data || size < sizeof(Header))
+		return nullptr;
+	const Header* h = static_cast<const Header*>(data);
+	if (h->magic != kMagic || h->version != kVersion || h->fileSize != size)
+		return nullptr;
+	if (!BlockFits(h->partsOffset, h->partCount, sizeof(Part), size) || !BlockFits(h->materialsOffset, h->materialCount, sizeof(Material), size) ||
+	    !BlockFits(h->verticesOffset, h->vertexCount, VertexStride(*h), size) || !BlockFits(h->indicesOffset, h->indexCount, IndexStride(*h), size))
+		return nullptr;
+
+	// Part が頂点・インデックス・マテリアルの範囲外を指していないか
+	const Part* parts = reinterpret_cast<const Part*>(static_cast<const uint8_t*>(data) + h->partsOffset);
+	for (uint32_t i = 0; i < h->partCount; ++i) {
+		const Part& p = parts[i];
+		if (p.materialIndex >= h->materialCount || p.vertexStart > h->vertexCount || p.vertexCount > h->vertexCount - p.vertexStart || p.indexStart > h->indexCount ||
+		    p.indexCount > h->indexCount - p.indexStart)
+			return nullptr;
+	}
+	return h;
+}
+
+template<class T> inline const T* At(const void* data, uint32_t offset) { return reinterpret_cast<const T*>(static_cast<const uint8_t*>(data) + offset); }
+
+} // namespace MeshBlob
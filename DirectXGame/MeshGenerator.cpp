@@ -0,0 +1,55 @@
+#include "MeshGenerator.h"
+#include <cmath>
+
+using namespace KamataEngine;
+
+// 角度 a0 → a1 の帯を segments 分割で追加（u は a0→a1 で 0→uMax、v は内→外で 0→1）
+static void AppendBand(std::vector<GpuMesh::Vertex>& vertices, std::vector<uint32_t>& indices, float a0, float a1, float innerR, float outerR, int segments, float y, float uMax) {
+	if (segments < 1)
+		segments = 1;
+
+	const uint32_t base = static_cast<uint32_t>(vertices.size());
+	for (int i = 0; i <= segments; ++i) {
+		float t = static_cast<float>(i) / static_cast<float>(segments);
+		float a = a0 + (a1 - a0) * t;
+		float c = std::cos(a);
+		float s = std::sin(a);
+		vertices.push_back({{innerR * c, y, innerR * s}, {0.0f, 1.0f, 0.0f}, {t * uMax, 0.0f}});
+		vertices.push_back({{outerR * c, y, outerR * s}, {0.0f, 1.0f, 0.0f}, {t * uMax, 1.0f}});
+	}
+
+	// 真上から見て時計回り（角度が減る向き）を表とする
+	for (int i = 0; i < segments; ++i) {
+		uint32_t in0 = base + static_cast<uint32_t>(i) * 2u;
+		uint32_t out0 = in0 + 1u;
+		uint32_t in1 = in0 + 2u;
+		uint32_t out1 = in0 + 3u;
+		indices.insert(indices.end(), {in0, in1, out0});
+		indices.insert(indices.end(), {out0, in1, out1});
+	}
+}
+
+void BuildAnnulus(std::vector<GpuMesh::Vertex>& vertices, std::vector<uint32_t>& indices, float innerR, float outerR, int segments, float y) {
+	vertices.clear();
+	indices.clear();
+
+	// 継ぎ目の頂点は UV を分けたいので共有しない（segments+1 列）
+	const float twoPi = 6.283185307f;
+	AppendBand(vertices, indices, -twoPi * 0.5f, twoPi * 0.5f, innerR, outerR, segments, y, static_cast<float>(segments));
+}
+
+void AppendArc(std::vector<GpuMesh::Vertex>& vertices, std::vector<uint32_t>& indices, float centerAngle, float halfWidth, float innerR, float outerR, int segments, float y) {
+	AppendBand(vertices, indices, centerAngle - halfWidth, centerAngle + halfWidth, innerR, outerR, segments, y, 1.0f);
+}
+
+void AppendRect(std::vector<GpuMesh::Vertex>& vertices, std::vector<uint32_t>& indices, float x0, float z0, float x1, float z1, float y) {
+	const uint32_t base = static_cast<uint32_t>(vertices.size());
+	vertices.push_back({{x0, y, z0}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}});
+	vertices.push_back({{x1, y, z0}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}});
+	vertices.push_back({{x1, y, z1}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}});
+	vertices.push_back({{x0, y, z1}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}});
+
+	// 帯と同じく真上から見て時計回りを表とする
+	indices.insert(indices.end(), {base, base + 3u, base + 2u});
+	indices.insert(indices.end(), {base, base + 2u, base + 1u});
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "GpuMesh.h"
+#include <cstdint>
+#include <vector>
+
+// 手続き生成メッシュ（XZ 平面上の帯。法線は +Y、真上俯瞰から見て表になる巻き順）
+
+// 円環（アニュラス）を生成する。vertices/indices は上書き
+void BuildAnnulus(std::vector<GpuMesh::Vertex>& vertices, std::vector<uint32_t>& indices, float innerR, float outerR, int segments, float y);
+
+// 円弧（centerAngle ± halfWidth の帯）を末尾に追加する
+void AppendArc(std::vector<GpuMesh::Vertex>& vertices, std::vector<uint32_t>& indices, float centerAngle, float halfWidth, float innerR, float outerR, int segments, float y);
+
+// XZ 平面上の長方形 [x0, x1] × [z0, z1] を末尾に追加する（UV は長方形全体で 0→1）
+void AppendRect(std::vector<GpuMesh::Vertex>& vertices, std::vector<uint32_t>& indices, float x0, float z0, float x1, float z1, float y);
@@ -0,0 +1,134 @@
+#include "ModelAsset.h"
+#include "AssetPack.h"
+#include "MappedFile.h"
+#include "MeshBlob.h"
+#include "QuantizedPipeline.h"
+#include "TextureFile.h"
+#include <cstring>
+
+using namespace KamataEngine;
+
+static_assert(sizeof(MeshBlob::Vertex) == sizeof(GpuMesh::Vertex), "MeshBlob::Vertex must match Mesh::VertexPosNormalUv");
+
+ModelAsset* ModelAsset::Load(const std::string& name, bool smoothing) {
+	ModelAsset* asset = new ModelAsset();
+	if (asset->LoadBaked(name))
+		return asset;
+
+	// 事前変換版がなければ OBJ を解析する
+	asset->materials_.clear();
+	asset->model_ = Model::CreateFromOBJ(name, smoothing);
+	return asset;
+}
+
+ModelAsset* ModelAsset::CreateFromBlob(const std::string& name, const void* data, size_t size) {
+	ModelAsset* asset = new ModelAsset();
+	if (asset->BuildFromBlob(name, data, size))
+		return asset;
+	delete asset;
+	return nullptr;
+}
+
+ModelAsset::~ModelAsset() { delete model_; }
+
+bool ModelAsset::LoadBaked(const std::string& name) {
+	const std::string path = "Resources/" + name + "/" + name + ".mesh";
+
+	// パックにあればマップ上をそのまま使う（圧縮されていれば展開したもの）
+	AssetPack* pack = AssetPack::GetInstance();
+	if (pack->Contains(path)) {
+		std::vector<uint8_t> storage;
+		std::span<const uint8_t> data;
+		return pack->Load(path, storage, data) && BuildFromBlob(name, data.data(), data.size());
+	}
+
+	MappedFile file;
+	if (!file.Open(path))
+		return false;
+	return BuildFromBlob(name, file.GetData(), file.GetSize());
+}
+
+bool ModelAsset::BuildFromBlob(const std::string& name, const void* data, size_t size) {
+	const MeshBlob::Header* header = MeshBlob::Validate(data, size);
+	if (!header)
+		return false;
+
+	const MeshBlob::Part* blobParts = MeshBlob::At<MeshBlob::Part>(data, header->partsOffset);
+	const MeshBlob::Material* blobMaterials = MeshBlob::At<MeshBlob::Material>(data, header->materialsOffset);
+	const uint8_t* vertices = MeshBlob::At<uint8_t>(data, header->verticesOffset);
+	const uint8_t* indices = MeshBlob::At<uint8_t>(data, header->indicesOffset);
+	const size_t vertexStride = MeshBlob::VertexStride(*header);
+	const size_t indexStride = MeshBlob::IndexStride(*header);
+	const DXGI_FORMAT indexFormat = (header->flags & MeshBlob::kFlagIndex16) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	const bool quantized = (header->flags & MeshBlob::kFlagQuantized) != 0u;
+	VertexQuant::Quantization quantization{};
+	std::memcpy(quantization.offset, header->quantOffset, sizeof(quantization.offset));
+	std::memcpy(quantization.scale, header->quantScale, sizeof(quantization.scale));
+
+	// マテリアル（Model::LoadTextures と同じくモデルのフォルダからテクスチャを読む）
+	for (uint32_t i = 0; i < header->materialCount; ++i) {
+		const MeshBlob::Material& src = blobMaterials[i];
+		std::unique_ptr<Material> material = Material::Create();
+		material->name_ = src.name;
+		material->ambient_ = {src.ambient[0], src.ambient[1], src.ambient[2]};
+		material->diffuse_ = {src.diffuse[0], src.diffuse[1], src.diffuse[2]};
+		material->specular_ = {src.specular[0], src.specular[1], src.specular[2]};
+		material->alpha_ = src.alpha;
+		material->textureFilename_ = src.textureFilename;
+		// 圧縮版の優先と、同じ中身のテクスチャへの名寄せをした名前で読む（フォルダ込みの名前になる）
+		// 先に LoadTextureShared で読んでおくと、名寄せの集計に GPU 側の大きさが載る（LoadTexture は同じハンドルを引くだけになる）
+		if (!material->textureFilename_.empty()) {
+			const std::string fileName = name + "/" + material->textureFilename_;
+			material->textureFilename_ = CanonicalTexture(fileName);
+			LoadTextureShared(fileName);
+		}
+		material->LoadTexture("");
+		material->Update();
+		materials_.push_back(std::move(material));
+	}
+
+	// 描画単位ごとに頂点・インデックスをそのまま転送
+	for (uint32_t i = 0; i < header->partCount; ++i) {
+		const MeshBlob::Part& src = blobParts[i];
+		if (src.vertexCount == 0u || src.indexCount == 0u)
+			continue;
+
+		std::unique_ptr<GpuMesh> mesh = std::make_unique<GpuMesh>();
+		mesh->Initialize(src.vertexCount, src.indexCount, indexFormat, quantized ? GpuMesh::Layout::kQuantized : GpuMesh::Layout::kFloat);
+		mesh->UploadRaw(vertices + vertexStride * src.vertexStart, src.vertexCount, indices + indexStride * src.indexStart, src.indexCount);
+		if (quantized)
+			mesh->SetQuantization(quantization);
+
+		Part part;
+		part.mesh = mesh.get();
+		part.material = materials_[src.materialIndex].get();
+		parts_.push_back(part);
+		meshes_.push_back(std::move(mesh));
+	}
+	return !parts_.empty();
+}
+
+void ModelAsset::Draw(const WorldTransform& worldTransform, const Camera& camera) const {
+	if (model_) {
+		model_->Draw(worldTransform, camera);
+		return;
+	}
+	if (parts_.empty())
+		return;
+
+	// .mesh の描画単位は頂点形式がそろっているので、パイプラインの切り替えはモデルごとに1回
+	ID3D12GraphicsCommandList* commandList = ModelCommon::GetInstance()->GetCommandList();
+	const bool quantized = parts_.front().mesh->GetLayout() == GpuMesh::Layout::kQuantized;
+	if (quantized)
+		QuantizedPipeline::Bind(commandList);
+	for (const Part& part : parts_)
+		part.mesh->Draw(worldTransform, camera, part.material);
+	if (quantized)
+		QuantizedPipeline::Restore(commandList);
+}
+
+Material* ModelAsset::GetMaterial() const {
+	if (model_)
+		return model_->GetMeshes().empty() ? nullptr : model_->GetMeshes().front()->GetMaterial();
+	return parts_.empty() ? nullptr : parts_.front().material;
+}
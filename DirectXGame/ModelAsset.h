@@ -0,0 +1,56 @@
+#pragma once
+#include "GpuMesh.h"
+#include <KamataEngine.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 描画用モデル
+// ・Resources/<name>/<name>.mesh（Tools/MeshBaker で作成）があればメモリマップして解析なしで転送する
+// ・なければ従来どおり Model::CreateFromOBJ で読み込む
+class ModelAsset {
+public:
+	// 1マテリアルぶんの描画単位
+	struct Part {
+		const GpuMesh* mesh = nullptr; // 事前変換版のみ
+		Material* material = nullptr;
+	};
+
+	// 読み込み（smoothing は OBJ から読む場合のみ使う。.mesh は変換時に指定する）
+	static ModelAsset* Load(const std::string& name, bool smoothing = false);
+
+	// 読み込み済みの .mesh の中身から作る（非同期読み込みの仕上げ用・メインスレッドで呼ぶ）。壊れていれば nullptr
+	static ModelAsset* CreateFromBlob(const std::string& name, const void* data, size_t size);
+
+	~ModelAsset();
+
+	// 直接描画（Model::PreDraw ～ Model::PostDraw の間で呼ぶ）
+	void Draw(const WorldTransform& worldTransform, const Camera& camera) const;
+
+	// OBJ から読んだ場合の Model（事前変換版なら nullptr）
+	Model* GetModel() const { return model_; }
+
+	// 事前変換版の描画単位
+	const std::vector<Part>& GetParts() const { return parts_; }
+
+	// 先頭マテリアル（手続き生成メッシュに流用する用）
+	Material* GetMaterial() const;
+
+	// .mesh から読んだか
+	bool IsBaked() const { return model_ == nullptr; }
+
+private:
+	ModelAsset() = default;
+	ModelAsset(const ModelAsset&) = delete;
+	ModelAsset& operator=(const ModelAsset&) = delete;
+
+	bool LoadBaked(const std::string& name);
+	bool BuildFromBlob(const std::string& name, const void* data, size_t size);
+
+	Model* model_ = nullptr;
+	std::vector<std::unique_ptr<GpuMesh>> meshes_;
+	std::vector<std::unique_ptr<Material>> materials_;
+	std::vector<Part> parts_;
+};
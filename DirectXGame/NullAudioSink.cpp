@@ -0,0 +1,113 @@
+#include "NullAudioSink.h"
+#include <algorithm>
+
+bool NullAudioSink::Open(const WaveFormat& format, BufferEndCallback onBufferEnd) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (format.channels == 0u || format.blockAlign == 0u)
+		return false;
+	onBufferEnd_ = std::move(onBufferEnd);
+	queue_.clear();
+	playedBytes_ = 0u;
+	opened_ = true;
+	started_ = false;
+	streamEnded_ = false;
+	return true;
+}
+
+void NullAudioSink::Close() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	queue_.clear();
+	onBufferEnd_ = nullptr;
+	opened_ = false;
+	started_ = false;
+}
+
+bool NullAudioSink::Submit(const uint8_t* data, size_t size, bool endOfStream) {
+	uint32_t finished = 0u;
+	BufferEndCallback callback;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!opened_)
+			return false;
+		queue_.push_back({data, size, 0u, endOfStream});
+		if (autoConsume_ && started_)
+			finished = Advance(size);
+		callback = onBufferEnd_;
+	}
+	// コールバックの先でこちらを呼び返してもよいよう、ロックの外で呼ぶ
+	for (uint32_t i = 0; i < finished && callback; ++i)
+		callback();
+	return true;
+}
+
+void NullAudioSink::Start() {
+	uint32_t finished = 0u;
+	BufferEndCallback callback;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		started_ = true;
+		if (autoConsume_) {
+			size_t queued = 0u;
+			for (const Pending& p : queue_)
+				queued += p.size - p.played;
+			finished = Advance(queued);
+		}
+		callback = onBufferEnd_;
+	}
+	for (uint32_t i = 0; i < finished && callback; ++i)
+		callback();
+}
+
+void NullAudioSink::Stop() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	started_ = false;
+}
+
+uint32_t NullAudioSink::Consume(size_t bytes) {
+	uint32_t finished = 0u;
+	BufferEndCallback callback;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!started_)
+			return 0u;
+		finished = Advance(bytes);
+		callback = onBufferEnd_;
+	}
+	for (uint32_t i = 0; i < finished && callback; ++i)
+		callback();
+	return finished;
+}
+
+uint32_t NullAudioSink::Advance(size_t bytes) {
+	uint32_t finished = 0u;
+	while (!queue_.empty()) {
+		Pending& p = queue_.front();
+		const size_t n = std::min(bytes, p.size - p.played);
+		if (capture_)
+			capture_->insert(capture_->end(), p.data + p.played, p.data + p.played + n);
+		p.played += n;
+		playedBytes_ += n;
+		bytes -= n;
+		if (p.played < p.size)
+			break;
+		streamEnded_ = streamEnded_ || p.endOfStream;
+		queue_.pop_front();
+		finished++;
+	}
+	return finished;
+}
+
+size_t NullAudioSink::GetQueuedCount() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return queue_.size();
+}
+
+uint64_t NullAudioSink::GetPlayedBytes() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return playedBytes_;
+}
+
+bool NullAudioSink::IsStreamEnded() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return streamEnded_;
+}
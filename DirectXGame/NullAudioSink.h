@@ -0,0 +1,56 @@
+#pragma once
+#include "AudioSink.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// 音を出さない出力先（XAudio2 のない環境・Linux でストリーミングの動きを確かめる用）
+// ・Consume で古いバッファから順に指定バイト数ぶん再生したことにし、再生し終えたバッファの onBufferEnd を呼ぶ
+// ・autoConsume なら Submit したそばから再生し終えたことにする（最速で流す）
+// ・SetCapture で渡したベクタに再生した波形を追記する（ループの継ぎ目の確認用）
+class NullAudioSink : public AudioSink {
+public:
+	explicit NullAudioSink(bool autoConsume = false) : autoConsume_(autoConsume) {}
+	~NullAudioSink() override { Close(); }
+
+	bool Open(const WaveFormat& format, BufferEndCallback onBufferEnd) override;
+	void Close() override;
+	bool Submit(const uint8_t* data, size_t size, bool endOfStream) override;
+	void Start() override;
+	void Stop() override;
+	void SetVolume(float volume) override { volume_.store(volume, std::memory_order_relaxed); }
+
+	// 再生中なら bytes ぶん進める（キューが尽きたら止まる）。再生し終えたバッファ数を返す
+	uint32_t Consume(size_t bytes);
+
+	void SetCapture(std::vector<uint8_t>* capture) { capture_ = capture; }
+
+	size_t GetQueuedCount() const;
+	uint64_t GetPlayedBytes() const;
+	bool IsStreamEnded() const;
+	float GetVolume() const { return volume_.load(std::memory_order_relaxed); }
+
+private:
+	struct Pending {
+		const uint8_t* data = nullptr;
+		size_t size = 0u;
+		size_t played = 0u;
+		bool endOfStream = false;
+	};
+
+	// 先頭から bytes ぶん再生する。終わったバッファ数を返す（ロックは呼び出し側）
+	uint32_t Advance(size_t bytes);
+
+	const bool autoConsume_;
+	BufferEndCallback onBufferEnd_;
+	mutable std::mutex mutex_;
+	std::deque<Pending> queue_;
+	std::vector<uint8_t>* capture_ = nullptr;
+	uint64_t playedBytes_ = 0u;
+	bool opened_ = false;
+	bool started_ = false;
+	bool streamEnded_ = false;
+	std::atomic<float> volume_{1.0f}; // 鳴らすスレッドと確かめるスレッドが別でもよいように
+};
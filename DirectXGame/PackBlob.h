@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// アセットパック（.pak）のファイル形式
+// ・Tools/PackBuilder が作り、実行時は AssetPack がメモリマップして使う
+// ・リトルエンディアン。各ブロック・各データは 16 バイト境界から始まる
+//   [Header][Entry × entryCount（pathHash の昇順）][パス文字列][データ...]
+// ・パスは実行ディレクトリからの相対パスを NormalizePath したもの（例: "resources/base/base.mesh"）
+namespace PackBlob {
+
+const uint32_t kMagic = 0x4B41504Bu; // "KPAK"
+const uint32_t kVersion = 1u;
+const size_t kAlignment = 16u;
+
+// データの格納方法
+enum Compression : uint8_t {
+	kStored = 0u, // そのまま（メモリマップ上を直接参照できる）
+	kLz = 1u,     // Lz.h で圧縮
+};
+
+struct Header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t fileSize;
+	uint32_t entryCount;
+	uint32_t entriesOffset;
+	uint32_t namesOffset;
+	uint32_t namesSize;
+	uint32_t reserved;
+};
+
+struct Entry {
+	uint64_t pathHash;   // HashBytes(正規化したパス)
+	uint32_t offset;     // データの位置
+	uint32_t size;       // 格納サイズ
+	uint32_t rawSize;    // 展開後のサイズ
+	uint32_t nameOffset; // パス文字列の位置（namesOffset から。終端なし）
+	uint16_t nameLength;
+	uint8_t compression;
+	uint8_t reserved[5];
+};
+
+static_assert(sizeof(Header) == 32, "PackBlob::Header layout");
+static_assert(sizeof(Entry) == 32, "PackBlob::Entry layout");
+
+inline size_t AlignUp(size_t value) { return (value + kAlignment - 1u) & ~(kAlignment - 1u); }
+
+// 区切りを '/' に、英字を小文字に、"./" を外す（Windows のパスは大文字小文字を区別しないので揃える）
+// ・"Resources/" + "./BGM/x.wav" のように途中に入った "./" も外す
+inline std::string NormalizePath(const std::string& path) {
+	std::string out;
+	out.reserve(path.size());
+	for (size_t i = 0; i < path.size(); ++i) {
+		char c = path[i];
+		// 区切りの直後（先頭を含む）の "./" を読み飛ばす
+		const bool segmentStart = out.empty() || out.back() == '/';
+		if (segmentStart && c == '.' && i + 1u < path.size() && (path[i + 1u] == '/' || path[i + 1u] == '\\')) {
+			i++;
+			continue;
+		}
+		if (c == '\\')
+			c = '/';
+		else if (c >= 'A' && c <= 'Z')
+			c = static_cast<char>(c - 'A' + 'a');
+		out += c;
+	}
+	return out;
+}
+
+// 先頭を検証してヘッダを返す（壊れていれば nullptr）
+inline const Header* Validate(const void* data, size_t size) {
+	if (!data || size < sizeof(Header))
+		return nullptr;
+	const Header* h = static_cast<const Header*>(data);
+	if (h->magic != kMagic || h->version != kVersion || h->fileSize != size)
+		return nullptr;
+	if (h->entriesOffset % kAlignment != 0u || h->entriesOffset > size || static_cast<uint64_t>(h->entryCount) * sizeof(Entry) > size - h->entriesOffset)
+		return nullptr;
+	if (h->namesOffset > size || h->namesSize > size - h->namesOffset)
+		return nullptr;
+
+	// 各データが範囲内にあり、pathHash が昇順に並んでいるか
+	const Entry* entries = reinterpret_cast<const Entry*>(static_cast<const uint8_t*>(data) + h->entriesOffset);
+	for (uint32_t i = 0; i < h->entryCount; ++i) {
+		const Entry& e = entries[i];
+		if (e.offset % kAlignment != 0u || e.offset > size || e.size > size - e.offset || e.nameOffset > h->namesSize || e.nameLength > h->namesSize - e.nameOffset)
+			return nullptr;
+		if (e.compression > kLz || (e.compression == kStored && e.size != e.rawSize))
+			return nullptr;
+		if (i > 0u && entries[i - 1u].pathHash > e.pathHash)
+			return nullptr;
+	}
+	return h;
+}
+
+} // namespace PackBlob
@@ -0,0 +1,126 @@
+#include "QuantizedPipeline.h"
+#include <cassert>
+#include <d3dcompiler.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+using namespace KamataEngine;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+ComPtr<ID3D12RootSignature> sRootSignature;
+ComPtr<ID3D12PipelineState> sPipelineState;
+
+ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath, const char* target) {
+	// デバッグ情報と最適化なしは Debug ビルドだけ（Release は既定の最適化でコンパイルする）
+#ifdef _DEBUG
+	const UINT compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+	const UINT compileFlags = 0u;
+#endif
+	ComPtr<ID3DBlob> blob;
+	ComPtr<ID3DBlob> errorBlob;
+	HRESULT result = D3DCompileFromFile(filePath, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target, compileFlags, 0, &blob, &errorBlob);
+	if (FAILED(result)) {
+		if (errorBlob)
+			OutputDebugStringA(static_cast<const char*>(errorBlob->GetBufferPointer()));
+		assert(false);
+	}
+	return blob;
+}
+
+void StaticInitialize() {
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	HRESULT result = S_FALSE;
+
+	ComPtr<ID3DBlob> vsBlob = CompileShader(L"Resources/shaders/ObjQuantizedVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(L"Resources/shaders/ObjPS.hlsl", "ps_5_0");
+
+	// ルートシグネチャ（Model::RoomParameter の順 + b5: 展開値）
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+
+	CD3DX12_ROOT_PARAMETER rootParams[QuantizedPipeline::kRootQuantization + 1u];
+	rootParams[static_cast<UINT>(Model::RoomParameter::kWorldTransform)].InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootParams[static_cast<UINT>(Model::RoomParameter::kCamera)].InitAsConstantBufferView(1, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootParams[static_cast<UINT>(Model::RoomParameter::kMaterial)].InitAsConstantBufferView(2, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootParams[static_cast<UINT>(Model::RoomParameter::kTexture)].InitAsDescriptorTable(1, &descRangeSRV, D3D12_SHADER_VISIBILITY_ALL);
+	rootParams[static_cast<UINT>(Model::RoomParameter::kLight)].InitAsConstantBufferView(3, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootParams[static_cast<UINT>(Model::RoomParameter::kObjectColor)].InitAsConstantBufferView(4, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootParams[QuantizedPipeline::kRootQuantization].InitAsConstants(sizeof(float) * 8u / sizeof(uint32_t), 5, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR);
+
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(_countof(rootParams), rootParams, 1, &samplerDesc, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = device->CreateRootSignature(0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(), IID_PPV_ARGS(&sRootSignature));
+	assert(SUCCEEDED(result));
+
+	// 頂点レイアウト（VertexQuant::Vertex）
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL",   0, DXGI_FORMAT_R16G16_SNORM,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// Model と同じ設定（背面カリング・深度あり・通常ブレンド）
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
+	pipelineDesc.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	pipelineDesc.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	pipelineDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	pipelineDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	pipelineDesc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	pipelineDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+
+	D3D12_RENDER_TARGET_BLEND_DESC& blendDesc = pipelineDesc.BlendState.RenderTarget[0];
+	blendDesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blendDesc.BlendEnable = true;
+	blendDesc.BlendOp = D3D12_BLEND_OP_ADD;
+	blendDesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blendDesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+	blendDesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blendDesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blendDesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	pipelineDesc.InputLayout.pInputElementDescs = inputLayout;
+	pipelineDesc.InputLayout.NumElements = _countof(inputLayout);
+	pipelineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	pipelineDesc.NumRenderTargets = 1;
+	pipelineDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	pipelineDesc.SampleDesc.Count = 1;
+	pipelineDesc.pRootSignature = sRootSignature.Get();
+
+	result = device->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&sPipelineState));
+	assert(SUCCEEDED(result));
+}
+
+} // namespace
+
+void QuantizedPipeline::Bind(ID3D12GraphicsCommandList* commandList) {
+	if (!sPipelineState)
+		StaticInitialize();
+	commandList->SetPipelineState(sPipelineState.Get());
+	commandList->SetGraphicsRootSignature(sRootSignature.Get());
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void QuantizedPipeline::SetQuantization(ID3D12GraphicsCommandList* commandList, const VertexQuant::Quantization& quantization) {
+	// HLSL の定数レジスタ境界（float3 + パディング）に合わせて並べる
+	const float constants[8] = {
+	    quantization.offset[0], quantization.offset[1], quantization.offset[2], 0.0f, quantization.scale[0], quantization.scale[1], quantization.scale[2], 0.0f,
+	};
+	commandList->SetGraphicsRoot32BitConstants(kRootQuantization, _countof(constants), constants, 0);
+}
+
+void QuantizedPipeline::Restore(ID3D12GraphicsCommandList* commandList) {
+	// ModelCommon のパイプラインは外から取れないので、PostDraw → PreDraw で積み直してもらう
+	ModelCommon* common = ModelCommon::GetInstance();
+	common->PostDraw();
+	common->PreDraw(commandList);
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "VertexQuant.h"
+#include <KamataEngine.h>
+
+using namespace KamataEngine;
+
+// 量子化頂点（VertexQuant::Vertex）を描く Obj パイプライン（ObjQuantizedVS + ObjPS）
+// ・ルートシグネチャは ModelCommon と同じ並び（Model::RoomParameter）の後ろに展開値の定数（b5）を足したもの
+//   Model と同じ手順でバインドし、展開値だけ kRootQuantization に積む
+// ・ルートシグネチャが変わるのでバインドはやり直しになる。描き終えたら Restore で ModelCommon のものに戻す
+class QuantizedPipeline {
+public:
+	static const UINT kRootQuantization = static_cast<UINT>(Model::RoomParameter::kObjectColor) + 1u;
+
+	// パイプラインとルートシグネチャを積む（初回に作る）
+	static void Bind(ID3D12GraphicsCommandList* commandList);
+
+	// 位置の展開値を積む
+	static void SetQuantization(ID3D12GraphicsCommandList* commandList, const VertexQuant::Quantization& quantization);
+
+	// ModelCommon のパイプラインに戻す（Model::PreDraw ～ Model::PostDraw の間で呼ぶ）
+	static void Restore(ID3D12GraphicsCommandList* commandList);
+};
@@ -0,0 +1,262 @@
+#include "RenderQueue.h"
+#include "ConstantBufferAllocator.h"
+#include "QuantizedPipeline.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace KamataEngine;
+
+namespace {
+
+// Model::Draw 1回あたりのバインド数（ライト・WT・カメラ・カラー・VB・IB・マテリアル・テクスチャ）
+const uint32_t kBindsPerModelDraw = 8u;
+
+// パイプラインは Model 用と量子化頂点用の2種類・通常ブレンドのみ
+const uint64_t kPipelineModel = 0u;
+const uint64_t kPipelineQuantized = 1u;
+const uint64_t kBlendNormal = static_cast<uint64_t>(Sprite::BlendMode::kNormal);
+
+const UINT kRootWorldTransform = static_cast<UINT>(Model::RoomParameter::kWorldTransform);
+const UINT kRootCamera = static_cast<UINT>(Model::RoomParameter::kCamera);
+const UINT kRootMaterial = static_cast<UINT>(Model::RoomParameter::kMaterial);
+const UINT kRootTexture = static_cast<UINT>(Model::RoomParameter::kTexture);
+const UINT kRootObjectColor = static_cast<UINT>(Model::RoomParameter::kObjectColor);
+
+// 正の float はビット列のまま大小比較できるので上位24bitを深度キーにする
+uint64_t DepthBits(float viewZ) {
+	if (!(viewZ > 0.0f))
+		return 0u;
+	uint32_t bits = 0u;
+	std::memcpy(&bits, &viewZ, sizeof(bits));
+	return static_cast<uint64_t>(bits >> 8);
+}
+
+} // namespace
+
+void RenderQueue::Initialize(size_t capacity) {
+	packets_.reserve(capacity);
+	keys_.reserve(capacity);
+	keysTmp_.reserve(capacity);
+	order_.reserve(capacity);
+	orderTmp_.reserve(capacity);
+	materialIds_.reserve(16);
+}
+
+void RenderQueue::Push(Model* model, const Matrix4x4& matWorld, Layer layer) {
+	if (!model)
+		return;
+	for (const auto& mesh : model->GetMeshes()) {
+		PushPacket(mesh->GetVBView(), mesh->GetIBView(), static_cast<UINT>(mesh->GetIndices().size()), mesh->GetMaterial(), matWorld, layer);
+	}
+}
+
+void RenderQueue::Push(const ModelAsset* asset, const Matrix4x4& matWorld, Layer layer) {
+	if (!asset)
+		return;
+	if (asset->GetModel()) {
+		Push(asset->GetModel(), matWorld, layer);
+		return;
+	}
+	for (const ModelAsset::Part& part : asset->GetParts())
+		Push(*part.mesh, part.material, matWorld, layer);
+}
+
+void RenderQueue::Push(const GpuMesh& mesh, Material* material, const Matrix4x4& matWorld, Layer layer) {
+	const bool quantized = mesh.GetLayout() == GpuMesh::Layout::kQuantized;
+	PushPacket(mesh.GetVBView(), mesh.GetIBView(), mesh.GetIndexCount(), material, matWorld, layer, quantized ? &mesh.GetQuantization() : nullptr);
+}
+
+void RenderQueue::PushPacket(
+    const D3D12_VERTEX_BUFFER_VIEW& vbView, const D3D12_INDEX_BUFFER_VIEW& ibView, UINT indexCount, Material* material, const Matrix4x4& matWorld, Layer layer,
+    const VertexQuant::Quantization* quantization) {
+	if (indexCount == 0u || !material)
+		return;
+
+	Packet p;
+	p.vbView = &vbView;
+	p.ibView = &ibView;
+	p.indexCount = indexCount;
+	p.material = material;
+	p.matWorld = matWorld;
+	p.layer = layer;
+	p.quantization = quantization;
+	packets_.push_back(p);
+}
+
+uint64_t RenderQueue::MakeKey(const Packet& packet, const Camera& camera) {
+	// マテリアルはフレーム内で少数なので線形探索で通し番号を振る
+	uint64_t materialId = 0u;
+	auto it = std::find(materialIds_.begin(), materialIds_.end(), packet.material);
+	if (it == materialIds_.end()) {
+		materialId = materialIds_.size();
+		materialIds_.push_back(packet.material);
+	} else {
+		materialId = static_cast<uint64_t>(it - materialIds_.begin());
+	}
+
+	// ビュー空間の Z（行ベクトル規約：v * matView）
+	const Matrix4x4& w = packet.matWorld;
+	const Matrix4x4& v = camera.matView;
+	float viewZ = w.m[3][0] * v.m[0][2] + w.m[3][1] * v.m[1][2] + w.m[3][2] * v.m[2][2] + v.m[3][2];
+	uint64_t depth = DepthBits(viewZ);
+	if (packet.layer == Layer::kTransparent)
+		depth = 0xFFFFFFu - depth; // 奥→手前
+
+	uint64_t key = 0u;
+	key |= (static_cast<uint64_t>(packet.layer) & 0xFu) << 60;
+	key |= (kBlendNormal & 0xFu) << 56;
+	key |= ((packet.quantization ? kPipelineQuantized : kPipelineModel) & 0xFu) << 52;
+	key |= (static_cast<uint64_t>(packet.material->GetTextureHadle()) & 0xFFFu) << 40;
+	key |= (materialId & 0xFFFFu) << 24;
+	key |= depth & 0xFFFFFFu;
+	return key;
+}
+
+void RenderQueue::RadixSort() {
+	const size_t n = keys_.size();
+	keysTmp_.resize(n);
+	orderTmp_.resize(n);
+
+	// 8bit ずつ下位から安定ソート。全要素で同じ桁はスキップする
+	for (int shift = 0; shift < 64; shift += 8) {
+		uint32_t count[256] = {};
+		for (size_t i = 0; i < n; ++i)
+			count[(keys_[i] >> shift) & 0xFFu]++;
+		if (count[(keys_[0] >> shift) & 0xFFu] == n)
+			continue;
+
+		uint32_t offset = 0u;
+		for (uint32_t& c : count) {
+			uint32_t tmp = c;
+			c = offset;
+			offset += tmp;
+		}
+		for (size_t i = 0; i < n; ++i) {
+			uint32_t dst = count[(keys_[i] >> shift) & 0xFFu]++;
+			keysTmp_[dst] = keys_[i];
+			orderTmp_[dst] = order_[i];
+		}
+		keys_.swap(keysTmp_);
+		order_.swap(orderTmp_);
+	}
+}
+
+void RenderQueue::Submit(const Camera& camera) {
+	stats_ = {};
+	if (packets_.empty())
+		return;
+
+	// キー生成
+	materialIds_.clear();
+	keys_.resize(packets_.size());
+	order_.resize(packets_.size());
+	for (size_t i = 0; i < packets_.size(); ++i) {
+		keys_[i] = MakeKey(packets_[i], camera);
+		order_[i] = static_cast<uint32_t>(i);
+	}
+	RadixSort();
+
+	ModelCommon* common = ModelCommon::GetInstance();
+	ID3D12GraphicsCommandList* commandList = common->GetCommandList();
+	TextureManager* textureManager = TextureManager::GetInstance();
+	ConstantBufferAllocator* cbAllocator = ConstantBufferAllocator::GetInstance();
+
+	// フレーム共通のもの（ライト・カメラ・カラー）は1回だけ
+	ConstBufferDataCamera cameraData{camera.matView, camera.matProjection, camera.translation_};
+	ConstantBufferAllocator::Allocation cameraCB = cbAllocator->Push(cameraData);
+	ConstantBufferAllocator::Allocation colorCB = cbAllocator->Push(ConstBufferDataObjectColor{{1.0f, 1.0f, 1.0f, 1.0f}});
+	if (!cameraCB.IsValid() || !colorCB.IsValid()) {
+		stats_.packets = static_cast<uint32_t>(packets_.size());
+		stats_.binds = 0u;
+		stats_.bindsSaved = 0;
+		stats_.dropped = stats_.packets;
+		packets_.clear();
+		return;
+	}
+	auto bindFrameCommon = [&]() {
+		common->LightCommand();
+		commandList->SetGraphicsRootConstantBufferView(kRootCamera, cameraCB.gpu);
+		commandList->SetGraphicsRootConstantBufferView(kRootObjectColor, colorCB.gpu);
+	};
+	bindFrameCommon();
+	uint32_t binds = 3u;
+	uint32_t dropped = 0u;
+
+	const D3D12_VERTEX_BUFFER_VIEW* curVB = nullptr;
+	const D3D12_INDEX_BUFFER_VIEW* curIB = nullptr;
+	Material* curMaterial = nullptr;
+	uint32_t curTexture = UINT32_MAX;
+	bool curQuantized = false;
+	const VertexQuant::Quantization* curQuantization = nullptr;
+
+	for (uint32_t idx : order_) {
+		const Packet& p = packets_[idx];
+
+		// パイプラインを替えるとルート引数は消えるので、フレーム共通のものから積み直す
+		const bool quantized = p.quantization != nullptr;
+		if (quantized != curQuantized) {
+			if (quantized)
+				QuantizedPipeline::Bind(commandList);
+			else
+				QuantizedPipeline::Restore(commandList);
+			bindFrameCommon();
+			curQuantized = quantized;
+			curQuantization = nullptr;
+			curMaterial = nullptr;
+			curTexture = UINT32_MAX;
+			binds += 4u;
+		}
+		if (quantized && p.quantization != curQuantization) {
+			QuantizedPipeline::SetQuantization(commandList, *p.quantization);
+			curQuantization = p.quantization;
+			binds++;
+		}
+
+		// 行列は描画時にフレーム用領域へ書き込む
+		ConstantBufferAllocator::Allocation worldCB = cbAllocator->Push(ConstBufferDataWorldTransform{p.matWorld});
+		if (!worldCB.IsValid()) {
+			dropped++;
+			continue;
+		}
+		commandList->SetGraphicsRootConstantBufferView(kRootWorldTransform, worldCB.gpu);
+		binds++;
+
+		if (p.vbView != curVB) {
+			commandList->IASetVertexBuffers(0, 1, p.vbView);
+			curVB = p.vbView;
+			binds++;
+		}
+		if (p.ibView != curIB) {
+			commandList->IASetIndexBuffer(p.ibView);
+			curIB = p.ibView;
+			binds++;
+		}
+		if (p.material != curMaterial) {
+			commandList->SetGraphicsRootConstantBufferView(kRootMaterial, p.material->GetConstantBuffer()->GetGPUVirtualAddress());
+			curMaterial = p.material;
+			binds++;
+		}
+		uint32_t texture = p.material->GetTextureHadle();
+		if (texture != curTexture) {
+			textureManager->SetGraphicsRootDescriptorTable(commandList, kRootTexture, texture);
+			curTexture = texture;
+			binds++;
+		}
+
+		commandList->DrawIndexedInstanced(p.indexCount, 1, 0, 0, 0);
+	}
+
+	// 後に続く Model::Draw のために Model 用パイプラインへ戻す
+	if (curQuantized) {
+		QuantizedPipeline::Restore(commandList);
+		binds++;
+	}
+
+	stats_.packets = static_cast<uint32_t>(packets_.size());
+	stats_.binds = binds;
+	// 描いた数が少ないと切り替えの分だけ Model::Draw 相当より多くなるので、符号付きで引く
+	stats_.bindsSaved = static_cast<int32_t>(int64_t(stats_.packets - dropped) * kBindsPerModelDraw - int64_t(binds));
+	stats_.dropped = dropped;
+
+	packets_.clear();
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "GpuMesh.h"
+#include "ModelAsset.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 描画パケットを溜めて、ソートキー順にまとめて発行する描画キュー
+// ・キー（64bit, 上位から）: レイヤ4 / ブレンド4 / パイプライン4 / テクスチャ12 / マテリアル16 / 深度24
+// ・パイプラインは Model 用と量子化頂点用（QuantizedPipeline）。切り替えはキー順で1回ずつにまとまる
+// ・毎フレーム基数ソートし、同じ VB/IB・マテリアル・テクスチャの再設定を省く
+// ・行列・カメラ・カラーは Submit 時にフレーム用定数バッファへ書き込む（WorldTransform の定数バッファは使わない）
+// ・Model::PreDraw ～ Model::PostDraw の間で Submit する
+class RenderQueue {
+public:
+	// 描画レイヤ（小さいほど先に描く）
+	enum class Layer : uint8_t {
+		kBackground, // 天球など
+		kOpaque,     // 不透明（手前→奥）
+		kTransparent // 半透明（奥→手前）
+	};
+
+	// 発行結果の統計（1フレーム分）
+	struct Stats {
+		uint32_t packets = 0u;    // 積まれたパケット数
+		uint32_t binds = 0u;      // 実際に積んだバインド数
+		int32_t bindsSaved = 0;   // Model::Draw 相当と比べて省けたバインド数（量子化パイプラインの切り替えで増えたときは負）
+		uint32_t dropped = 0u;    // 定数バッファ不足で描けなかった数
+	};
+
+	// 想定パケット数で作業領域を確保
+	void Initialize(size_t capacity);
+
+	// Model の全メッシュを積む
+	void Push(Model* model, const Matrix4x4& matWorld, Layer layer = Layer::kOpaque);
+	void Push(Model* model, const WorldTransform& worldTransform, Layer layer = Layer::kOpaque) { Push(model, worldTransform.matWorld_, layer); }
+
+	// ModelAsset（事前変換版 / OBJ 版のどちらでも）を積む
+	void Push(const ModelAsset* asset, const Matrix4x4& matWorld, Layer layer = Layer::kOpaque);
+	void Push(const ModelAsset* asset, const WorldTransform& worldTransform, Layer layer = Layer::kOpaque) { Push(asset, worldTransform.matWorld_, layer); }
+
+	// 手続き生成メッシュを積む
+	void Push(const GpuMesh& mesh, Material* material, const Matrix4x4& matWorld, Layer layer = Layer::kOpaque);
+	void Push(const GpuMesh& mesh, Material* material, const WorldTransform& worldTransform, Layer layer = Layer::kOpaque) { Push(mesh, material, worldTransform.matWorld_, layer); }
+
+	// ソートして発行し、キューを空にする
+	void Submit(const Camera& camera);
+
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	struct Packet {
+		const D3D12_VERTEX_BUFFER_VIEW* vbView = nullptr;
+		const D3D12_INDEX_BUFFER_VIEW* ibView = nullptr;
+		UINT indexCount = 0u;
+		Material* material = nullptr;
+		Matrix4x4 matWorld{};
+		Layer layer = Layer::kOpaque;
+		const VertexQuant::Quantization* quantization = nullptr; // 量子化頂点なら展開値
+	};
+
+	std::vector<Packet> packets_;
+	std::vector<uint64_t> keys_;
+	std::vector<uint64_t> keysTmp_;
+	std::vector<uint32_t> order_;
+	std::vector<uint32_t> orderTmp_;
+	std::vector<Material*> materialIds_; // マテリアル → キー用の通し番号
+	Stats stats_;
+
+	void PushPacket(
+	    const D3D12_VERTEX_BUFFER_VIEW& vbView, const D3D12_INDEX_BUFFER_VIEW& ibView, UINT indexCount, Material* material, const Matrix4x4& matWorld, Layer layer,
+	    const VertexQuant::Quantization* quantization = nullptr);
+	uint64_t MakeKey(const Packet& packet, const Camera& camera);
+	void RadixSort();
+};
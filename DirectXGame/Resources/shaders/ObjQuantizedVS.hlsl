@@ -0,0 +1,34 @@
+#include "Obj.hlsli"
+
+// 量子化頂点（VertexQuant.h）の展開値
+cbuffer Quantization : register(b5) {
+	float3 q_offset : packoffset(c0); // 位置の最小値
+	float3 q_scale : packoffset(c1);  // 位置の範囲
+};
+
+// 八面体写像 → 単位ベクトル
+float3 DecodeOctahedral(float2 e) {
+	float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+	float t = saturate(-n.z);
+	n.xy += n.xy >= 0.0f ? -t : t;
+	return normalize(n);
+}
+
+// qpos: R16G16B16A16_UNORM / qnormal: R16G16_SNORM / uv: R16G16_FLOAT
+VSOutput main(float4 qpos : POSITION, float2 qnormal : NORMAL, float2 uv : TEXCOORD) {
+	float4 pos = float4(q_offset + qpos.xyz * q_scale, 1.0f);
+	float3 normal = DecodeOctahedral(qnormal);
+
+	// 以降は ObjVS と同じ
+	float4 worldNormal = normalize(mul(float4(normal, 0), world));
+	float4 worldPos = mul(pos, world);
+
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(pos, mul(world, mul(view, projection)));
+
+	output.worldpos = worldPos;
+	output.normal = worldNormal.xyz;
+	output.uv = uv;
+
+	return output;
+}
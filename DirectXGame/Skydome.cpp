@@ -1,17 +1,21 @@
 #include "Skydome.h"
+#include "Math.h"
 #include <cassert>
 
     /// <summary>
     /// 初期化
     /// </summary>
     void
-    Skydome::Initialize(Model* model, Camera* camera) {
+    Skydome::Initialize(ModelAsset* model, Camera* camera) {
 
 	assert(model);
 
 	model_ = model;
 	camera_ = camera;
 	worldTransform_.Initialize();
+
+	// 描画キューは matWorld_ を直接読むので単位行列にしておく
+	worldTransform_.matWorld_ = MakeIdentityMatrix();
 }
 
 /// <summary>
@@ -31,3 +35,12 @@ void Skydome::Draw() {
 	// モデル描画
 	model_->Draw(worldTransform_, *camera_);
 }
+
+/// <summary>
+/// 描画（描画キュー経由）
+/// </summary>
+void Skydome::Draw(RenderQueue& queue) {
+
+	// 背景レイヤとして積む
+	queue.Push(model_, worldTransform_, RenderQueue::Layer::kBackground);
+}
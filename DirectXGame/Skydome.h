@@ -1,22 +1,27 @@
 #pragma once
+#include "ModelAsset.h"
+#include "RenderQueue.h"
 #include <KamataEngine.h>
 
 using namespace KamataEngine;
 
 class Skydome {
 public:
-	void Initialize(Model* model, Camera*);
+	void Initialize(ModelAsset* model, Camera*);
 
 	void Update();
 
 	void Draw();
 
+	// 描画キューへ積む（背景レイヤ）
+	void Draw(RenderQueue& queue);
+
 private:
 	// ワールド変換データ
 	WorldTransform worldTransform_;
 
 	// モデル
-	Model* model_ = nullptr;
+	ModelAsset* model_ = nullptr;
 
 	// カメラ
 	Camera* camera_ = nullptr;
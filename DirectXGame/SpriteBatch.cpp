@@ -0,0 +1,312 @@
+#include "SpriteBatch.h"
+#include "ConstantBufferAllocator.h"
+#include <cassert>
+#include <d3dcompiler.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+using namespace KamataEngine;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+const UINT kRootMatrix = 0u;
+const UINT kRootTexture = 1u;
+const size_t kBlendModeCount = static_cast<size_t>(Sprite::BlendMode::kCountOfBlendMode);
+
+// バッチ間で共有する描画設定
+ComPtr<ID3D12RootSignature> sRootSignature;
+ComPtr<ID3D12PipelineState> sPipelineStates[kBlendModeCount];
+ComPtr<ID3D12Resource> sIndexBuffer;
+D3D12_INDEX_BUFFER_VIEW sIBView{};
+
+ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath, const char* target) {
+	// デバッグ情報と最適化なしは Debug ビルドだけ
+#ifdef _DEBUG
+	const UINT compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+	const UINT compileFlags = 0u;
+#endif
+	ComPtr<ID3DBlob> blob;
+	ComPtr<ID3DBlob> errorBlob;
+	HRESULT result = D3DCompileFromFile(filePath, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target, compileFlags, 0, &blob, &errorBlob);
+	if (FAILED(result)) {
+		if (errorBlob)
+			OutputDebugStringA(static_cast<const char*>(errorBlob->GetBufferPointer()));
+		assert(false);
+	}
+	return blob;
+}
+
+// Sprite と同じ式のブレンド設定
+D3D12_RENDER_TARGET_BLEND_DESC MakeBlendDesc(Sprite::BlendMode blendMode) {
+	D3D12_RENDER_TARGET_BLEND_DESC desc{};
+	desc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	desc.BlendEnable = true;
+	desc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	desc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	desc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	switch (blendMode) {
+	case Sprite::BlendMode::kNone:
+		desc.BlendEnable = false;
+		break;
+	case Sprite::BlendMode::kNormal:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		desc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		break;
+	case Sprite::BlendMode::kAdd:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		desc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kSubtract:
+		desc.BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;
+		desc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		desc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kMultiply:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_ZERO;
+		desc.DestBlend = D3D12_BLEND_SRC_COLOR;
+		break;
+	case Sprite::BlendMode::kScreen:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		desc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kExclusion:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		desc.DestBlend = D3D12_BLEND_INV_SRC_COLOR;
+		break;
+	default:
+		break;
+	}
+	return desc;
+}
+
+// スクリーン座標（左上原点・ピクセル）→ クリップ座標
+Matrix4x4 MakeScreenToClipMatrix() {
+	Matrix4x4 m{};
+	m.m[0][0] = 2.0f / static_cast<float>(WinApp::kWindowWidth);
+	m.m[1][1] = -2.0f / static_cast<float>(WinApp::kWindowHeight);
+	m.m[2][2] = 1.0f;
+	m.m[3][0] = -1.0f;
+	m.m[3][1] = 1.0f;
+	m.m[3][3] = 1.0f;
+	return m;
+}
+
+} // namespace
+
+void SpriteBatch::StaticInitialize() {
+	if (sRootSignature)
+		return;
+
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	HRESULT result = S_FALSE;
+
+	ComPtr<ID3DBlob> vsBlob = CompileShader(L"Resources/shaders/SpriteBatchVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(L"Resources/shaders/SpriteBatchPS.hlsl", "ps_5_0");
+
+	// ルートシグネチャ（b0: 行列 / t0: テクスチャ / s0: 静的サンプラー）
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+
+	CD3DX12_ROOT_PARAMETER rootParams[2];
+	rootParams[kRootMatrix].InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	rootParams[kRootTexture].InitAsDescriptorTable(1, &descRangeSRV, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc(0, D3D12_FILTER_MIN_MAG_MIP_POINT, D3D12_TEXTURE_ADDRESS_MODE_CLAMP, D3D12_TEXTURE_ADDRESS_MODE_CLAMP, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
+
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(_countof(rootParams), rootParams, 1, &samplerDesc, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = device->CreateRootSignature(0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(), IID_PPV_ARGS(&sRootSignature));
+	assert(SUCCEEDED(result));
+
+	// 頂点レイアウト
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// パイプライン（ブレンドモードごと）。深度は見ない
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
+	pipelineDesc.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	pipelineDesc.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	pipelineDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	pipelineDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	pipelineDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	pipelineDesc.DepthStencilState.DepthEnable = false;
+	pipelineDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	pipelineDesc.InputLayout.pInputElementDescs = inputLayout;
+	pipelineDesc.InputLayout.NumElements = _countof(inputLayout);
+	pipelineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	pipelineDesc.NumRenderTargets = 1;
+	pipelineDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	pipelineDesc.SampleDesc.Count = 1;
+	pipelineDesc.pRootSignature = sRootSignature.Get();
+
+	for (size_t i = 0; i < kBlendModeCount; ++i) {
+		pipelineDesc.BlendState.RenderTarget[0] = MakeBlendDesc(static_cast<Sprite::BlendMode>(i));
+		result = device->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&sPipelineStates[i]));
+		assert(SUCCEEDED(result));
+	}
+
+	// インデックスは全バッチ共通（矩形 i → 4i+{0,1,2, 2,1,3}）
+	const UINT sizeIB = static_cast<UINT>(sizeof(uint16_t) * 6u * kMaxQuads);
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeIB);
+	result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&sIndexBuffer));
+	assert(SUCCEEDED(result));
+
+	uint16_t* indexMap = nullptr;
+	result = sIndexBuffer->Map(0, nullptr, reinterpret_cast<void**>(&indexMap));
+	assert(SUCCEEDED(result));
+	for (uint32_t q = 0; q < kMaxQuads; ++q) {
+		const uint16_t v = static_cast<uint16_t>(q * 4u);
+		uint16_t* idx = indexMap + q * 6u;
+		idx[0] = v + 0u;
+		idx[1] = v + 1u;
+		idx[2] = v + 2u;
+		idx[3] = v + 2u;
+		idx[4] = v + 1u;
+		idx[5] = v + 3u;
+	}
+	sIndexBuffer->Unmap(0, nullptr);
+
+	sIBView.BufferLocation = sIndexBuffer->GetGPUVirtualAddress();
+	sIBView.Format = DXGI_FORMAT_R16_UINT;
+	sIBView.SizeInBytes = sizeIB;
+}
+
+void SpriteBatch::Initialize(uint32_t maxQuads) {
+	assert(maxQuads > 0u && maxQuads <= kMaxQuads);
+	StaticInitialize();
+
+	maxQuads_ = maxQuads;
+	quads_.reserve(maxQuads_);
+	textures_.reserve(8);
+}
+
+void SpriteBatch::Begin(ID3D12GraphicsCommandList* commandList, Sprite::BlendMode blendMode) {
+	assert(!commandList_ && "SpriteBatch::End が呼ばれていない");
+	commandList_ = commandList;
+	blendMode_ = blendMode;
+	quads_.clear();
+	stats_ = {};
+}
+
+void SpriteBatch::Draw(uint32_t textureHandle, const Vector2& pos, const Vector2& size, const Vector4& color, const Vector2& texBase, const Vector2& texSize) {
+	// テクスチャ座標（ピクセル）→ UV
+	if (texSize.x > 0.0f && texSize.y > 0.0f) {
+		const D3D12_RESOURCE_DESC desc = TextureManager::GetInstance()->GetResoureDesc(textureHandle);
+		const float invW = 1.0f / static_cast<float>(desc.Width);
+		const float invH = 1.0f / static_cast<float>(desc.Height);
+		DrawUV(textureHandle, pos, size, {texBase.x * invW, texBase.y * invH}, {(texBase.x + texSize.x) * invW, (texBase.y + texSize.y) * invH}, color);
+	} else {
+		DrawUV(textureHandle, pos, size, {0.0f, 0.0f}, {1.0f, 1.0f}, color);
+	}
+}
+
+void SpriteBatch::DrawUV(uint32_t textureHandle, const Vector2& pos, const Vector2& size, const Vector2& uvMin, const Vector2& uvMax, const Vector4& color) {
+	assert(commandList_);
+	if (quads_.size() >= maxQuads_) {
+		stats_.dropped++;
+		return;
+	}
+	quads_.push_back({textureHandle, pos, size, uvMin, uvMax, color});
+}
+
+void SpriteBatch::End() {
+	assert(commandList_);
+	ID3D12GraphicsCommandList* commandList = commandList_;
+	commandList_ = nullptr;
+
+	stats_.quads = static_cast<uint32_t>(quads_.size());
+	if (quads_.empty())
+		return;
+
+	// テクスチャごとの矩形数を数え、出現順に並べる
+	textures_.clear();
+	for (const Quad& q : quads_) {
+		TextureSlot* slot = nullptr;
+		for (TextureSlot& t : textures_) {
+			if (t.handle == q.textureHandle) {
+				slot = &t;
+				break;
+			}
+		}
+		if (slot)
+			slot->count++;
+		else
+			textures_.push_back({q.textureHandle, 1u, 0u});
+	}
+	uint32_t first = 0u;
+	for (TextureSlot& t : textures_) {
+		t.first = first;
+		first += t.count;
+		t.count = 0u; // 書き込み位置として使い直す
+	}
+
+	// 頂点と行列をフレーム用領域へ書き込む
+	ConstantBufferAllocator* cbAllocator = ConstantBufferAllocator::GetInstance();
+	ConstantBufferAllocator::Allocation matrixCB = cbAllocator->Push(MakeScreenToClipMatrix());
+	ConstantBufferAllocator::Allocation vertexCB = cbAllocator->Allocate(sizeof(Vertex) * 4u * quads_.size());
+	if (!matrixCB.IsValid() || !vertexCB.IsValid()) {
+		stats_.dropped += stats_.quads;
+		quads_.clear();
+		return;
+	}
+
+	Vertex* vertices = static_cast<Vertex*>(vertexCB.cpu);
+	for (const Quad& q : quads_) {
+		TextureSlot* slot = nullptr;
+		for (TextureSlot& t : textures_) {
+			if (t.handle == q.textureHandle) {
+				slot = &t;
+				break;
+			}
+		}
+		Vertex* v = vertices + (slot->first + slot->count++) * 4u;
+		const float l = q.pos.x;
+		const float t = q.pos.y;
+		const float r = q.pos.x + q.size.x;
+		const float b = q.pos.y + q.size.y;
+		v[0] = {{l, b, 0.0f}, {q.uvMin.x, q.uvMax.y}, q.color}; // 左下
+		v[1] = {{l, t, 0.0f}, {q.uvMin.x, q.uvMin.y}, q.color}; // 左上
+		v[2] = {{r, b, 0.0f}, {q.uvMax.x, q.uvMax.y}, q.color}; // 右下
+		v[3] = {{r, t, 0.0f}, {q.uvMax.x, q.uvMin.y}, q.color}; // 右上
+	}
+
+	D3D12_VERTEX_BUFFER_VIEW vbView{};
+	vbView.BufferLocation = vertexCB.gpu;
+	vbView.SizeInBytes = static_cast<UINT>(sizeof(Vertex) * 4u * quads_.size());
+	vbView.StrideInBytes = sizeof(Vertex);
+
+	// 共通設定は1回だけ
+	commandList->SetPipelineState(sPipelineStates[static_cast<size_t>(blendMode_)].Get());
+	commandList->SetGraphicsRootSignature(sRootSignature.Get());
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList->IASetVertexBuffers(0, 1, &vbView);
+	commandList->IASetIndexBuffer(&sIBView);
+	commandList->SetGraphicsRootConstantBufferView(kRootMatrix, matrixCB.gpu);
+
+	// テクスチャごとに1回
+	TextureManager* textureManager = TextureManager::GetInstance();
+	for (const TextureSlot& t : textures_) {
+		textureManager->SetGraphicsRootDescriptorTable(commandList, kRootTexture, t.handle);
+		commandList->DrawIndexedInstanced(t.count * 6u, 1, 0, static_cast<INT>(t.first * 4u), 0);
+		stats_.draws++;
+	}
+
+	quads_.clear();
+}
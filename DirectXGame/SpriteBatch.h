@@ -0,0 +1,75 @@
+#pragma once
+#include <KamataEngine.h>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// テクスチャ付き矩形をためて、テクスチャごとに1回の描画で発行するスプライトバッチ
+// ・頂点はフレーム用定数バッファ領域（アップロードヒープ）へ毎回書き込むので Sprite ごとのバッファを持たない
+// ・End でテクスチャ別に並べ替えて発行する（同じバッチ内で重なる矩形はテクスチャをまたいで前後しうる）
+// ・Begin ～ End の間に Sprite::PreDraw / Model::PreDraw を挟まない
+class SpriteBatch {
+public:
+	// 頂点（スクリーン座標・UV・色）
+	struct Vertex {
+		Vector3 pos;
+		Vector2 uv;
+		Vector4 color;
+	};
+
+	// 発行結果の統計（1フレーム分）
+	struct Stats {
+		uint32_t quads = 0u;   // 積まれた矩形数
+		uint32_t draws = 0u;   // 発行した描画数
+		uint32_t dropped = 0u; // 容量不足で描けなかった矩形数
+	};
+
+	// 1バッチで扱える最大矩形数（インデックスは16bit）
+	static const uint32_t kMaxQuads = 4096u;
+
+	// 想定矩形数で作業領域を確保
+	void Initialize(uint32_t maxQuads);
+
+	// 積み始め
+	void Begin(ID3D12GraphicsCommandList* commandList, Sprite::BlendMode blendMode = Sprite::BlendMode::kNormal);
+
+	// 矩形を積む（pos は左上、texSize が 0 ならテクスチャ全体）
+	void Draw(uint32_t textureHandle, const Vector2& pos, const Vector2& size, const Vector4& color = {1.0f, 1.0f, 1.0f, 1.0f}, const Vector2& texBase = {0.0f, 0.0f}, const Vector2& texSize = {0.0f, 0.0f});
+
+	// UV 計算済みの矩形を積む（文字キャッシュなど）
+	void DrawUV(uint32_t textureHandle, const Vector2& pos, const Vector2& size, const Vector2& uvMin, const Vector2& uvMax, const Vector4& color = {1.0f, 1.0f, 1.0f, 1.0f});
+
+	// テクスチャ別にまとめて発行する
+	void End();
+
+	// 直近の Begin ～ End の統計
+	const Stats& GetStats() const { return stats_; }
+
+private:
+	struct Quad {
+		uint32_t textureHandle;
+		Vector2 pos;
+		Vector2 size;
+		Vector2 uvMin;
+		Vector2 uvMax;
+		Vector4 color;
+	};
+
+	// 描画に使うテクスチャ（フレーム内で少数なので線形探索）
+	struct TextureSlot {
+		uint32_t handle;
+		uint32_t count;
+		uint32_t first;
+	};
+
+	ID3D12GraphicsCommandList* commandList_ = nullptr;
+	Sprite::BlendMode blendMode_ = Sprite::BlendMode::kNormal;
+	uint32_t maxQuads_ = 0u;
+	std::vector<Quad> quads_;
+	std::vector<TextureSlot> textures_;
+	Stats stats_;
+
+	// 共有するルートシグネチャ・パイプライン・インデックスバッファを初回だけ作る
+	static void StaticInitialize();
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 固定長の単一生産者・単一消費者キュー（ロックなし・確保なし）
+// ・Push は生産者スレッドだけ、Pop は消費者スレッドだけが呼ぶ
+// ・Capacity は 2 のべき乗。満杯なら Push は false を返す（上書きしない）
+// ・相手側の位置は手元に写しておき、写しで足りないときだけ読みに行く（キャッシュラインの行き来を減らす）
+template<class T, size_t Capacity> class SpscQueue {
+	static_assert(Capacity >= 2u && (Capacity & (Capacity - 1u)) == 0u, "SpscQueue capacity must be a power of two");
+
+public:
+	bool Push(const T& value) {
+		const size_t head = head_.load(std::memory_order_relaxed);
+		if (head - tailCache_ == Capacity) {
+			tailCache_ = tail_.load(std::memory_order_acquire);
+			if (head - tailCache_ == Capacity)
+				return false;
+		}
+		items_[head & (Capacity - 1u)] = value;
+		head_.store(head + 1u, std::memory_order_release);
+		return true;
+	}
+
+	bool Pop(T& out) {
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail == headCache_) {
+			headCache_ = head_.load(std::memory_order_acquire);
+			if (tail == headCache_)
+				return false;
+		}
+		out = items_[tail & (Capacity - 1u)];
+		tail_.store(tail + 1u, std::memory_order_release);
+		return true;
+	}
+
+private:
+	// 生産者側と消費者側の間は 64 バイト空けて、別のキャッシュラインに乗せる
+	// alignas(64) だと詰め物の警告（C4324）が出て、/WX の Level4 で通らないので、詰め物は手で置く
+	// （先頭がどこに来ても、塊どうしの間が 64 バイトあれば同じラインには乗らない）
+	char padFront_[64] = {};
+	// 生産者側
+	std::atomic<size_t> head_{0u};
+	size_t tailCache_ = 0u;
+	char padProducer_[64] = {};
+	// 消費者側
+	std::atomic<size_t> tail_{0u};
+	size_t headCache_ = 0u;
+	char padConsumer_[64] = {};
+
+	std::array<T, Capacity> items_{};
+};
@@ -0,0 +1,220 @@
+#include "StreamingVoice.h"
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstring>
+
+bool StreamingVoice::Play(const std::string& filename, std::unique_ptr<AudioSink> sink, bool loop, float volume) {
+	Stop();
+	if (!sink || !OpenSource("Resources/" + filename))
+		return false;
+
+	bufferBytes_ = kBufferBytes - kBufferBytes % format_.blockAlign;
+	if (bufferBytes_ == 0u) {
+		CloseSource();
+		return false;
+	}
+	ring_.assign(bufferBytes_ * kBufferCount, 0u);
+	loop_ = loop;
+	cursor_ = 0u;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		submitted_ = 0u;
+		completed_ = 0u;
+		lastSubmitted_ = false;
+		playing_ = true;
+		quit_ = false;
+		stats_ = {};
+	}
+
+	sink_ = std::move(sink);
+	if (!sink_->Open(format_, [this]() { OnBufferEnd(); })) {
+		Stop();
+		return false;
+	}
+	sink_->SetVolume(volume);
+
+	// 全部埋めてから鳴らし始める（始まってすぐ尽きないように）
+	for (uint32_t i = 0; i < kBufferCount; ++i) {
+		if (!SubmitNext())
+			break;
+	}
+	sink_->Start();
+	thread_ = std::thread(&StreamingVoice::ThreadMain, this);
+	return true;
+}
+
+void StreamingVoice::Stop() {
+	if (thread_.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			quit_ = true;
+		}
+		wake_.notify_one();
+		thread_.join();
+	}
+	// 出力先を閉じてからバッファを捨てる（閉じるまでは再生中のバッファを読まれる）
+	if (sink_) {
+		sink_->Stop();
+		sink_->Close();
+		sink_.reset();
+	}
+	CloseSource();
+	ring_.clear();
+	ring_.shrink_to_fit();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	playing_ = false;
+}
+
+bool StreamingVoice::IsPlaying() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return playing_;
+}
+
+void StreamingVoice::SetVolume(float volume) {
+	if (sink_)
+		sink_->SetVolume(volume);
+}
+
+StreamingVoice::Stats StreamingVoice::GetStats() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return stats_;
+}
+
+bool StreamingVoice::OpenSource(const std::string& path) {
+	CloseSource();
+
+	// パックに無圧縮で入っていればマップ上をそのまま読む
+	AssetPack* pack = AssetPack::GetInstance();
+	WaveView wave;
+	std::span<const uint8_t> view = pack->View(path);
+	if (view.empty() && pack->Contains(path)) {
+		// 圧縮されて入っているものは展開するしかない（PackBuilder は .wav を圧縮しない）
+		if (!pack->Load(path, storage_, view))
+			return false;
+	}
+	if (!view.empty()) {
+		if (!ParseWave(view, wave))
+			return false;
+		format_ = wave.format;
+		mapped_ = wave.samples;
+		dataOffset_ = 0u;
+		dataSize_ = static_cast<uint32_t>(mapped_.size());
+	} else {
+		file_ = std::fopen(path.c_str(), "rb");
+		if (!file_ || !ParseWaveFile(file_, format_, dataOffset_, dataSize_)) {
+			CloseSource();
+			return false;
+		}
+	}
+
+	// 途中で切れたブロックは鳴らさない
+	dataSize_ -= dataSize_ % format_.blockAlign;
+	if (dataSize_ == 0u) {
+		CloseSource();
+		return false;
+	}
+	return true;
+}
+
+void StreamingVoice::CloseSource() {
+	if (file_) {
+		std::fclose(file_);
+		file_ = nullptr;
+	}
+	mapped_ = {};
+	storage_.clear();
+	storage_.shrink_to_fit();
+	dataOffset_ = 0u;
+	dataSize_ = 0u;
+	cursor_ = 0u;
+}
+
+size_t StreamingVoice::Fill(uint8_t* dst, size_t capacity, uint32_t& loops) {
+	size_t filled = 0u;
+	while (filled < capacity) {
+		if (cursor_ == dataSize_) {
+			if (!loop_)
+				break;
+			cursor_ = 0u;
+			loops++;
+			if (file_ && std::fseek(file_, static_cast<long>(dataOffset_), SEEK_SET) != 0)
+				break;
+		}
+
+		const size_t n = std::min(capacity - filled, static_cast<size_t>(dataSize_ - cursor_));
+		if (file_) {
+			if (std::fread(dst + filled, 1, n, file_) != n)
+				break;
+		} else {
+			std::memcpy(dst + filled, mapped_.data() + cursor_, n);
+		}
+		cursor_ += static_cast<uint32_t>(n);
+		filled += n;
+	}
+	return filled;
+}
+
+bool StreamingVoice::SubmitNext() {
+	uint8_t* buffer = nullptr;
+	{
+		// 輪の次の枠は submitted_ - kBufferCount 番目のバッファ（再生し終えているもの）
+		std::lock_guard<std::mutex> lock(mutex_);
+		buffer = ring_.data() + bufferBytes_ * (submitted_ % kBufferCount);
+	}
+
+	uint32_t loops = 0u;
+	const size_t size = Fill(buffer, bufferBytes_, loops);
+	// 埋めきれなかったのは、ループしないものの終わりか読み込みの失敗。どちらもここで終わりにする
+	const bool last = size < bufferBytes_ || (!loop_ && cursor_ == dataSize_);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.bytesRead += size;
+		stats_.loops += loops;
+		if (size == 0u) {
+			lastSubmitted_ = true;
+			playing_ = completed_ != submitted_;
+			return false;
+		}
+		submitted_++;
+		stats_.buffersSubmitted++;
+		lastSubmitted_ = last;
+	}
+
+	if (!sink_->Submit(buffer, size, last)) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		submitted_--;
+		stats_.buffersSubmitted--;
+		lastSubmitted_ = true;
+		playing_ = completed_ != submitted_;
+		return false;
+	}
+	return !last;
+}
+
+void StreamingVoice::OnBufferEnd() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		completed_++;
+		if (completed_ == submitted_) {
+			if (lastSubmitted_)
+				playing_ = false;
+			else
+				stats_.underruns++;
+		}
+	}
+	wake_.notify_one();
+}
+
+void StreamingVoice::ThreadMain() {
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			wake_.wait(lock, [this]() { return quit_ || (!lastSubmitted_ && submitted_ - completed_ < kBufferCount); });
+			if (quit_)
+				return;
+		}
+		SubmitNext();
+	}
+}
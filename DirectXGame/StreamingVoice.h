@@ -0,0 +1,88 @@
+#pragma once
+#include "AudioSink.h"
+#include "WaveFile.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// WAV を小分けに読みながら鳴らすボイス（BGM 用。Audio::LoadWave のように全体をメモリに載せない）
+// ・kBufferBytes のバッファ kBufferCount 個を輪にして、再生し終えたものから裏のスレッドで埋め直して出力先へ渡す
+// ・読み出し元はアセットパックに無圧縮で入っていればマップ上、なければファイル（data チャンクだけを順に読む）
+// ・ループは末尾に続けて先頭を同じバッファへ詰めるので、継ぎ目に隙間ができない
+// ・出力先は AudioSink（ゲームは XAudio2Sink、Linux での確認は NullAudioSink）
+// ・Play / Stop / SetVolume はメインスレッドから呼ぶ
+class StreamingVoice {
+public:
+	static const size_t kBufferBytes = 64u * 1024u;
+	static const uint32_t kBufferCount = 3u;
+
+	// 再生の統計（Stop しても次の Play まで残る）
+	struct Stats {
+		uint64_t bytesRead = 0u;        // 読み出し元から読んだバイト数
+		uint32_t buffersSubmitted = 0u; // 出力先へ渡したバッファ数
+		uint32_t loops = 0u;            // 先頭へ戻った回数
+		uint32_t underruns = 0u;        // 再生中に渡したバッファが尽きた回数
+	};
+
+	StreamingVoice() = default;
+	~StreamingVoice() { Stop(); }
+	StreamingVoice(const StreamingVoice&) = delete;
+	StreamingVoice& operator=(const StreamingVoice&) = delete;
+
+	// filename は Audio::LoadWave と同じく Resources/ からのパス。開けなければ false（無音のまま）
+	bool Play(const std::string& filename, std::unique_ptr<AudioSink> sink, bool loop = false, float volume = 1.0f);
+
+	// 再生を止めてスレッドと出力先を片付ける（何度呼んでもよい）
+	void Stop();
+
+	// 鳴っている間 true（ループしないものは最後のバッファを再生し終えたら false）
+	bool IsPlaying() const;
+
+	void SetVolume(float volume);
+
+	const WaveFormat& GetFormat() const { return format_; }
+	Stats GetStats() const;
+
+private:
+	bool OpenSource(const std::string& path);
+	void CloseSource();
+
+	// 読み出し元の cursor_ から詰める（ループなら先頭へ戻って続ける）。詰めたバイト数を返す
+	size_t Fill(uint8_t* dst, size_t capacity, uint32_t& loops);
+	// 1つ埋めて出力先へ渡す。最後のバッファなら false
+	bool SubmitNext();
+
+	void OnBufferEnd();
+	void ThreadMain();
+
+	std::unique_ptr<AudioSink> sink_;
+	WaveFormat format_;
+
+	// 読み出し元（file_ がなければ mapped_）
+	std::span<const uint8_t> mapped_;
+	std::vector<uint8_t> storage_; // パックに圧縮して入っていたときだけ展開先
+	FILE* file_ = nullptr;
+	uint64_t dataOffset_ = 0u;
+	uint32_t dataSize_ = 0u;
+	uint32_t cursor_ = 0u;
+	bool loop_ = false;
+
+	std::vector<uint8_t> ring_; // kBufferCount 個ぶん
+	size_t bufferBytes_ = 0u;   // blockAlign の倍数に切り下げた1個の大きさ
+
+	std::thread thread_;
+	mutable std::mutex mutex_;
+	std::condition_variable wake_;
+	uint32_t submitted_ = 0u; // 以下 mutex_ で守る
+	uint32_t completed_ = 0u;
+	bool lastSubmitted_ = false;
+	bool playing_ = false;
+	bool quit_ = false;
+	Stats stats_;
+};
@@ -0,0 +1,20 @@
+#include "TextureAtlas.h"
+#include "TextureFile.h"
+#include <cassert>
+
+using namespace KamataEngine;
+
+void TextureAtlas::Initialize(const std::string& textureFile, const AtlasRect* rects, size_t count) {
+	assert(rects && count > 0u);
+	textureHandle_ = LoadTextureShared(textureFile);
+	rects_ = rects;
+	count_ = count;
+}
+
+const AtlasRect* TextureAtlas::Find(const std::string& name) const {
+	for (size_t i = 0; i < count_; ++i) {
+		if (name == rects_[i].name)
+			return &rects_[i];
+	}
+	return nullptr;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <KamataEngine.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace KamataEngine;
+
+// アトラス内の1画像（ピクセル矩形）。表は Tools/AtlasPacker が生成する
+struct AtlasRect {
+	const char* name;
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+	uint32_t height;
+};
+
+// 1枚のテクスチャに詰めた画像群の参照
+// ・生成された矩形表（UiAtlas.h など）とテクスチャを結び付け、ID / 名前で切り出し範囲を返す
+class TextureAtlas {
+public:
+	void Initialize(const std::string& textureFile, const AtlasRect* rects, size_t count);
+
+	uint32_t GetTextureHandle() const { return textureHandle_; }
+
+	// ID（生成ヘッダの enum）で引く
+	const AtlasRect& GetRect(uint32_t id) const { return rects_[id]; }
+
+	// 名前で引く（見つからなければ nullptr）
+	const AtlasRect* Find(const std::string& name) const;
+
+	// 画像 id 内の座標（ピクセル）→ アトラス上の座標
+	Vector2 ToAtlas(uint32_t id, const Vector2& local) const {
+		const AtlasRect& r = rects_[id];
+		return {static_cast<float>(r.x) + local.x, static_cast<float>(r.y) + local.y};
+	}
+
+	// 画像 id 全体の左上と大きさ（ピクセル）
+	Vector2 GetBase(uint32_t id) const { return ToAtlas(id, {0.0f, 0.0f}); }
+	Vector2 GetSize(uint32_t id) const { return {static_cast<float>(rects_[id].width), static_cast<float>(rects_[id].height)}; }
+
+private:
+	uint32_t textureHandle_ = 0u;
+	const AtlasRect* rects_ = nullptr;
+	size_t count_ = 0u;
+};
@@ -0,0 +1,157 @@
+#include "TextureFile.h"
+#include "AssetPack.h"
+#include "Hash.h"
+#include <KamataEngine.h>
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 同じ名前を何度も調べないよう結果を覚えておく（ワーカーからも呼ばれる）
+std::mutex gMutex;
+std::once_flag gDefaultOnce;
+std::unordered_map<std::string, std::string> gCompressed; // 名前 → 圧縮版を優先した名前
+
+// 内容での名寄せ
+struct Content {
+	std::string canonical;          // 最初に見た名前
+	uint64_t fileBytes = 0u;
+	std::vector<std::string> alias; // 寄せられた名前
+};
+std::unordered_map<std::string, std::string> gCanonical; // 名前 → 寄せ先
+std::unordered_map<uint64_t, Content> gContents;         // 内容ハッシュ → 実体
+
+// LoadTextureShared で読んだもの（集計はこれを足すだけで、TextureManager には触らない）
+struct Loaded {
+	uint32_t handle = 0u;
+	uint64_t gpuBytes = 0u; // 最上段のみの概算
+};
+std::unordered_map<std::string, Loaded> gLoaded; // 寄せ先の名前 → 読んだ結果
+
+std::string PreferCompressedLocked(const std::string& fileName) {
+	const size_t dot = fileName.find_last_of('.');
+	if (dot == std::string::npos || fileName.compare(dot, std::string::npos, ".dds") == 0)
+		return fileName;
+
+	auto it = gCompressed.find(fileName);
+	if (it != gCompressed.end())
+		return it->second;
+
+	const std::string dds = fileName.substr(0, dot) + ".dds";
+	std::error_code ec;
+	const std::string& resolved = std::filesystem::exists("Resources/" + dds, ec) ? dds : fileName;
+	gCompressed.emplace(fileName, resolved);
+	return resolved;
+}
+
+// 名寄せ。ファイルの読み込みとハッシュはロックの外でする（ワーカーの読み込みでメインスレッドを待たせない）
+std::string Canonicalize(const std::string& fileName) {
+	std::string resolved;
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		auto it = gCanonical.find(fileName);
+		if (it != gCanonical.end())
+			return it->second;
+		resolved = PreferCompressedLocked(fileName);
+	}
+
+	std::vector<uint8_t> storage;
+	std::span<const uint8_t> bytes;
+	const bool read = AssetPack::GetInstance()->Load("Resources/" + resolved, storage, bytes);
+	const uint64_t hash = read ? HashBytes(bytes.data(), bytes.size()) : 0u;
+
+	std::lock_guard<std::mutex> lock(gMutex);
+	// 読んでいる間にほかのスレッドが同じ名前を済ませていれば、そちらに合わせる
+	auto it = gCanonical.find(fileName);
+	if (it != gCanonical.end())
+		return it->second;
+	if (!read) {
+		gCanonical.emplace(fileName, resolved); // 読めないものはそのまま（エンジン側のエラーに任せる）
+		return resolved;
+	}
+
+	Content& content = gContents[hash];
+	if (content.canonical.empty()) {
+		content.canonical = resolved;
+		content.fileBytes = bytes.size();
+	} else if (content.canonical != resolved && std::find(content.alias.begin(), content.alias.end(), resolved) == content.alias.end()) {
+		content.alias.push_back(resolved); // 別の名前から同じファイルに解決されたときは1つと数える
+	}
+	gCanonical.emplace(fileName, content.canonical);
+	return content.canonical;
+}
+
+// テクセルあたりのバイト数（概算）
+double BytesPerTexel(DXGI_FORMAT format) {
+	switch (format) {
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+		return 0.5;
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return 1.0;
+	default:
+		return 4.0;
+	}
+}
+
+} // namespace
+
+std::string PreferCompressedTexture(const std::string& fileName) {
+	std::lock_guard<std::mutex> lock(gMutex);
+	return PreferCompressedLocked(fileName);
+}
+
+std::string CanonicalTexture(const std::string& fileName) {
+	// エンジンが初期化時に読む既定テクスチャを先に登録しておく（同じ中身の白テクスチャはこれに寄せる）
+	std::call_once(gDefaultOnce, [] { Canonicalize("white1x1.png"); });
+	return Canonicalize(fileName);
+}
+
+uint32_t LoadTextureShared(const std::string& fileName) {
+	const std::string canonical = CanonicalTexture(fileName);
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		auto it = gLoaded.find(canonical);
+		if (it != gLoaded.end())
+			return it->second.handle;
+	}
+
+	// 読み込みはロックの外で（ワーカーの CanonicalTexture を待たせない）
+	Loaded loaded;
+	loaded.handle = TextureManager::Load(canonical);
+	const D3D12_RESOURCE_DESC desc = TextureManager::GetInstance()->GetResoureDesc(loaded.handle);
+	loaded.gpuBytes = static_cast<uint64_t>(static_cast<double>(desc.Width) * desc.Height * BytesPerTexel(desc.Format));
+
+	std::lock_guard<std::mutex> lock(gMutex);
+	gLoaded.emplace(canonical, loaded);
+	return loaded.handle;
+}
+
+TextureDedupStats GetTextureDedupStats() {
+	std::lock_guard<std::mutex> lock(gMutex);
+	TextureDedupStats stats;
+	stats.files = static_cast<uint32_t>(gCanonical.size());
+	stats.unique = static_cast<uint32_t>(gContents.size());
+	for (const auto& entry : gContents) {
+		const Content& content = entry.second;
+		if (content.alias.empty())
+			continue;
+		const uint32_t saved = static_cast<uint32_t>(content.alias.size());
+		stats.descriptorsSaved += saved;
+		stats.fileBytesSaved += content.fileBytes * saved;
+
+		// まだ GPU に読んでいないものは数えない
+		auto it = gLoaded.find(content.canonical);
+		if (it != gLoaded.end())
+			stats.gpuBytesSaved += it->second.gpuBytes * saved;
+	}
+	return stats;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// テクスチャのファイル名解決
+// ・Tools/TextureCompressor が作った圧縮版（同じ場所・同じ名前の .dds）があればそちらを使う
+// ・ファイルの中身（XXH64）が同じものは最初に見た名前へ寄せ、GPU リソースと SRV を1つにする
+// ・fileName は TextureManager::Load に渡す名前（Resources/ からの相対パス）
+std::string PreferCompressedTexture(const std::string& fileName);
+
+// 圧縮版の優先 + 内容での名寄せをした名前（ワーカーからも呼べる）
+std::string CanonicalTexture(const std::string& fileName);
+
+// CanonicalTexture した名前で TextureManager::Load する（メインスレッド）
+uint32_t LoadTextureShared(const std::string& fileName);
+
+// 名寄せの結果
+struct TextureDedupStats {
+	uint32_t files = 0u;            // 調べたファイル名の数
+	uint32_t unique = 0u;           // 中身の種類
+	uint32_t descriptorsSaved = 0u; // 寄せたことで使わずに済んだ SRV
+	uint64_t fileBytesSaved = 0u;   // 読まずに済んだファイルのバイト数
+	uint64_t gpuBytesSaved = 0u;    // 確保せずに済んだ GPU メモリ（最上段のみの概算）
+};
+
+// 集計（LoadTextureShared で読んだときに覚えた値を足すだけ。どのスレッドからでも呼べる）
+TextureDedupStats GetTextureDedupStats();
@@ -0,0 +1,398 @@
+#include "TileMap.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const uint64_t kAllBits = ~0ull;
+
+// 行 row の [x, end) で最初に立っているビット（invert = kAllBits なら立っていないビット）。なければ end
+int32_t FindForward(const uint64_t* row, int32_t x, int32_t end, uint64_t invert) {
+	if (x >= end)
+		return end;
+	int32_t w = x >> 6;
+	const int32_t lastWord = (end - 1) >> 6;
+	uint64_t word = (row[w] ^ invert) & (kAllBits << (x & 63));
+	while (word == 0u) {
+		if (++w > lastWord)
+			return end;
+		word = row[w] ^ invert;
+	}
+	const int32_t found = (w << 6) + std::countr_zero(word);
+	return found < end ? found : end;
+}
+
+// 行 row の [begin, x] で最後に立っているビット。なければ begin - 1
+int32_t FindBackward(const uint64_t* row, int32_t x, int32_t begin, uint64_t invert) {
+	if (x < begin)
+		return begin - 1;
+	int32_t w = x >> 6;
+	const int32_t firstWord = begin >> 6;
+	uint64_t word = (row[w] ^ invert) & (kAllBits >> (63 - (x & 63)));
+	while (word == 0u) {
+		if (--w < firstWord)
+			return begin - 1;
+		word = row[w] ^ invert;
+	}
+	const int32_t found = (w << 6) + 63 - std::countl_zero(word);
+	return found >= begin ? found : begin - 1;
+}
+
+// row の x マス目から count マスぶん（64 以下）に bits を書く
+void PutBits(uint64_t* row, uint32_t x, uint64_t bits, uint32_t count) {
+	const uint32_t shift = x & 63u;
+	row[x >> 6] |= bits << shift;
+	if (shift + count > 64u)
+		row[(x >> 6) + 1u] |= bits >> (64u - shift);
+}
+
+// TILEMAP_NO_SWAR を定義すると1セルずつだけで読む（Tools/TileBench で比べる用）
+#ifndef TILEMAP_NO_SWAR
+// 「d,d,d,d,」（d は 0 か 1）の 8 バイトなら 4 マスぶんのビットを下位 4bit に返す。違えば -1
+// リトルエンディアン前提（x64 / ARM64）
+int32_t ReadFourCells(const uint8_t* p) {
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	if ((v & 0xFF00FF00FF00FF00ull) != 0x2C002C002C002C00ull || (v & 0x00FE00FE00FE00FEull) != 0x0030003000300030ull)
+		return -1;
+	// 各数字の最下位ビット（0, 16, 32, 48 ビット目）を掛け算で 48 ～ 51 ビット目へ集める（桁は重ならない）
+	return int32_t((((v & 0x0001000100010001ull) * 0x0001000200040008ull) >> 48) & 0xFu);
+}
+#endif
+
+bool IsBlank(uint8_t c) { return c == ' ' || c == '\t'; }
+
+// 線分 (u0, v0) + (du, dv) * t の [tEnter, tExit] の部分が通るマスを、v の1行ずつまとめて調べる（行 v は lines + v * wordsPerLine）
+// |du| >= |dv| の向きで呼ぶと、1行で u に 1 マス以上進む。当たりは hit に (u, v) の順で書く
+// invU / invV は 1 / du・1 / dv（割り算は Raycast で1回ずつだけ）
+bool WalkLines(const uint64_t* lines, uint32_t wordsPerLine, int32_t length, int32_t count, float u0, float v0, float du, float dv, float invU, float invV, float tEnter,
+               float tExit, int32_t enterAxis, TileMap::RayHit* hit) {
+	const int32_t stepU = du > 0.0f ? 1 : (du < 0.0f ? -1 : 0);
+	const int32_t stepV = dv > 0.0f ? 1 : (dv < 0.0f ? -1 : 0);
+	int32_t cu = std::clamp(static_cast<int32_t>(std::floor(u0 + du * tEnter)), 0, length - 1);
+	int32_t cv = std::clamp(static_cast<int32_t>(std::floor(v0 + dv * tEnter)), 0, count - 1);
+
+	// i 回目に行の境目を越える t は tV0 + i * tDeltaV（積み上げずに毎回この式で出す）
+	const float kInfinity = std::numeric_limits<float>::infinity();
+	const float tDeltaV = stepV ? std::abs(invV) : kInfinity;
+	const float tV0 = stepV ? (float(stepV > 0 ? cv + 1 : cv) - v0) * invV : kInfinity;
+	const float maxU = float(length);
+
+	// 今いるマスに入った t と面
+	float tCell = tEnter;
+	int32_t normalU = enterAxis == 0 ? -stepU : 0;
+	int32_t normalV = enterAxis == 1 ? -stepV : 0;
+
+	for (int32_t iv = 0;; ++iv) {
+		// この行を出る（または線分が終わる）ところの u から、行の中で通るマス [cu, uEnd] を出す
+		// ちょうど境目で出るときは、その先のマスには入らない（角を通るときは行の移りが先）
+		const float tV = stepV ? tV0 + float(iv) * tDeltaV : kInfinity;
+		int32_t uEnd = cu;
+		if (stepU) {
+			const float uOut = std::clamp(u0 + du * (std::min)(tV, tExit), 0.0f, maxU);
+			const int32_t whole = static_cast<int32_t>(uOut); // 0 以上なので切り捨て = floor
+			uEnd = stepU > 0 ? (std::max)(cu, (std::min)(whole - (float(whole) == uOut ? 1 : 0), length - 1)) : (std::min)(cu, whole);
+		}
+
+		// その範囲をワード単位で調べ、進む向きで最初の埋まりマスを引く
+		const uint64_t* line = lines + size_t(cv) * wordsPerLine;
+		const int32_t found = stepU >= 0 ? FindForward(line, cu, uEnd + 1, 0u) : FindBackward(line, cu, uEnd, 0u);
+		if (stepU >= 0 ? found <= uEnd : found >= uEnd) {
+			if (hit) {
+				hit->x = found;
+				hit->y = cv;
+				if (found == cu) {
+					hit->t = tCell;
+					hit->normalX = normalU;
+					hit->normalY = normalV;
+				} else {
+					// 行の中で横から入った：そのマスの手前の境目を越える t
+					hit->t = (float(stepU > 0 ? found : found + 1) - u0) * invU;
+					hit->normalX = -stepU;
+					hit->normalY = 0;
+				}
+			}
+			return true;
+		}
+		if (tV >= tExit)
+			return false;
+
+		// 次の行へ
+		cu = uEnd;
+		tCell = tV;
+		normalU = 0;
+		normalV = -stepV;
+		cv += stepV;
+		if (cv < 0 || cv >= count)
+			return false;
+	}
+}
+
+} // namespace
+
+bool TileMap::Parse(std::span<const uint8_t> text) {
+	width_ = height_ = wordsPerRow_ = wordsPerColumn_ = 0u;
+	bits_.clear();
+	columns_.clear();
+
+	const uint8_t* p = text.data();
+	const uint8_t* end = p + text.size();
+	if (end - p >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF)
+		p += 3; // BOM
+	while (p < end && (*p == '\r' || *p == '\n'))
+		++p;
+
+	// 幅は最初の行のカンマの数から、行数は改行の数から見積もって先に確保する
+	const uint8_t* firstEnd = static_cast<const uint8_t*>(std::memchr(p, '\n', end - p));
+	if (!firstEnd)
+		firstEnd = end;
+	const uint32_t width = static_cast<uint32_t>(std::count(p, firstEnd, ',')) + 1u;
+	const uint32_t wordsPerRow = (width + 63u) / 64u;
+	bits_.reserve((static_cast<size_t>(std::count(p, end, '\n')) + 1u) * wordsPerRow);
+
+	uint32_t height = 0u;
+	while (p < end) {
+		// 空行は飛ばす
+		if (*p == '\r' || *p == '\n') {
+			++p;
+			continue;
+		}
+
+		bits_.resize(bits_.size() + wordsPerRow, 0u);
+		uint64_t* row = bits_.data() + size_t(height) * wordsPerRow;
+		uint32_t x = 0u;
+		for (;;) {
+#ifndef TILEMAP_NO_SWAR
+			// 後ろにまだセルが続くあいだは 4 マスずつ
+			while (x + 5u <= width && end - p >= 8) {
+				const int32_t four = ReadFourCells(p);
+				if (four < 0)
+					break;
+				PutBits(row, x, uint64_t(four), 4u);
+				p += 8;
+				x += 4u;
+			}
+#endif
+			// 1セル（前後の空白と、複数桁・0 以外の値も読む）
+			while (p < end && IsBlank(*p))
+				++p;
+			if (p == end || *p < '0' || *p > '9' || x >= width) {
+				bits_.clear();
+				return false;
+			}
+			bool solid = false;
+			while (p < end && *p >= '0' && *p <= '9')
+				solid |= *p++ != '0';
+			while (p < end && IsBlank(*p))
+				++p;
+			if (solid)
+				PutBits(row, x, 1u, 1u);
+			++x;
+
+			if (p < end && *p == ',') {
+				++p;
+				continue;
+			}
+			if (p == end || *p == '\r' || *p == '\n')
+				break;
+			bits_.clear();
+			return false;
+		}
+		if (x != width) {
+			bits_.clear();
+			return false;
+		}
+		++height;
+	}
+
+	if (height == 0u) {
+		bits_.clear();
+		return false;
+	}
+	width_ = width;
+	height_ = height;
+	wordsPerRow_ = wordsPerRow;
+	BuildColumns();
+	return true;
+}
+
+void TileMap::Reset(uint32_t width, uint32_t height) {
+	width_ = width;
+	height_ = height;
+	wordsPerRow_ = (width + 63u) / 64u;
+	bits_.assign(size_t(height) * wordsPerRow_, 0u);
+	BuildColumns();
+}
+
+void TileMap::Set(int32_t x, int32_t y, bool solid) {
+	if (x < 0 || y < 0 || uint32_t(x) >= width_ || uint32_t(y) >= height_)
+		return;
+	uint64_t& word = Row(y)[x >> 6];
+	const uint64_t bit = 1ull << (x & 63);
+	word = solid ? (word | bit) : (word & ~bit);
+	uint64_t& columnWord = columns_[size_t(x) * wordsPerColumn_ + (y >> 6)];
+	const uint64_t columnBit = 1ull << (y & 63);
+	columnWord = solid ? (columnWord | columnBit) : (columnWord & ~columnBit);
+}
+
+void TileMap::BuildColumns() {
+	wordsPerColumn_ = (height_ + 63u) / 64u;
+	columns_.assign(size_t(width_) * wordsPerColumn_, 0u);
+	// 埋まりマスのビットだけを拾って立てる
+	for (uint32_t y = 0; y < height_; ++y) {
+		const uint64_t* row = Row(static_cast<int32_t>(y));
+		for (uint32_t w = 0; w < wordsPerRow_; ++w) {
+			for (uint64_t word = row[w]; word; word &= word - 1u) {
+				const uint32_t x = (w << 6) + static_cast<uint32_t>(std::countr_zero(word));
+				columns_[size_t(x) * wordsPerColumn_ + (y >> 6)] |= 1ull << (y & 63u);
+			}
+		}
+	}
+}
+
+uint32_t TileMap::CountSolid() const {
+	uint32_t count = 0u;
+	for (uint64_t word : bits_)
+		count += static_cast<uint32_t>(std::popcount(word));
+	return count;
+}
+
+bool TileMap::Raycast(float x0, float y0, float x1, float y1, RayHit* hit) const {
+	if (IsEmpty())
+		return false;
+	const float dx = x1 - x0;
+	const float dy = y1 - y0;
+	const float invX = dx != 0.0f ? 1.0f / dx : 0.0f;
+	const float invY = dy != 0.0f ? 1.0f / dy : 0.0f;
+
+	// マップの箱 [0, width] × [0, height] で線分を切る（外は空きなので中だけ歩けばよい）
+	float tEnter = 0.0f;
+	float tExit = 1.0f;
+	int32_t enterAxis = -1; // 外から入ったときの面（0 = 左右、1 = 上下）
+	auto clip = [&](float origin, float delta, float inv, float size, int32_t axis) {
+		if (delta == 0.0f)
+			return origin >= 0.0f && origin < size;
+		float ta = (0.0f - origin) * inv;
+		float tb = (size - origin) * inv;
+		if (ta > tb)
+			std::swap(ta, tb);
+		if (ta > tEnter) {
+			tEnter = ta;
+			enterAxis = axis;
+		}
+		tExit = (std::min)(tExit, tb);
+		return true;
+	};
+	if (!clip(x0, dx, invX, float(width_), 0) || !clip(y0, dy, invY, float(height_), 1) || tEnter >= tExit)
+		return false;
+
+	// 横に寝ているレイは行の表、立っているレイは列の表をたどる（どちらも1行で長い向きに1マス以上進む）
+	if (std::abs(dx) >= std::abs(dy))
+		return WalkLines(bits_.data(), wordsPerRow_, static_cast<int32_t>(width_), static_cast<int32_t>(height_), x0, y0, dx, dy, invX, invY, tEnter, tExit, enterAxis, hit);
+	const int32_t swappedAxis = enterAxis < 0 ? -1 : 1 - enterAxis;
+	if (!WalkLines(columns_.data(), wordsPerColumn_, static_cast<int32_t>(height_), static_cast<int32_t>(width_), y0, x0, dy, dx, invY, invX, tEnter, tExit, swappedAxis, hit))
+		return false;
+	if (hit) {
+		std::swap(hit->x, hit->y);
+		std::swap(hit->normalX, hit->normalY);
+	}
+	return true;
+}
+
+bool TileMap::OverlapsBox(float minX, float minY, float maxX, float maxY) const {
+	if (IsEmpty())
+		return false;
+	// 先にマップの範囲へ丸めてから整数にする（大きな値でもあふれない）
+	minX = (std::max)(minX, 0.0f);
+	minY = (std::max)(minY, 0.0f);
+	maxX = (std::min)(maxX, float(width_));
+	maxY = (std::min)(maxY, float(height_));
+	if (minX > maxX || minY > maxY)
+		return false;
+	const int32_t x0 = static_cast<int32_t>(std::floor(minX));
+	const int32_t y0 = static_cast<int32_t>(std::floor(minY));
+	const int32_t x1 = (std::min)(static_cast<int32_t>(std::ceil(maxX)) - 1, static_cast<int32_t>(width_) - 1);
+	const int32_t y1 = (std::min)(static_cast<int32_t>(std::ceil(maxY)) - 1, static_cast<int32_t>(height_) - 1);
+	if (x0 > x1 || y0 > y1)
+		return false;
+
+	// 行ごとに、両端のワードはマスクを掛け、間のワードはそのまま 0 か見る
+	const int32_t w0 = x0 >> 6;
+	const int32_t w1 = x1 >> 6;
+	const uint64_t mask0 = kAllBits << (x0 & 63);
+	const uint64_t mask1 = kAllBits >> (63 - (x1 & 63));
+	for (int32_t y = y0; y <= y1; ++y) {
+		const uint64_t* row = Row(y);
+		if (w0 == w1) {
+			if (row[w0] & mask0 & mask1)
+				return true;
+			continue;
+		}
+		if ((row[w0] & mask0) || (row[w1] & mask1))
+			return true;
+		for (int32_t w = w0 + 1; w < w1; ++w) {
+			if (row[w])
+				return true;
+		}
+	}
+	return false;
+}
+
+bool TileMap::FindNearestFree(int32_t x, int32_t y, int32_t& outX, int32_t& outY) const {
+	if (IsEmpty())
+		return false;
+	if (!IsSolid(x, y)) {
+		outX = x;
+		outY = y;
+		return true;
+	}
+
+	// 上下に d 行離れた行ごとに、x から左右へ最初の空きビットを引く。d² が今の最短以上になったら打ち切り
+	const int32_t width = static_cast<int32_t>(width_);
+	const int32_t height = static_cast<int32_t>(height_);
+	int64_t best = std::numeric_limits<int64_t>::max();
+	for (int32_t d = 0; int64_t(d) * d < best; ++d) {
+		const bool up = y - d >= 0;
+		const bool down = d > 0 && y + d < height;
+		if (!up && !down) {
+			if (y + d >= height)
+				break; // 上下どちらもマップの外
+			continue;
+		}
+		for (int32_t side = 0; side < 2; ++side) {
+			if (side == 0 ? !up : !down)
+				continue;
+			const int32_t ry = side == 0 ? y - d : y + d;
+			const uint64_t* row = Row(ry);
+			const int32_t right = FindForward(row, x, width, kAllBits);
+			const int32_t left = FindBackward(row, x, 0, kAllBits);
+			if (right < width && int64_t(right - x) * (right - x) + int64_t(d) * d < best) {
+				best = int64_t(right - x) * (right - x) + int64_t(d) * d;
+				outX = right;
+				outY = ry;
+			}
+			if (left >= 0 && int64_t(x - left) * (x - left) + int64_t(d) * d < best) {
+				best = int64_t(x - left) * (x - left) + int64_t(d) * d;
+				outX = left;
+				outY = ry;
+			}
+		}
+	}
+	return best != std::numeric_limits<int64_t>::max();
+}
+
+void TileMap::GetSpans(std::vector<Span>& out) const {
+	out.clear();
+	const int32_t width = static_cast<int32_t>(width_);
+	for (int32_t y = 0; y < static_cast<int32_t>(height_); ++y) {
+		const uint64_t* row = Row(y);
+		for (int32_t x = FindForward(row, 0, width, 0u); x < width; x = FindForward(row, x, width, 0u)) {
+			const int32_t x1 = FindForward(row, x, width, kAllBits);
+			out.push_back({y, x, x1});
+			x = x1;
+		}
+	}
+}
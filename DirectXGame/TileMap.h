@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// マス目の障害物マップ（Resources/blocks.csv のような 0/1 の CSV から作る。ツールからも使う）
+// ・1マス1ビットで、横1行を 64bit のワードに詰めて持つ（行ごとにワード境界から始まる）。0 以外の値のマスが埋まっている
+//   レイ用に縦1列ずつ詰めた表（転置）も持つ
+// ・CSV はセルごとの確保をせずに読む。「0,1,」のような1文字のセルは 8 バイトずつまとめて 4 マスを読む
+// ・座標はマス単位（マス (x, y) は [x, x+1) × [y, y+1)、y は CSV の行）。マップの外は空きとして扱う
+// ・レイは傾きの緩い向きの表を使い、1行（列）ぶんの通過範囲をワードのマスクでまとめて調べて、当たりは先頭ビットの位置で引く
+//   DDA と同じマスを1マスずつ歩かずに調べる（角をちょうど通るときにどちらのマスを先に見るかは丸め次第）
+class TileMap {
+public:
+	// レイが当たった場所
+	struct RayHit {
+		float t = 0.0f;       // 始点 0 ～ 終点 1 のどこでマスに入ったか
+		int32_t x = 0;        // 当たったマス
+		int32_t y = 0;
+		int32_t normalX = 0;  // 入った面の向き（始点が埋まったマスの中なら 0, 0）
+		int32_t normalY = 0;
+	};
+
+	// 横につながった埋まりマス（[x0, x1)）
+	struct Span {
+		int32_t y = 0;
+		int32_t x0 = 0;
+		int32_t x1 = 0;
+	};
+
+	// CSV を読む。行ごとに列数が揃っていなければ false（中身は空になる）
+	bool Parse(std::span<const uint8_t> text);
+	// 全部空きの width × height にする
+	void Reset(uint32_t width, uint32_t height);
+	void Set(int32_t x, int32_t y, bool solid);
+
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+	bool IsEmpty() const { return width_ == 0u || height_ == 0u; }
+
+	bool IsSolid(int32_t x, int32_t y) const {
+		if (x < 0 || y < 0 || uint32_t(x) >= width_ || uint32_t(y) >= height_)
+			return false;
+		return (Row(y)[x >> 6] >> (x & 63)) & 1u;
+	}
+	uint32_t CountSolid() const;
+
+	// (x0, y0) → (x1, y1) の線分が最初に入る埋まりマス。当たらなければ false
+	bool Raycast(float x0, float y0, float x1, float y1, RayHit* hit = nullptr) const;
+	// [minX, maxX] × [minY, maxY] の箱に掛かるマスのどれかが埋まっているか（端がちょうどマスの境目なら隣は含まない）
+	bool OverlapsBox(float minX, float minY, float maxX, float maxY) const;
+	// (x, y) に一番近い（ユークリッド距離）マップ内の空きマス。(x, y) が空きならそのまま。空きが1つもなければ false
+	bool FindNearestFree(int32_t x, int32_t y, int32_t& outX, int32_t& outY) const;
+	// 埋まりマスを行ごとに横の塊にまとめて out に書く（上書き）。描画用のメッシュを作るのに使う
+	void GetSpans(std::vector<Span>& out) const;
+
+private:
+	const uint64_t* Row(int32_t y) const { return bits_.data() + size_t(y) * wordsPerRow_; }
+	uint64_t* Row(int32_t y) { return bits_.data() + size_t(y) * wordsPerRow_; }
+	// bits_ から columns_ を作り直す
+	void BuildColumns();
+
+	uint32_t width_ = 0u;
+	uint32_t height_ = 0u;
+	uint32_t wordsPerRow_ = 0u;
+	uint32_t wordsPerColumn_ = 0u;
+	std::vector<uint64_t> bits_;    // height_ * wordsPerRow_。幅より右のビットは常に 0
+	std::vector<uint64_t> columns_; // width_ * wordsPerColumn_（列 x の y ビット目 = マス (x, y)）
+};
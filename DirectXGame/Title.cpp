@@ -1,12 +1,12 @@
 #include "Title.h"
+#include "AssetCache.h"
+#include "GameScene.h"
+#include "XAudio2Sink.h"
 #include <numbers>
 
 using namespace KamataEngine;
 
-TitleScene::~TitleScene() {
-	delete modelTitle_;
-	modelTitle_ = nullptr;
-}
+TitleScene::~TitleScene() = default;
 
 void TitleScene::Initialize() {
 	// カメラ（正面やや引き）
@@ -17,8 +17,8 @@ void TitleScene::Initialize() {
 	cameraPtr_ = &camera_; // ★ Skydome に渡す用
 
 	// タイトルのOBJ（titleFont フォルダ想定）
-	modelTitle_ = Model::CreateFromOBJ("Title", true);
-	modelSkydome_ = Model::CreateFromOBJ("TitleSkydome");
+	modelTitle_ = AssetCache::GetInstance()->AcquireModel("Title", true);
+	modelSkydome_ = AssetCache::GetInstance()->AcquireModel("TitleSkydome");
 
 	// ワールドトランスフォーム
 	titleWT_ = std::make_unique<WorldTransform>();
@@ -35,17 +35,11 @@ void TitleScene::Initialize() {
 	step_ = Step::FadeIn;
 
 	//----------BGM----------///
-	// Audio のインスタンス取得
-	auto* audio = Audio::GetInstance();
-
-	// BGM 読み込み（WAV形式）
-	bgmHandle_ = audio->LoadWave("./BGM/Title.wav");
-
-	// ループ再生 (volume=0.5)
-	bgmVoice_ = audio->PlayWave(bgmHandle_, true, 0.5f);
+	// ストリーミングでループ再生 (volume=0.5)
+	bgm_.Play("./BGM/Title.wav", std::make_unique<XAudio2Sink>(), true, 0.5f);
 
-	skydome_ = new Skydome();
-	skydome_->Initialize(modelSkydome_, cameraPtr_);
+	skydome_ = std::make_unique<Skydome>();
+	skydome_->Initialize(modelSkydome_.get(), cameraPtr_);
 }
 
 void TitleScene::Update() {
@@ -69,6 +63,9 @@ void TitleScene::Update() {
 		if (fade_ && fade_->IsFinished()) {
 			fade_->Stop();
 			step_ = Step::Idle;
+
+			// 待機中にゲーム側のアセットを裏で読んでおく
+			GameScene::PrefetchAssets();
 		}
 		break;
 
@@ -82,15 +79,15 @@ void TitleScene::Update() {
 
 			// BGM 停止
 			step_ = Step::FadeOut;
-			auto* audio = Audio::GetInstance();
-			audio->StopWave(bgmVoice_); // ← bgmVoice_ を渡す
+			bgm_.Stop();
 			bgmStoppedOnGameOver_ = true;
 
 		}
 		break;
 
 	case Step::FadeOut:
-		if (fade_ && fade_->IsFinished()) {
+		// 先読みが終わるまでは暗転のまま待つ（GameScene::Initialize で読み込み待ちをしない）
+		if (fade_ && fade_->IsFinished() && !AssetCache::GetInstance()->IsLoading()) {
 			// ここでタイトル終了→main.cpp 側で GameScene を生成
 			step_ = Step::Done;
 		}
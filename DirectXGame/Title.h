@@ -1,7 +1,9 @@
 #pragma once
 #include "Fade.h"
 #include "Skydome.h"
+#include "StreamingVoice.h"
 #include <KamataEngine.h>
+#include <memory>
 
 using namespace KamataEngine;
 
@@ -28,21 +30,20 @@ private:
 
 	// 表示物
 	Camera camera_{};
-	Model* modelTitle_ = nullptr;
+	std::shared_ptr<ModelAsset> modelTitle_;
 	std::unique_ptr<WorldTransform> titleWT_;
 
 	// フェード
 	std::unique_ptr<Fade> fade_;
 
 	//model
-	Model* modelSkydome_ = nullptr;     // 天球
+	std::shared_ptr<ModelAsset> modelSkydome_;     // 天球
 	Camera* cameraPtr_ = nullptr;       // ★ Skydome が参照するのでポインタでも持つ
 
 	// ▼ BGM用
-	uint32_t bgmHandle_ = 0u;  // 読み込んだBGMデータ
-	uint32_t bgmVoice_ = 0u;  // 再生中のハンドル
+	StreamingVoice bgm_; // 少しずつ読みながら再生する
 	bool bgmStoppedOnGameOver_ = false;
 
 	// ============ 天球 ============
-	Skydome* skydome_ = nullptr;
+	std::unique_ptr<Skydome> skydome_;
 };
@@ -0,0 +1,31 @@
+#pragma once
+// このファイルは Tools/AtlasPacker が生成する。手で編集しない
+#include "TextureAtlas.h"
+
+namespace UiAtlas {
+
+inline const char* const kTextureFile = "UiAtlas.png";
+inline const uint32_t kWidth = 1024u;
+inline const uint32_t kHeight = 512u;
+
+enum Id : uint32_t {
+	kFont,
+	kHud,
+	kLife,
+	kSkillCannon,
+	kUiPauseMenu,
+	kUiEscPause,
+	kCount
+};
+
+// 名前, x, y, 幅, 高さ（ピクセル・padding を除く）
+inline const AtlasRect kRects[kCount] = {
+    {"Font", 2, 262, 576, 112},
+    {"Hud", 2, 378, 576, 56},
+    {"Life", 582, 2, 64, 64},
+    {"SkillCannon", 650, 2, 64, 64},
+    {"ui_pause_menu", 2, 2, 512, 256},
+    {"ui_esc_pause", 718, 2, 256, 48},
+};
+
+} // namespace UiAtlas
@@ -0,0 +1,154 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// 量子化した頂点（16 バイト。Mesh::VertexPosNormalUv の半分）
+// ・Tools/MeshBaker が -q で .mesh に書き、ObjQuantizedVS.hlsl が展開する
+// ・位置 : メッシュの範囲 [offset, offset + scale] を UNORM16（R16G16B16A16_UNORM）。誤差は各軸 scale / 131070（+ float の丸め）
+// ・法線 : 八面体写像の2成分を SNORM16（R16G16_SNORM）。丸めの4近傍から一番近いものを選ぶ。誤差は 0.008 度未満
+// ・UV   : half float（R16G16_FLOAT）。|uv| <= 1 なら誤差 2^-12 以下、それ以外は相対 2^-11 以下
+namespace VertexQuant {
+
+struct Vertex {
+	uint16_t pos[4]; // w は使わない（0）
+	int16_t normal[2];
+	uint16_t uv[2];
+};
+static_assert(sizeof(Vertex) == 16, "VertexQuant::Vertex layout");
+
+// 位置の展開（pos = offset + unorm * scale）。シェーダの定数と同じ並び
+struct Quantization {
+	float offset[3];
+	float scale[3];
+};
+
+inline uint32_t FloatBits(float f) {
+	uint32_t u = 0u;
+	std::memcpy(&u, &f, sizeof(u));
+	return u;
+}
+
+inline float BitsFloat(uint32_t u) {
+	float f = 0.0f;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+// float → half（最近接偶数丸め。範囲外は無限大）
+inline uint16_t FloatToHalf(float value) {
+	uint32_t f = FloatBits(value);
+	const uint32_t sign = f & 0x80000000u;
+	f ^= sign;
+
+	uint32_t h = 0u;
+	if (f >= (127u + 16u) << 23) {
+		h = f > 0x7F800000u ? 0x7E00u : 0x7C00u; // NaN / 無限大
+	} else if (f < 113u << 23) {
+		// 非正規化数：仮数が下位 10bit に来るよう足して丸めを FPU に任せる
+		const uint32_t magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+		h = FloatBits(BitsFloat(f) + BitsFloat(magic)) - magic;
+	} else {
+		const uint32_t odd = (f >> 13) & 1u;
+		f += ((15u - 127u) << 23) + 0xFFFu + odd;
+		h = f >> 13;
+	}
+	return static_cast<uint16_t>(h | (sign >> 16));
+}
+
+inline float HalfToFloat(uint16_t half) {
+	const uint32_t shiftedExp = 0x7C00u << 13;
+	uint32_t o = (half & 0x7FFFu) << 13;
+	const uint32_t exp = o & shiftedExp;
+	o += (127u - 15u) << 23;
+	if (exp == shiftedExp) {
+		o += (128u - 16u) << 23; // NaN / 無限大
+	} else if (exp == 0u) {
+		o += 1u << 23; // 非正規化数
+		o = FloatBits(BitsFloat(o) - BitsFloat(113u << 23));
+	}
+	return BitsFloat(o | (static_cast<uint32_t>(half & 0x8000u) << 16));
+}
+
+inline uint16_t EncodeUnorm16(float v) {
+	const float c = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+	return static_cast<uint16_t>(std::lround(c * 65535.0f));
+}
+
+inline float DecodeUnorm16(uint16_t v) { return static_cast<float>(v) / 65535.0f; }
+
+// D3D と同じく -32768 は -1 として扱う
+inline float DecodeSnorm16(int16_t v) {
+	const float f = static_cast<float>(v) / 32767.0f;
+	return f < -1.0f ? -1.0f : f;
+}
+
+inline void DecodeOctahedral(const int16_t in[2], float n[3]) {
+	float x = DecodeSnorm16(in[0]), y = DecodeSnorm16(in[1]);
+	const float z = 1.0f - std::fabs(x) - std::fabs(y);
+	const float t = z < 0.0f ? -z : 0.0f;
+	x += x >= 0.0f ? -t : t;
+	y += y >= 0.0f ? -t : t;
+	const float len = std::sqrt(x * x + y * y + z * z);
+	n[0] = x / len;
+	n[1] = y / len;
+	n[2] = z / len;
+}
+
+// 単位ベクトル → 八面体写像（丸めた4近傍のうち展開後が一番近いもの）
+inline void EncodeOctahedral(const float n[3], int16_t out[2]) {
+	const float l1 = std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]);
+	float x = l1 > 0.0f ? n[0] / l1 : 0.0f;
+	float y = l1 > 0.0f ? n[1] / l1 : 0.0f;
+	if (n[2] < 0.0f) {
+		const float ox = x, oy = y;
+		x = (1.0f - std::fabs(oy)) * (ox >= 0.0f ? 1.0f : -1.0f);
+		y = (1.0f - std::fabs(ox)) * (oy >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	float best = -2.0f;
+	for (int i = 0; i < 4; ++i) {
+		const float cx = (i & 1) ? std::ceil(x * 32767.0f) : std::floor(x * 32767.0f);
+		const float cy = (i & 2) ? std::ceil(y * 32767.0f) : std::floor(y * 32767.0f);
+		const int16_t candidate[2] = {static_cast<int16_t>(cx < -32767.0f ? -32767.0f : (cx > 32767.0f ? 32767.0f : cx)),
+		                              static_cast<int16_t>(cy < -32767.0f ? -32767.0f : (cy > 32767.0f ? 32767.0f : cy))};
+		float d[3];
+		DecodeOctahedral(candidate, d);
+		const float dot = d[0] * n[0] + d[1] * n[1] + d[2] * n[2];
+		if (dot > best) {
+			best = dot;
+			out[0] = candidate[0];
+			out[1] = candidate[1];
+		}
+	}
+}
+
+// 位置の範囲から展開用の値を作る（幅 0 の軸は scale 0）
+inline Quantization MakeQuantization(const float minPos[3], const float maxPos[3]) {
+	Quantization q{};
+	for (int i = 0; i < 3; ++i) {
+		q.offset[i] = minPos[i];
+		q.scale[i] = maxPos[i] - minPos[i];
+	}
+	return q;
+}
+
+inline Vertex Encode(const float pos[3], const float normal[3], const float uv[2], const Quantization& q) {
+	Vertex v{};
+	for (int i = 0; i < 3; ++i)
+		v.pos[i] = q.scale[i] > 0.0f ? EncodeUnorm16((pos[i] - q.offset[i]) / q.scale[i]) : 0u;
+	EncodeOctahedral(normal, v.normal);
+	v.uv[0] = FloatToHalf(uv[0]);
+	v.uv[1] = FloatToHalf(uv[1]);
+	return v;
+}
+
+inline void Decode(const Vertex& v, const Quantization& q, float pos[3], float normal[3], float uv[2]) {
+	for (int i = 0; i < 3; ++i)
+		pos[i] = q.offset[i] + DecodeUnorm16(v.pos[i]) * q.scale[i];
+	DecodeOctahedral(v.normal, normal);
+	uv[0] = HalfToFloat(v.uv[0]);
+	uv[1] = HalfToFloat(v.uv[1]);
+}
+
+} // namespace VertexQuant
@@ -0,0 +1,281 @@
+#include "VoicePool.h"
+#include "AssetPack.h"
+#include <algorithm>
+
+namespace {
+
+// 世代は 24bit で回し、0（未使用）は飛ばす
+uint32_t NextGeneration(uint32_t generation) {
+	generation = (generation + 1u) & 0xFFFFFFu;
+	return generation == 0u ? 1u : generation;
+}
+
+} // namespace
+
+VoicePool* VoicePool::GetInstance() {
+	static VoicePool instance;
+	return &instance;
+}
+
+void VoicePool::Initialize(uint32_t voiceCount, std::unique_ptr<AudioSink> output) {
+	Finalize();
+	voiceCount_ = std::min(voiceCount, kMaxVoices);
+	voices_ = std::make_unique<Voice[]>(voiceCount_);
+	gameSlots_ = std::make_unique<GameSlot[]>(voiceCount_);
+	sounds_ = std::make_unique<Sound[]>(kMaxSounds);
+	soundCount_ = 0u;
+	serial_ = 0u;
+	stats_ = {};
+
+	// 出力は 48kHz ステレオ float の1本だけ
+	mixer_.Initialize(voiceCount_, kOutputRate, kBlockFrames);
+	blocks_ = std::make_unique<float[]>(kBlockCount * kBlockFrames * AudioMixer::kChannels);
+	submittedBlocks_ = 0u;
+	completedBlocks_.store(0u, std::memory_order_relaxed);
+	underruns_.store(0u, std::memory_order_relaxed);
+	output_ = std::move(output);
+	WaveFormat format;
+	format.formatTag = 3u;
+	format.channels = static_cast<uint16_t>(AudioMixer::kChannels);
+	format.sampleRate = kOutputRate;
+	format.bitsPerSample = 32u;
+	format.blockAlign = static_cast<uint16_t>(AudioMixer::kChannels * sizeof(float));
+	format.avgBytesPerSec = kOutputRate * format.blockAlign;
+	outputOpened_ = output_ && output_->Open(format, [this]() {
+		completedBlocks_.fetch_add(1u, std::memory_order_release);
+		Wake();
+	});
+
+	quit_.store(false, std::memory_order_relaxed);
+	thread_ = std::thread(&VoicePool::ThreadMain, this);
+}
+
+void VoicePool::Finalize() {
+	if (thread_.joinable()) {
+		quit_.store(true, std::memory_order_release);
+		Wake();
+		thread_.join();
+	}
+	if (output_) {
+		output_->Close();
+		output_.reset();
+	}
+	outputOpened_ = false;
+	// キューに残ったコマンドは捨てる
+	Command command;
+	while (commands_.Pop(command)) {
+	}
+	voices_.reset();
+	gameSlots_.reset();
+	sounds_.reset();
+	blocks_.reset();
+	voiceCount_ = 0u;
+	soundCount_ = 0u;
+}
+
+VoicePool::SoundId VoicePool::LoadSound(const std::string& filename) {
+	if (!sounds_)
+		return 0u;
+	for (uint32_t i = 0; i < soundCount_; ++i) {
+		if (sounds_[i].name == filename)
+			return i + 1u;
+	}
+	if (soundCount_ == kMaxSounds)
+		return 0u;
+
+	// アセットビルドが作った .adpcm（1/4 の大きさ）があればそちらを使う
+	// パックに無圧縮で入っていればマップ上をそのまま使う
+	Sound& sound = sounds_[soundCount_];
+	std::span<const uint8_t> data;
+	const std::string path = "Resources/" + filename;
+	const size_t dot = path.find_last_of('.');
+	const size_t slash = path.find_last_of("/\\");
+	const std::string baked = path.substr(0, dot != std::string::npos && dot > slash ? dot : path.size()) + ".adpcm";
+	AssetPack* pack = AssetPack::GetInstance();
+	if ((!pack->Load(baked, sound.storage, data) && !pack->Load(path, sound.storage, data)) || !ParseWave(data, sound.wave) || !AudioMixer::IsSupported(sound.wave.format) || AudioMixer::CountFrames(sound.wave) == 0u) {
+		sound = {};
+		return 0u;
+	}
+	sound.name = filename;
+
+	// オーディオスレッドは Play のコマンドを受け取ってから読む（キューの release / acquire で中身が見える）
+	return ++soundCount_;
+}
+
+bool VoicePool::Resolve(Handle handle, uint32_t& slot) const {
+	slot = handle & 0xFFu;
+	return handle != 0u && slot < voiceCount_ && gameSlots_[slot].generation == (handle >> 8);
+}
+
+VoicePool::Handle VoicePool::Play(SoundId sound, float volume, uint8_t priority, float pan) {
+	if (sound == 0u || sound > soundCount_)
+		return 0u;
+
+	// 鳴り終わっているボイスを探す。なければ優先度が低く古いものを奪う候補にする
+	int32_t slot = -1;
+	int32_t victim = -1;
+	for (uint32_t i = 0; i < voiceCount_; ++i) {
+		const GameSlot& g = gameSlots_[i];
+		if (g.generation == voices_[i].finishedGeneration.load(std::memory_order_acquire)) {
+			slot = static_cast<int32_t>(i);
+			break;
+		}
+		if (victim < 0 || g.priority < gameSlots_[victim].priority || (g.priority == gameSlots_[victim].priority && g.serial < gameSlots_[victim].serial))
+			victim = static_cast<int32_t>(i);
+	}
+	const bool steal = slot < 0;
+	if (steal) {
+		if (victim < 0 || gameSlots_[victim].priority > priority) {
+			stats_.dropped++;
+			return 0u;
+		}
+		slot = victim;
+	}
+
+	GameSlot& g = gameSlots_[slot];
+	Command command;
+	command.type = CommandType::kPlay;
+	command.slot = static_cast<uint8_t>(slot);
+	command.generation = NextGeneration(g.generation);
+	command.sound = sound;
+	command.volume = volume;
+	command.pan = pan;
+	if (!Send(command)) {
+		stats_.queueFull++;
+		return 0u;
+	}
+
+	g.generation = command.generation;
+	g.priority = priority;
+	g.serial = ++serial_;
+	stats_.played++;
+	if (steal)
+		stats_.stolen++;
+	return MakeHandle(static_cast<uint32_t>(slot), g.generation);
+}
+
+void VoicePool::Stop(Handle handle) {
+	uint32_t slot = 0u;
+	if (!Resolve(handle, slot))
+		return;
+	Command command;
+	command.type = CommandType::kStop;
+	command.slot = static_cast<uint8_t>(slot);
+	command.generation = handle >> 8;
+	Send(command);
+}
+
+void VoicePool::SetVolume(Handle handle, float volume, float pan) {
+	uint32_t slot = 0u;
+	if (!Resolve(handle, slot))
+		return;
+	Command command;
+	command.type = CommandType::kSetVolume;
+	command.slot = static_cast<uint8_t>(slot);
+	command.generation = handle >> 8;
+	command.volume = volume;
+	command.pan = pan;
+	Send(command);
+}
+
+bool VoicePool::IsPlaying(Handle handle) const {
+	uint32_t slot = 0u;
+	return Resolve(handle, slot) && voices_[slot].finishedGeneration.load(std::memory_order_acquire) != (handle >> 8);
+}
+
+uint32_t VoicePool::GetActiveCount() const {
+	uint32_t count = 0u;
+	for (uint32_t i = 0; i < voiceCount_; ++i) {
+		if (gameSlots_[i].generation != voices_[i].finishedGeneration.load(std::memory_order_acquire))
+			count++;
+	}
+	return count;
+}
+
+bool VoicePool::Send(const Command& command) {
+	if (!commands_.Push(command))
+		return false;
+	Wake();
+	return true;
+}
+
+void VoicePool::Wake() {
+	wake_.fetch_add(1u, std::memory_order_release);
+	wake_.notify_one();
+}
+
+void VoicePool::ThreadMain() {
+	if (outputOpened_) {
+		Refill();
+		output_->Start();
+	}
+
+	for (;;) {
+		// 見た値より後に Wake されていれば wait はすぐ戻る
+		const uint32_t seen = wake_.load(std::memory_order_acquire);
+		if (quit_.load(std::memory_order_acquire))
+			return;
+
+		Command command;
+		while (commands_.Pop(command))
+			Execute(command);
+
+		if (outputOpened_)
+			Refill();
+
+		wake_.wait(seen, std::memory_order_acquire);
+	}
+}
+
+void VoicePool::Execute(const Command& command) {
+	Voice& voice = voices_[command.slot];
+	switch (command.type) {
+	case CommandType::kPlay:
+		// 奪ったときは鳴っていたものを打ち切って頭から
+		voice.playingGeneration = command.generation;
+		voice.active = outputOpened_ && mixer_.Start(command.slot, sounds_[command.sound - 1u].wave, command.volume, command.pan);
+		if (!voice.active)
+			Finish(command.slot);
+		break;
+	case CommandType::kStop:
+		if (voice.active && voice.playingGeneration == command.generation) {
+			mixer_.Stop(command.slot);
+			Finish(command.slot);
+		}
+		break;
+	case CommandType::kSetVolume:
+		if (voice.active && voice.playingGeneration == command.generation)
+			mixer_.SetVolume(command.slot, command.volume, command.pan);
+		break;
+	}
+}
+
+void VoicePool::Refill() {
+	const uint32_t completed = completedBlocks_.load(std::memory_order_acquire);
+	if (submittedBlocks_ != 0u && completed == submittedBlocks_)
+		underruns_.fetch_add(1u, std::memory_order_relaxed);
+
+	bool mixed = false;
+	while (submittedBlocks_ - completed < kBlockCount) {
+		float* block = blocks_.get() + (submittedBlocks_ % kBlockCount) * kBlockFrames * AudioMixer::kChannels;
+		mixer_.Mix(block, kBlockFrames);
+		if (!output_->Submit(reinterpret_cast<const uint8_t*>(block), kBlockFrames * AudioMixer::kChannels * sizeof(float), false))
+			break;
+		submittedBlocks_++;
+		mixed = true;
+	}
+	if (!mixed)
+		return;
+
+	// 最後まで混ぜ終えたボイスを空きにする（実際に聞こえ終わるのは渡したブロックを再生し終えたとき）
+	for (uint32_t i = 0; i < voiceCount_; ++i) {
+		if (voices_[i].active && !mixer_.IsActive(i))
+			Finish(i);
+	}
+}
+
+void VoicePool::Finish(uint32_t slot) {
+	Voice& voice = voices_[slot];
+	voice.active = false;
+	voice.finishedGeneration.store(voice.playingGeneration, std::memory_order_release);
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "AudioMixer.h"
+#include "AudioSink.h"
+#include "SpscQueue.h"
+#include "WaveFile.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 効果音用のボイスプール（連打される一発ものを Audio::PlayWave の代わりに鳴らす）
+// ・ボイスは Initialize で数を決めて確保し、ハンドル（スロット番号 + 世代）で指す。鳴り終わった・奪われたボイスの古いハンドルは世代が合わず無視される
+// ・ゲームスレッドの Play / Stop / SetVolume はコマンドを SPSC キューに積むだけ（ロックも確保もしない）
+//   プール専用のオーディオスレッドがキューを取り出してミキサーを操作し、混ぜ終わったボイスを世代で知らせ返す
+// ・空きがなければ優先度が一番低く、その中で一番古いボイスを奪う。新しい音より優先度の高いものしかなければ鳴らさない
+// ・ボイスごとに出力先を持たず、AudioMixer で全ボイスを 48kHz ステレオ float に混ぜて1本の出力先へ渡す
+//   kBlockFrames フレームのブロック kBlockCount 個を輪にして、再生し終えたものから混ぜ直す（遅延は最大 kBlockCount ブロックぶん）
+// ・出力先は AudioSink（ゲームは XAudio2Sink、Linux での確認は NullAudioSink）
+class VoicePool {
+public:
+	using Handle = uint32_t;  // 0 は無効
+	using SoundId = uint32_t; // 0 は無効
+
+	static const uint32_t kMaxVoices = 256u; // ハンドルのスロット番号が 8bit
+	static const uint32_t kOutputRate = 48000u;
+	static const uint32_t kBlockFrames = 480u; // 10ms
+	static const uint32_t kBlockCount = 3u;
+	static const uint32_t kMaxSounds = 64u;
+	static const size_t kCommandCapacity = 256u;
+
+	// ゲームスレッドから見た統計（累計）
+	struct Stats {
+		uint32_t played = 0u;    // 鳴らした数（奪ったものを含む）
+		uint32_t stolen = 0u;    // 鳴っているボイスを奪った数
+		uint32_t dropped = 0u;   // 優先度が足りず鳴らさなかった数
+		uint32_t queueFull = 0u; // コマンドキューが満杯で鳴らさなかった数
+	};
+
+	static VoicePool* GetInstance();
+
+	// ボイス数（kMaxVoices まで）と出力先を決めてオーディオスレッドを立てる
+	void Initialize(uint32_t voiceCount, std::unique_ptr<AudioSink> output);
+	// オーディオスレッドを止め、出力先・ボイス・音を捨てる
+	void Finalize();
+
+	// WAV を読んで登録する（Resources/ からのパス。同じ名前は同じ ID）。Initialize の後、ゲームスレッドから
+	// 隣に拡張子を .adpcm にしたもの（アセットビルドが作る）があればそちらを読む
+	// AudioMixer が混ぜられない形式なら 0
+	SoundId LoadSound(const std::string& filename);
+
+	// 以下ゲームスレッドから
+	// priority が大きいほど奪われにくい。pan は -1（左）～ 1（右）。鳴らせなければ 0
+	Handle Play(SoundId sound, float volume = 1.0f, uint8_t priority = 0u, float pan = 0.0f);
+	void Stop(Handle handle);
+	void SetVolume(Handle handle, float volume, float pan = 0.0f);
+	bool IsPlaying(Handle handle) const;
+	// 鳴っているボイス数
+	uint32_t GetActiveCount() const;
+
+	const Stats& GetStats() const { return stats_; }
+	// 出力先へ渡したブロックが尽きた回数（オーディオスレッドが数える）
+	uint32_t GetUnderrunCount() const { return underruns_.load(std::memory_order_relaxed); }
+
+private:
+	enum class CommandType : uint8_t {
+		kPlay,
+		kStop,
+		kSetVolume,
+	};
+
+	struct Command {
+		CommandType type = CommandType::kPlay;
+		uint8_t slot = 0u;
+		uint32_t generation = 0u;
+		SoundId sound = 0u;
+		float volume = 1.0f;
+		float pan = 0.0f;
+	};
+
+	struct Sound {
+		std::string name;
+		std::vector<uint8_t> storage; // パックに無圧縮で入っていなければ読み込み先
+		WaveView wave;
+	};
+
+	// ゲームスレッドだけが触る
+	struct GameSlot {
+		uint32_t generation = 0u; // 最後に鳴らした世代（0 は未使用）
+		uint8_t priority = 0u;
+		uint64_t serial = 0u; // 鳴らし始めた順
+	};
+
+	// オーディオスレッドが持つ（finishedGeneration だけゲームスレッドが読む）
+	struct Voice {
+		bool active = false;
+		uint32_t playingGeneration = 0u;
+		std::atomic<uint32_t> finishedGeneration{0u}; // 混ぜ終わった世代
+	};
+
+	VoicePool() = default;
+	~VoicePool() { Finalize(); }
+	VoicePool(const VoicePool&) = delete;
+	VoicePool& operator=(const VoicePool&) = delete;
+
+	static Handle MakeHandle(uint32_t slot, uint32_t generation) { return (generation << 8) | slot; }
+	bool Resolve(Handle handle, uint32_t& slot) const;
+	bool Send(const Command& command);
+	void Wake();
+
+	// オーディオスレッド
+	void ThreadMain();
+	void Execute(const Command& command);
+	// 空いたブロックを混ぜて出力先へ渡す
+	void Refill();
+	void Finish(uint32_t slot);
+
+	uint32_t voiceCount_ = 0u;
+	std::unique_ptr<Voice[]> voices_;
+	std::unique_ptr<GameSlot[]> gameSlots_;
+	std::unique_ptr<Sound[]> sounds_;
+	uint32_t soundCount_ = 0u;
+	uint64_t serial_ = 0u;
+	Stats stats_;
+
+	// オーディオスレッド
+	AudioMixer mixer_;
+	std::unique_ptr<AudioSink> output_;
+	bool outputOpened_ = false;
+	std::unique_ptr<float[]> blocks_; // kBlockCount 個ぶん
+	uint32_t submittedBlocks_ = 0u;
+	std::atomic<uint32_t> completedBlocks_{0u}; // 出力先のコールバックが数える
+	std::atomic<uint32_t> underruns_{0u};
+
+	SpscQueue<Command, kCommandCapacity> commands_;
+	std::atomic<uint32_t> wake_{0u};
+	std::atomic<bool> quit_{false};
+	std::thread thread_;
+};
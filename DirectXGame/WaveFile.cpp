@@ -0,0 +1,102 @@
+#include "WaveFile.h"
+#include <cstring>
+
+namespace {
+
+uint32_t Read32(const uint8_t* p) {
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+uint16_t Read16(const uint8_t* p) {
+	uint16_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+// fmt チャンクの中身（16 バイト以上）
+void ReadFormat(const uint8_t* f, uint32_t chunkSize, WaveFormat& out) {
+	out.formatTag = Read16(f);
+	out.channels = Read16(f + 2);
+	out.sampleRate = Read32(f + 4);
+	out.avgBytesPerSec = Read32(f + 8);
+	out.blockAlign = Read16(f + 12);
+	out.bitsPerSample = Read16(f + 14);
+	out.samplesPerBlock = chunkSize >= 20u && Read16(f + 16) >= 2u ? Read16(f + 18) : 0u;
+}
+
+} // namespace
+
+bool ParseWave(std::span<const uint8_t> data, WaveView& out) {
+	if (data.size() < 12u || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0)
+		return false;
+
+	bool hasFormat = false;
+	bool hasData = false;
+	size_t pos = 12u;
+	while (pos + 8u <= data.size()) {
+		const uint8_t* chunk = data.data() + pos;
+		const uint32_t chunkSize = Read32(chunk + 4);
+		const size_t body = pos + 8u;
+		if (chunkSize > data.size() - body)
+			return false;
+
+		if (std::memcmp(chunk, "fmt ", 4) == 0) {
+			if (chunkSize < 16u)
+				return false;
+			ReadFormat(data.data() + body, chunkSize, out.format);
+			hasFormat = true;
+		} else if (std::memcmp(chunk, "data", 4) == 0) {
+			out.samples = data.subspan(body, chunkSize);
+			hasData = true;
+		}
+
+		// チャンクは2バイト境界
+		pos = body + chunkSize + (chunkSize & 1u);
+	}
+	return hasFormat && hasData && out.format.channels != 0u && out.format.blockAlign != 0u;
+}
+
+bool ParseWaveFile(FILE* fp, WaveFormat& format, uint64_t& dataOffset, uint32_t& dataSize) {
+	uint8_t riff[12];
+	if (std::fseek(fp, 0, SEEK_SET) != 0 || std::fread(riff, 1, sizeof(riff), fp) != sizeof(riff))
+		return false;
+	if (std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0)
+		return false;
+
+	// data より前に fmt がある前提（ParseWave と違い、data の後ろは読まない）
+	bool hasFormat = false;
+	uint64_t pos = sizeof(riff);
+	uint8_t chunk[8];
+	while (std::fread(chunk, 1, sizeof(chunk), fp) == sizeof(chunk)) {
+		const uint32_t chunkSize = Read32(chunk + 4);
+		const uint64_t body = pos + sizeof(chunk);
+
+		if (std::memcmp(chunk, "fmt ", 4) == 0) {
+			uint8_t f[20] = {};
+			const size_t n = chunkSize < sizeof(f) ? chunkSize : sizeof(f);
+			if (chunkSize < 16u || std::fread(f, 1, n, fp) != n)
+				return false;
+			ReadFormat(f, static_cast<uint32_t>(n), format);
+			hasFormat = true;
+		} else if (std::memcmp(chunk, "data", 4) == 0) {
+			// サイズがファイルより大きければ（書きかけのファイルなど）ファイルの終わりまで
+			if (std::fseek(fp, 0, SEEK_END) != 0)
+				return false;
+			const long fileSize = std::ftell(fp);
+			if (fileSize < 0 || static_cast<uint64_t>(fileSize) < body || std::fseek(fp, static_cast<long>(body), SEEK_SET) != 0)
+				return false;
+			const uint64_t available = static_cast<uint64_t>(fileSize) - body;
+			dataOffset = body;
+			dataSize = available < chunkSize ? static_cast<uint32_t>(available) : chunkSize;
+			return hasFormat && format.channels != 0u && format.blockAlign != 0u;
+		}
+
+		// チャンクは2バイト境界
+		pos = body + chunkSize + (chunkSize & 1u);
+		if (std::fseek(fp, static_cast<long>(pos), SEEK_SET) != 0)
+			return false;
+	}
+	return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <span>
+
+// RIFF WAVE の解析（メモリ上のデータをそのまま参照し、コピーしない）
+// ・アセットパックのマップ上や読み込んだバッファに対して使う。samples は data の中を指す
+struct WaveFormat {
+	uint16_t formatTag = 0u; // 1 = PCM, 3 = float, 0x11 = IMA-ADPCM
+	uint16_t channels = 0u;
+	uint32_t sampleRate = 0u;
+	uint32_t avgBytesPerSec = 0u;
+	uint16_t blockAlign = 0u;
+	uint16_t bitsPerSample = 0u;
+	uint16_t samplesPerBlock = 0u; // ADPCM のみ（fmt の拡張部）
+};
+
+struct WaveView {
+	WaveFormat format;
+	std::span<const uint8_t> samples; // data チャンクの中身
+};
+
+// 解析できたら true（fmt と data の両方が必要。その他のチャンクは読み飛ばす）
+bool ParseWave(std::span<const uint8_t> data, WaveView& out);
+
+// ファイルから fmt と data の位置だけを読む（data の中身は読まない。ストリーミング再生用）
+// 成功すると fp は data の先頭を指している
+bool ParseWaveFile(FILE* fp, WaveFormat& format, uint64_t& dataOffset, uint32_t& dataSize);
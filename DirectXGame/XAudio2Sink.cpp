@@ -0,0 +1,101 @@
+#include "XAudio2Sink.h"
+#include <mutex>
+#include <wrl.h>
+
+#pragma comment(lib, "xaudio2.lib")
+
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+ComPtr<IXAudio2> sXAudio2;
+IXAudio2MasteringVoice* sMasterVoice = nullptr;
+
+// ストリーミング・効果音用の XAudio2 を作る（失敗したら以後も作らない）
+// BGM はゲームスレッド、効果音は VoicePool のスレッドから開くので一度だけ作る
+IXAudio2* GetXAudio2() {
+	static std::once_flag once;
+	std::call_once(once, [] {
+		if (FAILED(XAudio2Create(&sXAudio2, 0, XAUDIO2_DEFAULT_PROCESSOR)) || FAILED(sXAudio2->CreateMasteringVoice(&sMasterVoice))) {
+			sMasterVoice = nullptr;
+			sXAudio2.Reset();
+		}
+	});
+	return sXAudio2.Get();
+}
+
+} // namespace
+
+void XAudio2Sink::Finalize() {
+	if (sMasterVoice) {
+		sMasterVoice->DestroyVoice();
+		sMasterVoice = nullptr;
+	}
+	sXAudio2.Reset();
+}
+
+void XAudio2Sink::Callback::OnBufferEnd(void*) {
+	if (owner_->onBufferEnd_)
+		owner_->onBufferEnd_();
+}
+
+bool XAudio2Sink::Open(const WaveFormat& format, BufferEndCallback onBufferEnd) {
+	Close();
+	if (format.formatTag != WAVE_FORMAT_PCM && format.formatTag != WAVE_FORMAT_IEEE_FLOAT)
+		return false;
+	IXAudio2* xAudio2 = GetXAudio2();
+	if (!xAudio2)
+		return false;
+
+	WAVEFORMATEX wfex{};
+	wfex.wFormatTag = format.formatTag;
+	wfex.nChannels = format.channels;
+	wfex.nSamplesPerSec = format.sampleRate;
+	wfex.nAvgBytesPerSec = format.avgBytesPerSec;
+	wfex.nBlockAlign = format.blockAlign;
+	wfex.wBitsPerSample = format.bitsPerSample;
+
+	onBufferEnd_ = std::move(onBufferEnd);
+	if (FAILED(xAudio2->CreateSourceVoice(&voice_, &wfex, 0, XAUDIO2_DEFAULT_FREQ_RATIO, &callback_))) {
+		voice_ = nullptr;
+		onBufferEnd_ = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void XAudio2Sink::Close() {
+	if (voice_) {
+		// DestroyVoice は実行中のコールバックが終わるまで待つので、戻ればもう呼ばれない
+		voice_->Stop();
+		voice_->FlushSourceBuffers();
+		voice_->DestroyVoice();
+		voice_ = nullptr;
+	}
+	onBufferEnd_ = nullptr;
+}
+
+bool XAudio2Sink::Submit(const uint8_t* data, size_t size, bool endOfStream) {
+	if (!voice_)
+		return false;
+	XAUDIO2_BUFFER buffer{};
+	buffer.Flags = endOfStream ? XAUDIO2_END_OF_STREAM : 0u;
+	buffer.AudioBytes = static_cast<UINT32>(size);
+	buffer.pAudioData = data;
+	return SUCCEEDED(voice_->SubmitSourceBuffer(&buffer));
+}
+
+void XAudio2Sink::Start() {
+	if (voice_)
+		voice_->Start();
+}
+
+void XAudio2Sink::Stop() {
+	if (voice_)
+		voice_->Stop();
+}
+
+void XAudio2Sink::SetVolume(float volume) {
+	if (voice_)
+		voice_->SetVolume(volume);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "AudioSink.h"
+#include <xaudio2.h>
+
+// XAudio2 のソースボイスへ出す出力先
+// ・Audio の IXAudio2 は外から取れないので、ストリーミング用に IXAudio2 とマスターボイスを1組だけ別に作って共有する（初回の Open で作る）
+// ・PCM / float の WAV に対応
+class XAudio2Sink : public AudioSink {
+public:
+	XAudio2Sink() : callback_(this) {}
+	~XAudio2Sink() override { Close(); }
+	XAudio2Sink(const XAudio2Sink&) = delete;
+	XAudio2Sink& operator=(const XAudio2Sink&) = delete;
+
+	bool Open(const WaveFormat& format, BufferEndCallback onBufferEnd) override;
+	void Close() override;
+	bool Submit(const uint8_t* data, size_t size, bool endOfStream) override;
+	void Start() override;
+	void Stop() override;
+	void SetVolume(float volume) override;
+
+	// 共有の IXAudio2 を解放する（KamataEngine::Finalize の前、全ての XAudio2Sink を閉じてから呼ぶ）
+	static void Finalize();
+
+private:
+	// バッファを再生し終えたら onBufferEnd_ へ伝える（XAudio2 のスレッドから呼ばれる）
+	class Callback : public IXAudio2VoiceCallback {
+	public:
+		explicit Callback(XAudio2Sink* owner) : owner_(owner) {}
+		STDMETHOD_(void, OnVoiceProcessingPassStart)(UINT32) override {}
+		STDMETHOD_(void, OnVoiceProcessingPassEnd)() override {}
+		STDMETHOD_(void, OnStreamEnd)() override {}
+		STDMETHOD_(void, OnBufferStart)(void*) override {}
+		STDMETHOD_(void, OnBufferEnd)(void*) override;
+		STDMETHOD_(void, OnLoopEnd)(void*) override {}
+		STDMETHOD_(void, OnVoiceError)(void*, HRESULT) override {}
+
+	private:
+		XAudio2Sink* owner_;
+	};
+
+	Callback callback_;
+	BufferEndCallback onBufferEnd_;
+	IXAudio2SourceVoice* voice_ = nullptr;
+};
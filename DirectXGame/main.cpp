@@ -1,8 +1,18 @@
+#include "AssetCache.h"
+#include "AssetPack.h"
+#include "ConstantBufferAllocator.h"
 #include "GameScene.h"
+#include "JobSystem.h"
+#include "Leaderboard.h"
+#include "TextureFile.h"
 #include "Title.h"
+#include "VoicePool.h"
+#include "XAudio2Sink.h"
 #include "GameOver.h" // ★ 追加
 #include <KamataEngine.h>
 #include <Windows.h>
+#include <chrono>
+#include <cstdio>
 #include <memory>
 
 using namespace KamataEngine;
@@ -13,19 +23,53 @@ enum class Scene {
 	GameOver, // ★ 追加
 };
 
+// 処理時間をデバッグ出力へ（起動・シーン切り替えの計測用）
+template<class Fn> static void MeasureLoad(const char* label, Fn&& fn) {
+	auto start = std::chrono::steady_clock::now();
+	fn();
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	char text[128];
+	std::snprintf(text, sizeof(text), "[load] %s: %.2f ms\n", label, ms);
+	OutputDebugStringA(text);
+}
+
 // Windowsアプリでのエントリーポイント(main関数)
 int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 
 	// エンジン初期化
-	KamataEngine::Initialize(L"2048_パイ・パトロール");
+	MeasureLoad("engine", [] { KamataEngine::Initialize(L"2048_パイ・パトロール"); });
 
 	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
 
+	// 描画時に行列などを書き込むフレーム用定数バッファ（1フレーム 1MB）
+	ConstantBufferAllocator* cbAllocator = ConstantBufferAllocator::GetInstance();
+	cbAllocator->Initialize(1024 * 1024);
+
+	// アセットパック（Tools/PackBuilder で作ったもの。なければ個別のファイルから読む）
+	AssetPack::GetInstance()->Open("Resources.pak");
+
+	// ハイスコア表（全プレイの記録。初回は前の HighScores.dat のスコアを取り込む）
+	Leaderboard::GetInstance()->Open("Leaderboard.dat", "HighScores.dat");
+
+	// ファイル読み込みなどの下処理用ワーカー
+	JobSystem::GetInstance()->Initialize();
+
+	// 効果音のボイスプール（専用のオーディオスレッドで混ぜて XAudio2 のボイス1本で鳴らす）
+	VoicePool::GetInstance()->Initialize(64, std::make_unique<XAudio2Sink>());
+
+	// タイトルのモデルは最初の画面に要るので同期で読んで終了まで持つ
+	// ゲーム・ゲームオーバーのものは前のシーンの間に PrefetchAssets で裏読みする（これも終了まで保持）
+	AssetCache* assetCache = AssetCache::GetInstance();
+	MeasureLoad("preload", [&] {
+		assetCache->PreloadModel("TitleSkydome");
+		assetCache->PreloadModel("Title", true);
+	});
+
 	Scene scene = Scene::Title;
 
 	// unique_ptr による安全な管理
 	std::unique_ptr<TitleScene> titleScene = std::make_unique<TitleScene>();
-	titleScene->Initialize();
+	MeasureLoad("startup Title", [&] { titleScene->Initialize(); });
 
 	std::unique_ptr<GameScene> gameScene = nullptr;
 	std::unique_ptr<GameOverScene> gameOverScene = nullptr; // ★ ここ追加
@@ -35,13 +79,17 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 		if (KamataEngine::Update())
 			break;
 
+		// 裏で読み終わったアセットを仕上げる（GPU 転送・LoadWave はここで行う）
+		assetCache->UpdateLoading();
+
 		switch (scene) {
 		case Scene::Title:
 			titleScene->Update();
 			if (titleScene->IsFinished()) {
 				titleScene.reset();
 				gameScene = std::make_unique<GameScene>();
-				gameScene->Initialize();
+				MeasureLoad("Title -> Game", [&] { gameScene->Initialize(); });
+				assetCache->Trim(); // 前のシーンだけが使っていたものを解放
 				scene = Scene::Game;
 			}
 			break;
@@ -50,9 +98,11 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 			gameScene->Update();
 			if (gameScene->IsGameOver()) {
 				int finalScore = gameScene->GetScore(); // ★ スコア取得
+				Leaderboard::GetInstance()->Add(gameScene->GetRun()); // ディスクまで書いてから次へ
 				gameScene.reset();
 				gameOverScene = std::make_unique<GameOverScene>();
-				gameOverScene->Initialize();
+				MeasureLoad("Game -> GameOver", [&] { gameOverScene->Initialize(); });
+				assetCache->Trim(); // 前のシーンだけが使っていたものを解放
 				gameOverScene->SetScore(finalScore); // ★ 渡す
 				scene = Scene::GameOver;
 			}
@@ -63,12 +113,14 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 			if (gameOverScene->IsFinished()) {
 				gameOverScene.reset();
 				titleScene = std::make_unique<TitleScene>();
-				titleScene->Initialize();
+				MeasureLoad("GameOver -> Title", [&] { titleScene->Initialize(); });
+				assetCache->Trim(); // 前のシーンだけが使っていたものを解放
 				scene = Scene::Title;
 			}
 			break;
 		}
 
+		cbAllocator->BeginFrame();
 		dxCommon->PreDraw();
 		switch (scene) {
 		case Scene::Title:
@@ -85,11 +137,26 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 			break;
 		}
 		dxCommon->PostDraw();
+		cbAllocator->EndFrame();
 	}
 
+	// テクスチャの名寄せで減らせた量
+	const TextureDedupStats dedup = GetTextureDedupStats();
+	char dedupText[192];
+	std::snprintf(dedupText, sizeof(dedupText), "[texture] %u files -> %u unique, saved %u SRV / %llu file bytes / %llu GPU bytes\n", dedup.files, dedup.unique, dedup.descriptorsSaved,
+	              static_cast<unsigned long long>(dedup.fileBytesSaved), static_cast<unsigned long long>(dedup.gpuBytesSaved));
+	OutputDebugStringA(dedupText);
+
 	// 終了処理 (unique_ptrなのでdelete不要)
 	titleScene.reset();
 	gameScene.reset();
+	gameOverScene.reset();
+	VoicePool::GetInstance()->Finalize();
+	XAudio2Sink::Finalize(); // BGM のボイスはシーンと一緒に閉じている
+	assetCache->Clear();
+	JobSystem::GetInstance()->Finalize();
+	Leaderboard::GetInstance()->Close();
+	AssetPack::GetInstance()->Close();
 
 	// エンジン終了の処理
 	KamataEngine::Finalize();
@@ -0,0 +1,550 @@
+// アセットのインクリメンタルビルド（オフライン・Linux）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++17 -O2 -IDirectXGame Tools/AssetBuild/*.cpp DirectXGame/Hash.cpp DirectXGame/FileBytes.cpp -pthread -o assetbuild
+//
+// 使い方:
+//   assetbuild [-C DirectXGame] [-T ツールのディレクトリ] [-j threads] [-s name,...] [-q name,...] [-t] [-n] [-v]
+//   -C : 実行ディレクトリ（Resources/ と Resources.pak、データベース AssetBuild.db がここに入る）
+//   -T : meshbaker / texcompress / audioconvert / packbuilder の場所（既定は assetbuild と同じディレクトリ）
+//   -j : 並列数（既定は論理コア数）
+//   -s : 法線を平滑化して焼くモデル（既定 Title,GameOverFont。ゲーム側で smoothing = true で読んでいるもの）
+//   -q : 頂点を量子化（VertexQuant、16 バイト）して焼くモデル（既定 meteorite,PlayerBullet,paddle）
+//   -t : MTL が参照する PNG を texcompress で .dds にする（DirectXTex でビルドした texcompress が要る）
+//   -n : 実行せず、作り直すものと理由だけ表示
+//   -v : 最新だったものも表示
+//
+// ビルドグラフ（毎回 Resources/ を走査して組み立てる）
+//   mesh    : Resources/<name>/<name>.obj → <name>.mesh   入力 = OBJ + mtllib の MTL
+//   texture : MTL の map_Kd の PNG → 同じ場所の .dds     入力 = PNG
+//   sfx     : Resources/ の .wav（BGM/ の下を除く）→ 同じ場所の .adpcm   入力 = WAV
+//             VoicePool が常駐させる効果音を IMA-ADPCM に（ストリーミングする BGM はそのまま）
+//   pack    : Resources/ → Resources.pak                入力 = パックに入る全ファイル + 上の出力
+// ・署名 = ルールの版 + ツール本体の内容ハッシュ + 引数 + 全入力のパスと内容ハッシュ
+//   前回と同じで出力も書き換えられていなければ実行しない
+// ・内容で比べるので、作り直した出力が前と同じバイト列なら後段は動かない
+// ・OBJ → MTL → PNG の参照は BuildDb に覚え、中身が変わったときだけ解析し直す
+// ・前段が終わったステップから並列に実行する
+#include "BuildDb.h"
+#include "Hash.h"
+#include "PackBlob.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// ルールや引数の組み立て方を変えたら上げる（全出力を作り直す）
+const uint32_t kRuleVersion = 1u;
+
+const char* kDbPath = "AssetBuild.db";
+const char* kPackPath = "Resources.pak";
+// PackBuilder の既定と同じ
+const char* kPackExtensions[] = {".mesh", ".obj", ".mtl", ".png", ".jpg", ".dds", ".wav", ".adpcm", ".csv"};
+// ここより下の WAV は StreamingVoice で流すので ADPCM にしない
+const char* kStreamedDirectory = "Resources/BGM/";
+
+enum class State {
+	kPending,
+	kUpToDate,
+	kBuilt,
+	kWouldBuild, // -n で作り直す予定
+	kFailed,
+	kSkipped, // 前段が失敗
+};
+
+struct Step {
+	const char* rule = "";
+	std::string tool; // ツール名（-T のディレクトリから探す）
+	std::vector<std::string> args;
+	std::vector<std::string> inputs; // ほかのステップの出力も含む（並べ替え・重複なし）
+	std::string output;
+	std::vector<size_t> next; // この出力を入力に使うステップ
+
+	// 実行時
+	size_t waiting = 0u; // 終わっていない前段の数
+	State state = State::kPending;
+	std::string reason;
+	bool upstreamChanged = false; // -n のとき前段が作り直しになる
+};
+
+struct Tool {
+	std::string path;
+	uint64_t hash = 0u;
+	bool found = false;
+};
+
+struct Options {
+	std::string root = ".";
+	std::string toolDir;
+	unsigned threads = 0u;
+	std::set<std::string> smoothed = {"title", "gameoverfont"};
+	std::set<std::string> quantized = {"meteorite", "playerbullet", "paddle"};
+	bool textures = false;
+	bool dryRun = false;
+	bool verbose = false;
+};
+
+void PrintUsage() { std::fprintf(stderr, "usage: assetbuild [-C root] [-T tooldir] [-j threads] [-s name,...] [-q name,...] [-t] [-n] [-v]\n"); }
+
+std::string DirectoryOf(const std::string& path) {
+	const size_t slash = path.find_last_of('/');
+	return slash == std::string::npos ? std::string() : path.substr(0, slash + 1u);
+}
+
+std::string ReplaceExtension(const std::string& path, const std::string& ext) { return path.substr(0, path.find_last_of('.')) + ext; }
+
+std::string LowerExtension(const fs::path& path) { return PackBlob::NormalizePath(path.extension().string()); }
+
+// "key 値" の行から参照を拾う（値は行末まで。パスは元ファイルの場所からの相対）
+// ・fileNameOnly : Model の map_Kd と同じく、フルパスで書かれていてもファイル名だけを使う
+std::vector<std::string> ScanReferences(const std::string& path, const char* key, bool fileNameOnly) {
+	std::vector<std::string> out;
+	std::ifstream file(path);
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream ls(line);
+		std::string word;
+		ls >> word;
+		if (word != key)
+			continue;
+		std::string value;
+		std::getline(ls >> std::ws, value);
+		while (!value.empty() && (value.back() == '\r' || value.back() == ' '))
+			value.pop_back();
+		if (fileNameOnly)
+			value = value.substr(value.find_last_of("/\\") + 1u);
+		if (!value.empty())
+			out.push_back(fs::path(DirectoryOf(path) + value).lexically_normal().generic_string());
+	}
+	return out;
+}
+
+// 参照は前回と中身が同じなら BuildDb から
+std::vector<std::string> References(BuildDb& db, const std::string& path, const char* key, bool fileNameOnly) {
+	std::vector<std::string> refs;
+	uint64_t hash = 0u;
+	if (!db.ContentHash(path, hash))
+		return refs;
+	if (!db.FindReferences(path, hash, refs)) {
+		refs = ScanReferences(path, key, fileNameOnly);
+		db.SetReferences(path, hash, refs);
+	}
+	return refs;
+}
+
+class Builder {
+public:
+	Builder(const Options& options, BuildDb& db) : options_(options), db_(db) {}
+
+	void Plan();
+	bool Run();
+	void PrintSummary(double ms) const;
+
+private:
+	size_t AddStep(const char* rule, const std::string& tool, std::vector<std::string> args, std::vector<std::string> inputs, const std::string& output);
+	void Link();
+	void Process(size_t index);
+	bool Signature(const Step& step, uint64_t& signature, std::string& error);
+	bool Spawn(const Step& step, std::string& error);
+	void Print(const char* format, ...);
+
+	const Options& options_;
+	BuildDb& db_;
+	std::map<std::string, Tool> tools_;
+	std::vector<Step> steps_;
+
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::deque<size_t> ready_;
+	size_t remaining_ = 0u;
+	size_t started_ = 0u;
+	std::mutex printMutex_;
+};
+
+size_t Builder::AddStep(const char* rule, const std::string& tool, std::vector<std::string> args, std::vector<std::string> inputs, const std::string& output) {
+	if (tools_.find(tool) == tools_.end()) {
+		Tool& t = tools_[tool];
+		t.path = (fs::path(options_.toolDir) / tool).string();
+		t.found = db_.ContentHash(t.path, t.hash);
+	}
+
+	std::sort(inputs.begin(), inputs.end());
+	inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+
+	Step step;
+	step.rule = rule;
+	step.tool = tool;
+	step.args = std::move(args);
+	step.inputs = std::move(inputs);
+	step.output = output;
+	steps_.push_back(std::move(step));
+	return steps_.size() - 1u;
+}
+
+void Builder::Plan() {
+	std::vector<std::string> objs, mtls, wavs, packed;
+	std::error_code ec;
+	for (const fs::directory_entry& entry : fs::recursive_directory_iterator("Resources", ec)) {
+		if (!entry.is_regular_file())
+			continue;
+		const std::string path = entry.path().generic_string();
+		const std::string ext = LowerExtension(entry.path());
+		if (ext == ".obj" && entry.path().stem() == entry.path().parent_path().filename())
+			objs.push_back(path);
+		else if (ext == ".mtl")
+			mtls.push_back(path);
+		else if (ext == ".wav" && path.rfind(kStreamedDirectory, 0) != 0)
+			wavs.push_back(path);
+		if (std::find(std::begin(kPackExtensions), std::end(kPackExtensions), ext) != std::end(kPackExtensions))
+			packed.push_back(path);
+	}
+	// 走査順に左右されないよう並べる
+	std::sort(objs.begin(), objs.end());
+	std::sort(mtls.begin(), mtls.end());
+	std::sort(wavs.begin(), wavs.end());
+
+	std::vector<std::string> outputs;
+	for (const std::string& obj : objs) {
+		const std::string mesh = ReplaceExtension(obj, ".mesh");
+		const std::string stem = PackBlob::NormalizePath(fs::path(obj).stem().string());
+		std::vector<std::string> args;
+		if (options_.smoothed.count(stem))
+			args.push_back("-s");
+		if (options_.quantized.count(stem))
+			args.push_back("-q");
+		args.insert(args.end(), {obj, "-o", mesh});
+
+		std::vector<std::string> inputs = References(db_, obj, "mtllib", false);
+		inputs.push_back(obj);
+		AddStep("mesh", "meshbaker", std::move(args), std::move(inputs), mesh);
+		outputs.push_back(mesh);
+	}
+
+	if (options_.textures) {
+		std::set<std::string> pngs;
+		for (const std::string& mtl : mtls) {
+			for (const std::string& ref : References(db_, mtl, "map_Kd", true)) {
+				if (LowerExtension(ref) == ".png")
+					pngs.insert(ref);
+			}
+		}
+		for (const std::string& png : pngs) {
+			const std::string dds = ReplaceExtension(png, ".dds");
+			AddStep("texture", "texcompress", {png}, {png}, dds);
+			outputs.push_back(dds);
+		}
+	}
+
+	// 音量はそのまま（ゲーム側の音量は元の WAV に合わせてある）、周波数はミキサーの出力にそろえる
+	for (const std::string& wav : wavs) {
+		const std::string adpcm = ReplaceExtension(wav, ".adpcm");
+		AddStep("sfx", "audioconvert", {"-a", "-N", "-m", "-", "-o", DirectoryOf(wav), wav}, {wav}, adpcm);
+		outputs.push_back(adpcm);
+	}
+
+	packed.insert(packed.end(), outputs.begin(), outputs.end());
+	AddStep("pack", "packbuilder", {"-C", ".", "-o", kPackPath, "-z", "Resources"}, std::move(packed), kPackPath);
+	Link();
+}
+
+// 出力 → それを入力に持つステップ
+void Builder::Link() {
+	std::map<std::string, size_t> producer;
+	for (size_t i = 0; i < steps_.size(); ++i)
+		producer[steps_[i].output] = i;
+	for (size_t i = 0; i < steps_.size(); ++i) {
+		for (const std::string& input : steps_[i].inputs) {
+			auto it = producer.find(input);
+			if (it != producer.end() && it->second != i) {
+				steps_[it->second].next.push_back(i);
+				steps_[i].waiting++;
+			}
+		}
+	}
+}
+
+bool Builder::Signature(const Step& step, uint64_t& signature, std::string& error) {
+	const Tool& tool = tools_.at(step.tool);
+	if (!tool.found) {
+		error = "tool not found: " + tool.path;
+		return false;
+	}
+
+	std::string key = std::to_string(kRuleVersion) + '\0' + step.rule + '\0';
+	key.append(reinterpret_cast<const char*>(&tool.hash), sizeof(tool.hash));
+	for (const std::string& arg : step.args)
+		key += '\0' + arg;
+	for (const std::string& input : step.inputs) {
+		uint64_t hash = 0u;
+		if (!db_.ContentHash(input, hash)) {
+			error = "missing input: " + input;
+			return false;
+		}
+		key += '\0' + input + '\0';
+		key.append(reinterpret_cast<const char*>(&hash), sizeof(hash));
+	}
+	signature = HashBytes(key.data(), key.size());
+	return true;
+}
+
+bool Builder::Spawn(const Step& step, std::string& error) {
+	std::vector<std::string> argvStorage;
+	argvStorage.push_back(tools_.at(step.tool).path);
+	argvStorage.insert(argvStorage.end(), step.args.begin(), step.args.end());
+	std::vector<char*> argv;
+	for (std::string& arg : argvStorage)
+		argv.push_back(arg.data());
+	argv.push_back(nullptr);
+
+	pid_t pid = 0;
+	const int err = posix_spawn(&pid, argv[0], nullptr, nullptr, argv.data(), environ);
+	if (err != 0) {
+		error = std::string("cannot start ") + argv[0] + ": " + std::strerror(err);
+		return false;
+	}
+	int status = 0;
+	if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		error = step.tool + " failed";
+		return false;
+	}
+	return true;
+}
+
+void Builder::Print(const char* format, ...) {
+	std::lock_guard<std::mutex> lock(printMutex_);
+	va_list args;
+	va_start(args, format);
+	std::vfprintf(stdout, format, args);
+	va_end(args);
+	std::fflush(stdout);
+}
+
+void Builder::Process(size_t index) {
+	Step& step = steps_[index];
+	if (step.state == State::kSkipped)
+		return;
+
+	// -n で前段を作り直す予定なら、入力がまだないこともあるので調べずに作り直し扱い
+	if (step.upstreamChanged) {
+		step.state = State::kWouldBuild;
+		step.reason = "input rebuilt";
+		return;
+	}
+
+	uint64_t signature = 0u;
+	std::string error;
+	if (!Signature(step, signature, error)) {
+		step.state = State::kFailed;
+		step.reason = error;
+		return;
+	}
+
+	uint64_t lastSignature = 0u, lastHash = 0u, outputHash = 0u;
+	if (!db_.FindOutput(step.output, lastSignature, lastHash))
+		step.reason = "new";
+	else if (lastSignature != signature)
+		step.reason = "inputs changed";
+	else if (!db_.ContentHash(step.output, outputHash))
+		step.reason = "output missing";
+	else if (outputHash != lastHash)
+		step.reason = "output modified";
+	else
+		step.state = State::kUpToDate;
+
+	if (step.state == State::kUpToDate) {
+		if (options_.verbose)
+			Print("up to date %s\n", step.output.c_str());
+		return;
+	}
+	if (options_.dryRun) {
+		step.state = State::kWouldBuild;
+		return;
+	}
+
+	size_t number = 0u;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		number = ++started_;
+	}
+	Print("[%zu] %s %s (%s)\n", number, step.rule, step.output.c_str(), step.reason.c_str());
+	if (!Spawn(step, error)) {
+		step.state = State::kFailed;
+		step.reason = error;
+		return;
+	}
+	if (!db_.ContentHash(step.output, outputHash)) {
+		step.state = State::kFailed;
+		step.reason = "output not written";
+		return;
+	}
+	db_.SetOutput(step.output, signature, outputHash);
+	step.state = State::kBuilt;
+}
+
+bool Builder::Run() {
+	remaining_ = steps_.size();
+	for (size_t i = 0; i < steps_.size(); ++i) {
+		if (steps_[i].waiting == 0u)
+			ready_.push_back(i);
+	}
+
+	auto worker = [this] {
+		std::unique_lock<std::mutex> lock(mutex_);
+		for (;;) {
+			cv_.wait(lock, [this] { return !ready_.empty() || remaining_ == 0u; });
+			if (ready_.empty())
+				return;
+			const size_t index = ready_.front();
+			ready_.pop_front();
+
+			lock.unlock();
+			Process(index);
+			lock.lock();
+
+			const Step& step = steps_[index];
+			for (size_t n : step.next) {
+				Step& next = steps_[n];
+				if (step.state == State::kFailed || step.state == State::kSkipped) {
+					next.state = State::kSkipped;
+					next.reason = "after failed " + step.output;
+				}
+				if (step.state == State::kWouldBuild)
+					next.upstreamChanged = true;
+				if (--next.waiting == 0u)
+					ready_.push_back(n);
+			}
+			remaining_--;
+			cv_.notify_all();
+		}
+	};
+
+	const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+	const size_t count = std::min<size_t>(options_.threads ? options_.threads : hardware, steps_.size());
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < count; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (std::thread& t : threads)
+		t.join();
+
+	bool ok = true;
+	for (const Step& step : steps_) {
+		if (step.state == State::kFailed) {
+			std::fprintf(stderr, "error: %s %s: %s\n", step.rule, step.output.c_str(), step.reason.c_str());
+			ok = false;
+		} else if (step.state == State::kWouldBuild) {
+			std::printf("would build %s %s (%s)\n", step.rule, step.output.c_str(), step.reason.c_str());
+		}
+	}
+	return ok;
+}
+
+void Builder::PrintSummary(double ms) const {
+	size_t built = 0u, upToDate = 0u, pending = 0u, failed = 0u;
+	for (const Step& step : steps_) {
+		switch (step.state) {
+		case State::kBuilt:
+			built++;
+			break;
+		case State::kUpToDate:
+			upToDate++;
+			break;
+		case State::kWouldBuild:
+			pending++;
+			break;
+		default:
+			failed++;
+			break;
+		}
+	}
+	const BuildDb::Stats stats = db_.GetStats();
+	std::printf("%zu steps: %zu built, %zu up to date, %zu to build, %zu failed; %u files checked, %u hashed (%.1f ms)\n", steps_.size(), built, upToDate, pending, failed,
+	            stats.statted, stats.hashed, ms);
+}
+
+std::set<std::string> SplitNames(const std::string& list) {
+	std::set<std::string> out;
+	std::stringstream ss(list);
+	std::string name;
+	while (std::getline(ss, name, ','))
+		out.insert(PackBlob::NormalizePath(name));
+	return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	const auto start = std::chrono::steady_clock::now();
+
+	Options options;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "-C" && i + 1 < argc) {
+			options.root = argv[++i];
+		} else if (arg == "-T" && i + 1 < argc) {
+			options.toolDir = argv[++i];
+		} else if (arg == "-j" && i + 1 < argc) {
+			options.threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+		} else if (arg == "-s" && i + 1 < argc) {
+			options.smoothed = SplitNames(argv[++i]);
+		} else if (arg == "-q" && i + 1 < argc) {
+			options.quantized = SplitNames(argv[++i]);
+		} else if (arg == "-t") {
+			options.textures = true;
+		} else if (arg == "-n") {
+			options.dryRun = true;
+		} else if (arg == "-v") {
+			options.verbose = true;
+		} else {
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	// ツールの場所は実行ディレクトリを移る前に絶対パスにしておく
+	std::error_code ec;
+	if (options.toolDir.empty()) {
+		fs::path self = fs::read_symlink("/proc/self/exe", ec);
+		options.toolDir = (ec ? fs::absolute(argv[0], ec) : self).parent_path().string();
+	}
+	options.toolDir = fs::absolute(options.toolDir, ec).string();
+	fs::current_path(options.root, ec);
+	if (ec) {
+		std::fprintf(stderr, "error: cannot enter %s\n", options.root.c_str());
+		return 1;
+	}
+
+	BuildDb db;
+	db.Load(kDbPath);
+
+	Builder builder(options, db);
+	builder.Plan();
+	const bool ok = builder.Run();
+	if (!options.dryRun && !db.Save(kDbPath)) {
+		std::fprintf(stderr, "error: cannot write %s\n", kDbPath);
+		return 1;
+	}
+
+	builder.PrintSummary(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	return ok ? 0 : 1;
+}
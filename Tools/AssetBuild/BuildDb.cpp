@@ -0,0 +1,159 @@
+#include "BuildDb.h"
+#include "Hash.h"
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+const char* kDbHeader = "assetbuild-db 1";
+
+std::vector<std::string> SplitTabs(const std::string& line) {
+	std::vector<std::string> fields;
+	std::stringstream ss(line);
+	std::string field;
+	while (std::getline(ss, field, '\t'))
+		fields.push_back(field);
+	return fields;
+}
+
+uint64_t ParseHex(const std::string& text) { return std::strtoull(text.c_str(), nullptr, 16); }
+
+} // namespace
+
+bool BuildDb::Load(const std::string& path) {
+	std::ifstream file(path);
+	std::string line;
+	if (!file || !std::getline(file, line) || line != kDbHeader)
+		return false;
+
+	while (std::getline(file, line)) {
+		const std::vector<std::string> f = SplitTabs(line);
+		if (f.size() == 5u && f[0] == "F") {
+			FileRecord& r = files_[f[4]];
+			r.size = std::strtoull(f[1].c_str(), nullptr, 10);
+			r.mtime = std::strtoll(f[2].c_str(), nullptr, 10);
+			r.hash = ParseHex(f[3]);
+		} else if (f.size() >= 3u && f[0] == "R") {
+			ReferenceRecord& r = references_[f[2]];
+			r.hash = ParseHex(f[1]);
+			r.references.assign(f.begin() + 3, f.end());
+		} else if (f.size() == 4u && f[0] == "O") {
+			OutputRecord& r = outputs_[f[3]];
+			r.signature = ParseHex(f[1]);
+			r.outputHash = ParseHex(f[2]);
+		}
+	}
+	return true;
+}
+
+bool BuildDb::Save(const std::string& path) const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	const std::string temp = path + ".tmp";
+	FILE* fp = std::fopen(temp.c_str(), "wb");
+	if (!fp)
+		return false;
+
+	std::fprintf(fp, "%s\n", kDbHeader);
+	for (const auto& [name, r] : files_) {
+		if (r.used)
+			std::fprintf(fp, "F\t%" PRIu64 "\t%" PRId64 "\t%016" PRIx64 "\t%s\n", r.size, r.mtime, r.hash, name.c_str());
+	}
+	for (const auto& [name, r] : references_) {
+		if (!r.used)
+			continue;
+		std::fprintf(fp, "R\t%016" PRIx64 "\t%s", r.hash, name.c_str());
+		for (const std::string& ref : r.references)
+			std::fprintf(fp, "\t%s", ref.c_str());
+		std::fputc('\n', fp);
+	}
+	for (const auto& [name, r] : outputs_) {
+		if (r.used)
+			std::fprintf(fp, "O\t%016" PRIx64 "\t%016" PRIx64 "\t%s\n", r.signature, r.outputHash, name.c_str());
+	}
+	if (std::fclose(fp) != 0)
+		return false;
+
+	// 途中で止まっても前回のものが残るよう、書き終えてから置き換える
+	std::error_code ec;
+	std::filesystem::rename(temp, path, ec);
+	return !ec;
+}
+
+bool BuildDb::ContentHash(const std::string& path, uint64_t& hash) {
+	std::error_code ec;
+	const uint64_t size = std::filesystem::file_size(path, ec);
+	if (ec)
+		return false;
+	const int64_t mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+	if (ec)
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.statted++;
+		auto it = files_.find(path);
+		if (it != files_.end() && it->second.size == size && it->second.mtime == mtime) {
+			it->second.used = true;
+			hash = it->second.hash;
+			return true;
+		}
+	}
+
+	// 読むのはロックの外で
+	if (!HashFile(path, hash))
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	stats_.hashed++;
+	FileRecord& r = files_[path];
+	r.size = size;
+	r.mtime = mtime;
+	r.hash = hash;
+	r.used = true;
+	return true;
+}
+
+bool BuildDb::FindReferences(const std::string& path, uint64_t hash, std::vector<std::string>& references) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = references_.find(path);
+	if (it == references_.end() || it->second.hash != hash)
+		return false;
+	it->second.used = true;
+	references = it->second.references;
+	return true;
+}
+
+void BuildDb::SetReferences(const std::string& path, uint64_t hash, const std::vector<std::string>& references) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	ReferenceRecord& r = references_[path];
+	r.hash = hash;
+	r.references = references;
+	r.used = true;
+}
+
+bool BuildDb::FindOutput(const std::string& output, uint64_t& signature, uint64_t& outputHash) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = outputs_.find(output);
+	if (it == outputs_.end())
+		return false;
+	it->second.used = true;
+	signature = it->second.signature;
+	outputHash = it->second.outputHash;
+	return true;
+}
+
+void BuildDb::SetOutput(const std::string& output, uint64_t signature, uint64_t outputHash) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	OutputRecord& r = outputs_[output];
+	r.signature = signature;
+	r.outputHash = outputHash;
+	r.used = true;
+}
+
+BuildDb::Stats BuildDb::GetStats() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return stats_;
+}
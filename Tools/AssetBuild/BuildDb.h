@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// アセットビルドのデータベース（前回のビルド結果）
+// ・ファイルの内容ハッシュ（大きさと更新時刻が同じなら読み直さない）
+// ・OBJ の mtllib / MTL の map_Kd など、ファイルから拾った参照（中身が同じなら解析し直さない）
+// ・出力ごとの署名（ツール・引数・全入力の内容ハッシュから作る）と、書き出した出力の内容ハッシュ
+// ・パスは実行ディレクトリからの相対パス。ワーカーから同時に呼べる
+class BuildDb {
+public:
+	struct Stats {
+		uint32_t statted = 0u; // 更新時刻を調べたファイル
+		uint32_t hashed = 0u;  // 中身を読んでハッシュしたファイル
+	};
+
+	// 読めない・形式が違うときは空から始める（false）
+	bool Load(const std::string& path);
+	// 今回のビルドで触れたものだけを書く
+	bool Save(const std::string& path) const;
+
+	// 内容ハッシュ。ファイルがなければ false
+	bool ContentHash(const std::string& path, uint64_t& hash);
+
+	// 中身が hash のときに拾った参照
+	bool FindReferences(const std::string& path, uint64_t hash, std::vector<std::string>& references);
+	void SetReferences(const std::string& path, uint64_t hash, const std::vector<std::string>& references);
+
+	// 出力を最後に作ったときの署名と出力の内容ハッシュ
+	bool FindOutput(const std::string& output, uint64_t& signature, uint64_t& outputHash);
+	void SetOutput(const std::string& output, uint64_t signature, uint64_t outputHash);
+
+	Stats GetStats() const;
+
+private:
+	struct FileRecord {
+		uint64_t size = 0u;
+		int64_t mtime = 0;
+		uint64_t hash = 0u;
+		bool used = false;
+	};
+	struct ReferenceRecord {
+		uint64_t hash = 0u;
+		std::vector<std::string> references;
+		bool used = false;
+	};
+	struct OutputRecord {
+		uint64_t signature = 0u;
+		uint64_t outputHash = 0u;
+		bool used = false;
+	};
+
+	mutable std::mutex mutex_;
+	std::unordered_map<std::string, FileRecord> files_;
+	std::unordered_map<std::string, ReferenceRecord> references_;
+	std::unordered_map<std::string, OutputRecord> outputs_;
+	Stats stats_;
+};
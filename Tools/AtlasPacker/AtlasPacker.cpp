@@ -0,0 +1,234 @@
+// UI 用テクスチャアトラス作成ツール（オフライン・Linux / Windows 共通）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++17 -O2 -ITools/Common -IExternal/imgui Tools/AtlasPacker/AtlasPacker.cpp Tools/Common/Png.cpp -lz -o atlaspacker
+//
+// 使い方:
+//   atlaspacker -o DirectXGame/Resources/UiAtlas.png -g DirectXGame/UiAtlas.h -n UiAtlas [-p 2] [-m 2048] 名前=画像.png ...
+//   （名前を省くとファイル名の拡張子なし部分を使う）
+//
+// ・imstb_rectpack で詰め、各画像の周囲 padding ピクセルは端の色で埋める（フィルタのにじみ対策）
+// ・矩形表（名前 → ピクセル矩形）を C++ ヘッダとして書き出す
+#include "Png.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+namespace {
+
+struct Entry {
+	std::string name;
+	std::string path;
+	Png::Image image;
+	uint32_t x = 0u; // アトラス上の左上（padding を除く）
+	uint32_t y = 0u;
+};
+
+void PrintUsage() { std::fprintf(stderr, "usage: atlaspacker -o atlas.png -g table.h -n Namespace [-t TextureFile] [-p padding] [-m maxSize] name=image.png ...\n"); }
+
+std::string StemOf(const std::string& path) {
+	size_t slash = path.find_last_of("/\\");
+	std::string file = slash == std::string::npos ? path : path.substr(slash + 1u);
+	size_t dot = file.find_last_of('.');
+	return dot == std::string::npos ? file : file.substr(0, dot);
+}
+
+std::string FileNameOf(const std::string& path) {
+	size_t slash = path.find_last_of("/\\");
+	return slash == std::string::npos ? path : path.substr(slash + 1u);
+}
+
+// "ui_pause_menu" → "kUiPauseMenu"
+std::string EnumNameOf(const std::string& name) {
+	std::string out = "k";
+	bool upper = true;
+	for (char c : name) {
+		if (!std::isalnum(static_cast<unsigned char>(c))) {
+			upper = true;
+			continue;
+		}
+		out += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+		upper = false;
+	}
+	return out;
+}
+
+// w x h に全部入るか試す
+bool TryPack(std::vector<Entry>& entries, int width, int height, int padding) {
+	std::vector<stbrp_node> nodes(width);
+	stbrp_context context;
+	stbrp_init_target(&context, width, height, nodes.data(), static_cast<int>(nodes.size()));
+
+	std::vector<stbrp_rect> rects(entries.size());
+	for (size_t i = 0; i < entries.size(); ++i) {
+		rects[i].id = static_cast<int>(i);
+		rects[i].w = static_cast<int>(entries[i].image.width) + padding * 2;
+		rects[i].h = static_cast<int>(entries[i].image.height) + padding * 2;
+	}
+	if (!stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size())))
+		return false;
+
+	for (const stbrp_rect& r : rects) {
+		entries[r.id].x = static_cast<uint32_t>(r.x + padding);
+		entries[r.id].y = static_cast<uint32_t>(r.y + padding);
+	}
+	return true;
+}
+
+// 画像をコピーし、周囲 padding を端の画素で埋める
+void Blit(Png::Image& atlas, const Entry& e, int padding) {
+	const int w = static_cast<int>(e.image.width);
+	const int h = static_cast<int>(e.image.height);
+	for (int y = -padding; y < h + padding; ++y) {
+		for (int x = -padding; x < w + padding; ++x) {
+			const int sx = std::clamp(x, 0, w - 1);
+			const int sy = std::clamp(y, 0, h - 1);
+			const uint8_t* src = e.image.Pixel(static_cast<uint32_t>(sx), static_cast<uint32_t>(sy));
+			uint8_t* dst = atlas.Pixel(static_cast<uint32_t>(static_cast<int>(e.x) + x), static_cast<uint32_t>(static_cast<int>(e.y) + y));
+			std::copy(src, src + 4, dst);
+		}
+	}
+}
+
+bool WriteTable(const std::string& path, const std::string& ns, const std::string& textureFile, const Png::Image& atlas, const std::vector<Entry>& entries) {
+	FILE* fp = std::fopen(path.c_str(), "wb");
+	if (!fp)
+		return false;
+
+	std::fprintf(fp, "#pragma once\n");
+	std::fprintf(fp, "// このファイルは Tools/AtlasPacker が生成する。手で編集しない\n");
+	std::fprintf(fp, "#include \"TextureAtlas.h\"\n\n");
+	std::fprintf(fp, "namespace %s {\n\n", ns.c_str());
+	std::fprintf(fp, "inline const char* const kTextureFile = \"%s\";\n", textureFile.c_str());
+	std::fprintf(fp, "inline const uint32_t kWidth = %uu;\n", atlas.width);
+	std::fprintf(fp, "inline const uint32_t kHeight = %uu;\n\n", atlas.height);
+
+	std::fprintf(fp, "enum Id : uint32_t {\n");
+	for (const Entry& e : entries)
+		std::fprintf(fp, "\t%s,\n", EnumNameOf(e.name).c_str());
+	std::fprintf(fp, "\tkCount\n};\n\n");
+
+	std::fprintf(fp, "// 名前, x, y, 幅, 高さ（ピクセル・padding を除く）\n");
+	std::fprintf(fp, "inline const AtlasRect kRects[kCount] = {\n");
+	for (const Entry& e : entries)
+		std::fprintf(fp, "    {\"%s\", %u, %u, %u, %u},\n", e.name.c_str(), e.x, e.y, e.image.width, e.image.height);
+	std::fprintf(fp, "};\n\n");
+	std::fprintf(fp, "} // namespace %s\n", ns.c_str());
+
+	return std::fclose(fp) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	std::string outPng, outTable, ns = "Atlas", textureFile;
+	int padding = 2;
+	int maxSize = 2048;
+	std::vector<Entry> entries;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		auto next = [&](std::string& v) {
+			if (i + 1 >= argc)
+				return false;
+			v = argv[++i];
+			return true;
+		};
+		std::string v;
+		if (arg == "-o") {
+			if (!next(outPng))
+				return PrintUsage(), 1;
+		} else if (arg == "-g") {
+			if (!next(outTable))
+				return PrintUsage(), 1;
+		} else if (arg == "-n") {
+			if (!next(ns))
+				return PrintUsage(), 1;
+		} else if (arg == "-t") {
+			if (!next(textureFile))
+				return PrintUsage(), 1;
+		} else if (arg == "-p") {
+			if (!next(v))
+				return PrintUsage(), 1;
+			padding = std::max(0, std::atoi(v.c_str()));
+		} else if (arg == "-m") {
+			if (!next(v))
+				return PrintUsage(), 1;
+			maxSize = std::max(1, std::atoi(v.c_str()));
+		} else {
+			Entry e;
+			size_t eq = arg.find('=');
+			e.path = eq == std::string::npos ? arg : arg.substr(eq + 1u);
+			e.name = eq == std::string::npos ? StemOf(arg) : arg.substr(0, eq);
+			entries.push_back(e);
+		}
+	}
+	if (outPng.empty() || outTable.empty() || entries.empty()) {
+		PrintUsage();
+		return 1;
+	}
+	if (textureFile.empty())
+		textureFile = FileNameOf(outPng);
+
+	// 読み込み
+	uint64_t area = 0u;
+	for (Entry& e : entries) {
+		std::string error;
+		if (!Png::Load(e.path, e.image, error)) {
+			std::fprintf(stderr, "error: %s\n", error.c_str());
+			return 1;
+		}
+		for (const Entry& other : entries) {
+			if (&other != &e && other.name == e.name) {
+				std::fprintf(stderr, "error: duplicate name '%s'\n", e.name.c_str());
+				return 1;
+			}
+		}
+		area += static_cast<uint64_t>(e.image.width + padding * 2) * (e.image.height + padding * 2);
+	}
+
+	// 2のべき乗で、面積の小さい順に試す（横長 → 正方形）
+	int width = 0, height = 0;
+	for (int size = 64; size <= maxSize && width == 0; size *= 2) {
+		const int candidates[2][2] = {{size, size / 2}, {size, size}};
+		for (const auto& c : candidates) {
+			if (static_cast<uint64_t>(c[0]) * c[1] < area)
+				continue;
+			if (TryPack(entries, c[0], c[1], padding)) {
+				width = c[0];
+				height = c[1];
+				break;
+			}
+		}
+	}
+	if (width == 0) {
+		std::fprintf(stderr, "error: images do not fit in %dx%d\n", maxSize, maxSize);
+		return 1;
+	}
+
+	Png::Image atlas;
+	atlas.width = static_cast<uint32_t>(width);
+	atlas.height = static_cast<uint32_t>(height);
+	atlas.rgba.assign(static_cast<size_t>(width) * height * 4u, 0u);
+	for (const Entry& e : entries)
+		Blit(atlas, e, padding);
+
+	std::string error;
+	if (!Png::Save(outPng, atlas, error)) {
+		std::fprintf(stderr, "error: %s\n", error.c_str());
+		return 1;
+	}
+	if (!WriteTable(outTable, ns, textureFile, atlas, entries)) {
+		std::fprintf(stderr, "error: cannot write %s\n", outTable.c_str());
+		return 1;
+	}
+
+	std::printf("%s: %dx%d, %zu images, %.1f%% used\n", outPng.c_str(), width, height, entries.size(), 100.0 * static_cast<double>(area) / (static_cast<double>(width) * height));
+	return 0;
+}
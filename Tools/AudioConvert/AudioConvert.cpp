@@ -0,0 +1,399 @@
+// WAV を1つの形式（既定 48kHz・16bit）へ揃え、ラウドネスを合わせるツール（オフライン・Linux / Windows 共通）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -IDirectXGame Tools/AudioConvert/*.cpp DirectXGame/WaveFile.cpp DirectXGame/FileBytes.cpp DirectXGame/Adpcm.cpp -o audioconvert
+//
+// 使い方:
+//   audioconvert [-o 出力先] [-m manifest] [-r 周波数] [-c チャンネル数] [-l LUFS] [-p dBFS] [-N] [-D] [-a] 入力 ...
+//   入力 : WAV かディレクトリ（再帰的にたどって .wav を全部。BGM/ も Resources/ の下にある）
+//   -o : 出力先のディレクトリ（入力がディレクトリならその中の相対パスのまま置く）。省くと元のファイルを書き換える
+//   -m : マニフェストの書き出し先（既定は -o の中、なければ実行ディレクトリの AudioManifest.txt。- なら書かない）
+//   -r : 出力の周波数（既定 48000 = VoicePool のミキサーの出力。そろえておくと補間なしで混ぜられる）
+//   -c : 出力のチャンネル数（1 / 2。既定は元のまま）
+//   -l : 合わせるラウドネス（BS.1770 の積分ラウドネス、既定 -16 LUFS）
+//   -p : サンプルピークの上限（既定 -1 dBFS。ラウドネスを上げると超えるときはここで止める）
+//   -N : ラウドネスを合わせない（形式だけ変える）
+//   -D : 16bit へ丸めるときにディザーを掛けない
+//   -a : IMA-ADPCM（4bit、1/4 の大きさ）で拡張子 .adpcm のファイルに書く（常駐させる効果音用。アセットビルドが使う）
+//
+// ・周波数はポリフェーズ FIR（Resampler）で変える。16bit へは TPDF ディザーを足して丸める
+// ・すでに出力の形式で、掛ける利得が ±0.1dB 未満のファイルは書き換えない（何度かけても劣化しない。-a のときは除く）
+// ・-a の ADPCM はチャンネルあたり 256 バイトのブロック（505 サンプル）。16bit に丸めてから符号化する
+// ・マニフェストはタブ区切りで、1 行に 1 ファイル（元と出力の形式・ラウドネス・利得・ピーク・サイズ）
+#include "Adpcm.h"
+#include "AudioDsp.h"
+#include "FileBytes.h"
+#include "WaveFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// ADPCM のブロック（チャンネルあたりのバイト数）
+const uint32_t kAdpcmBlockBytesPerChannel = 256u;
+
+struct Options {
+	std::string outDir;
+	std::string manifest;
+	uint32_t rate = 48000u;
+	uint32_t channels = 0u; // 0 = 元のまま
+	double targetLufs = -16.0;
+	double peakDb = -1.0;
+	bool normalize = true;
+	bool dither = true;
+	bool adpcm = false;
+};
+
+struct Job {
+	std::string input;
+	std::string output;
+};
+
+struct Result {
+	std::string path;
+	WaveFormat source;
+	uint32_t rate = 0u;
+	uint32_t channels = 0u;
+	bool adpcm = false;
+	double seconds = 0.0;
+	double loudnessIn = 0.0;
+	double loudnessOut = 0.0;
+	double gainDb = 0.0;
+	double peakOutDb = 0.0;
+	size_t bytesIn = 0u;
+	size_t bytesOut = 0u;
+	bool changed = false;
+};
+
+void PrintUsage() {
+	std::fprintf(stderr, "usage: audioconvert [-o outdir] [-m manifest] [-r rate] [-c channels] [-l lufs] [-p dbfs] [-N] [-D] [-a] input ...\n");
+}
+
+double ToDb(double x) { return 20.0 * std::log10(std::max(x, 1e-10)); }
+
+bool IsWav(const fs::path& path) {
+	std::string ext = path.extension().string();
+	std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return ext == ".wav";
+}
+
+// 元の波形をチャンネルごとの float に（PCM 8 / 16 / 24 / 32bit・float）
+bool Decode(const WaveView& wave, std::vector<std::vector<float>>& channels) {
+	const WaveFormat& f = wave.format;
+	const uint32_t bytes = f.bitsPerSample / 8u;
+	const bool isFloat = f.formatTag == 3u && f.bitsPerSample == 32u;
+	const bool isPcm = f.formatTag == 1u && (f.bitsPerSample == 8u || f.bitsPerSample == 16u || f.bitsPerSample == 24u || f.bitsPerSample == 32u);
+	if ((!isFloat && !isPcm) || f.channels == 0u || f.blockAlign != f.channels * bytes)
+		return false;
+
+	const size_t frames = wave.samples.size() / f.blockAlign;
+	channels.assign(f.channels, std::vector<float>(frames));
+	const uint8_t* p = wave.samples.data();
+	for (size_t i = 0; i < frames; ++i) {
+		for (uint32_t c = 0; c < f.channels; ++c, p += bytes) {
+			float s = 0.0f;
+			if (isFloat) {
+				std::memcpy(&s, p, sizeof(s));
+			} else if (bytes == 1u) {
+				s = (float(p[0]) - 128.0f) * (1.0f / 128.0f);
+			} else {
+				// 上位に詰めて符号付き 32bit として読む
+				uint32_t v = 0u;
+				for (uint32_t b = 0; b < bytes; ++b)
+					v |= uint32_t(p[b]) << (8u * (4u - bytes + b));
+				s = float(static_cast<int32_t>(v)) * (1.0f / 2147483648.0f);
+			}
+			channels[c][i] = s;
+		}
+	}
+	return true;
+}
+
+void Put16(std::vector<uint8_t>& out, uint16_t v) {
+	out.push_back(static_cast<uint8_t>(v));
+	out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void Put32(std::vector<uint8_t>& out, uint32_t v) {
+	for (int i = 0; i < 4; ++i)
+		out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+std::vector<uint8_t> EncodeWave16(const std::vector<int16_t>& samples, uint32_t channels, uint32_t rate) {
+	const uint32_t dataBytes = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
+	std::vector<uint8_t> out;
+	out.reserve(44u + dataBytes);
+	out.insert(out.end(), {'R', 'I', 'F', 'F'});
+	Put32(out, 36u + dataBytes);
+	out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+	Put32(out, 16u);
+	Put16(out, 1u);
+	Put16(out, static_cast<uint16_t>(channels));
+	Put32(out, rate);
+	Put32(out, rate * channels * 2u);
+	Put16(out, static_cast<uint16_t>(channels * 2u));
+	Put16(out, 16u);
+	out.insert(out.end(), {'d', 'a', 't', 'a'});
+	Put32(out, dataBytes);
+	for (int16_t s : samples)
+		Put16(out, static_cast<uint16_t>(s));
+	return out;
+}
+
+// IMA-ADPCM の WAVE（fmt の拡張部に samplesPerBlock、fact にフレーム数）
+std::vector<uint8_t> EncodeWaveAdpcm(const std::vector<int16_t>& samples, uint32_t channels, uint32_t rate) {
+	const uint32_t blockAlign = kAdpcmBlockBytesPerChannel * channels;
+	const uint32_t samplesPerBlock = (kAdpcmBlockBytesPerChannel - 4u) * 2u + 1u;
+	const size_t frames = samples.size() / channels;
+	const std::vector<uint8_t> data = Adpcm::Encode(samples.data(), frames, channels, samplesPerBlock);
+	const uint32_t dataBytes = static_cast<uint32_t>(data.size());
+	std::vector<uint8_t> out;
+	out.reserve(60u + dataBytes);
+	out.insert(out.end(), {'R', 'I', 'F', 'F'});
+	Put32(out, 52u + dataBytes);
+	out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+	Put32(out, 20u);
+	Put16(out, Adpcm::kFormatTag);
+	Put16(out, static_cast<uint16_t>(channels));
+	Put32(out, rate);
+	Put32(out, static_cast<uint32_t>(uint64_t(rate) * blockAlign / samplesPerBlock));
+	Put16(out, static_cast<uint16_t>(blockAlign));
+	Put16(out, 4u);
+	Put16(out, 2u);
+	Put16(out, static_cast<uint16_t>(samplesPerBlock));
+	out.insert(out.end(), {'f', 'a', 'c', 't'});
+	Put32(out, 4u);
+	Put32(out, static_cast<uint32_t>(frames));
+	out.insert(out.end(), {'d', 'a', 't', 'a'});
+	Put32(out, dataBytes);
+	out.insert(out.end(), data.begin(), data.end());
+	if (dataBytes & 1u)
+		out.push_back(0u);
+	return out;
+}
+
+bool WriteFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+	std::error_code ec;
+	const fs::path parent = fs::path(path).parent_path();
+	if (!parent.empty())
+		fs::create_directories(parent, ec);
+	// 元のファイルを書き換えるときに途中で壊さないよう、別名で書いてから置き換える
+	const std::string temp = path + ".tmp";
+	FILE* fp = std::fopen(temp.c_str(), "wb");
+	if (!fp)
+		return false;
+	const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), fp) == bytes.size();
+	if (std::fclose(fp) != 0 || !ok)
+		return false;
+	fs::rename(temp, path, ec);
+	return !ec;
+}
+
+bool Convert(const Options& options, const Job& job, Result& result, std::string& error) {
+	std::vector<uint8_t> bytes;
+	WaveView wave;
+	if (!ReadFileBytes(job.input, bytes)) {
+		error = "cannot read";
+		return false;
+	}
+	if (!ParseWave(bytes, wave)) {
+		error = "not a WAV";
+		return false;
+	}
+	std::vector<std::vector<float>> channels;
+	if (!Decode(wave, channels)) {
+		error = "unsupported format (tag " + std::to_string(wave.format.formatTag) + ", " + std::to_string(wave.format.bitsPerSample) + " bit)";
+		return false;
+	}
+
+	result.path = job.output;
+	result.source = wave.format;
+	result.bytesIn = bytes.size();
+	result.rate = options.rate;
+	result.channels = options.channels ? options.channels : wave.format.channels;
+	result.adpcm = options.adpcm;
+
+	// チャンネル数（モノラルへは平均、ステレオへは複製）
+	if (result.channels == 1u && channels.size() > 1u) {
+		std::vector<float> mono(channels[0].size(), 0.0f);
+		for (const std::vector<float>& channel : channels) {
+			for (size_t i = 0; i < mono.size(); ++i)
+				mono[i] += channel[i] / float(channels.size());
+		}
+		channels.assign(1u, std::move(mono));
+	} else if (result.channels == 2u && channels.size() == 1u) {
+		channels.push_back(channels[0]);
+	} else if (result.channels != channels.size()) {
+		error = "cannot map " + std::to_string(channels.size()) + " channels";
+		return false;
+	}
+
+	Resampler resampler;
+	if (!resampler.Initialize(wave.format.sampleRate, options.rate)) {
+		error = "unsupported rate ratio " + std::to_string(wave.format.sampleRate) + ":" + std::to_string(options.rate);
+		return false;
+	}
+	for (std::vector<float>& channel : channels)
+		channel = resampler.Process(channel);
+	result.seconds = channels[0].empty() ? 0.0 : double(channels[0].size()) / options.rate;
+
+	// ラウドネスを目標へ。ピークが上限を超えるならそこで止める
+	result.loudnessIn = MeasureLoudness(channels, options.rate);
+	const double peakDb = ToDb(MeasurePeak(channels));
+	double gainDb = 0.0;
+	if (options.normalize && result.loudnessIn > -70.0)
+		gainDb = std::min(options.targetLufs - result.loudnessIn, options.peakDb - peakDb);
+	result.gainDb = gainDb;
+	result.loudnessOut = result.loudnessIn + gainDb;
+	result.peakOutDb = peakDb + gainDb;
+
+	const bool sameFormat = wave.format.formatTag == 1u && wave.format.bitsPerSample == 16u && wave.format.sampleRate == options.rate && wave.format.channels == result.channels;
+	if (sameFormat && !options.adpcm && std::fabs(gainDb) < 0.1) {
+		result.gainDb = 0.0;
+		result.loudnessOut = result.loudnessIn;
+		result.peakOutDb = peakDb;
+		result.bytesOut = bytes.size();
+		result.changed = false;
+		if (job.output != job.input && !WriteFile(job.output, bytes)) {
+			error = "cannot write " + job.output;
+			return false;
+		}
+		return true;
+	}
+
+	// ディザーの種はパスから決める（同じ入力なら同じ出力）
+	uint32_t seed = 2166136261u;
+	for (char c : job.output)
+		seed = (seed ^ static_cast<uint8_t>(c)) * 16777619u;
+	const std::vector<int16_t> samples = QuantizeTo16(channels, static_cast<float>(std::pow(10.0, gainDb / 20.0)), options.dither, seed);
+	const std::vector<uint8_t> out = options.adpcm ? EncodeWaveAdpcm(samples, result.channels, options.rate) : EncodeWave16(samples, result.channels, options.rate);
+	result.bytesOut = out.size();
+	result.changed = true;
+	if (!WriteFile(job.output, out)) {
+		error = "cannot write " + job.output;
+		return false;
+	}
+	return true;
+}
+
+std::string FormatName(const WaveFormat& f) {
+	return std::to_string(f.sampleRate) + "Hz/" + std::to_string(f.bitsPerSample) + "bit" + (f.formatTag == 3u ? "f" : "") + "/" + std::to_string(f.channels) + "ch";
+}
+
+std::string OutputName(const Result& r) { return std::to_string(r.rate) + (r.adpcm ? "Hz/adpcm/" : "Hz/16bit/") + std::to_string(r.channels) + "ch"; }
+
+bool WriteManifest(const std::string& path, const Options& options, const std::vector<Result>& results) {
+	FILE* fp = std::fopen(path.c_str(), "w");
+	if (!fp)
+		return false;
+	std::fprintf(fp, "# audioconvert: %uHz %s, target %.1f LUFS, peak %.1f dBFS%s%s\n", options.rate, options.adpcm ? "IMA-ADPCM" : "16bit", options.targetLufs, options.peakDb,
+	             options.normalize ? "" : ", no normalize", options.dither ? ", TPDF dither" : "");
+	std::fprintf(fp, "# path\tsource\toutput\tseconds\tlufs_in\tlufs_out\tgain_db\tpeak_dbfs\tbytes_in\tbytes_out\tchanged\n");
+	for (const Result& r : results) {
+		std::fprintf(fp, "%s\t%s\t%s\t%.3f\t%.2f\t%.2f\t%.2f\t%.2f\t%zu\t%zu\t%d\n", r.path.c_str(), FormatName(r.source).c_str(), OutputName(r).c_str(), r.seconds, r.loudnessIn,
+		             r.loudnessOut, r.gainDb, r.peakOutDb, r.bytesIn, r.bytesOut, r.changed ? 1 : 0);
+	}
+	return std::fclose(fp) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	std::vector<std::string> inputs;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "-o" && i + 1 < argc) {
+			options.outDir = argv[++i];
+		} else if (arg == "-m" && i + 1 < argc) {
+			options.manifest = argv[++i];
+		} else if (arg == "-r" && i + 1 < argc) {
+			options.rate = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else if (arg == "-c" && i + 1 < argc) {
+			options.channels = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else if (arg == "-l" && i + 1 < argc) {
+			options.targetLufs = std::atof(argv[++i]);
+		} else if (arg == "-p" && i + 1 < argc) {
+			options.peakDb = std::atof(argv[++i]);
+		} else if (arg == "-N") {
+			options.normalize = false;
+		} else if (arg == "-D") {
+			options.dither = false;
+		} else if (arg == "-a") {
+			options.adpcm = true;
+		} else if (!arg.empty() && arg[0] != '-') {
+			inputs.push_back(arg);
+		} else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (inputs.empty() || options.rate == 0u || options.channels > 2u) {
+		PrintUsage();
+		return 1;
+	}
+	if (options.manifest.empty())
+		options.manifest = (options.outDir.empty() ? fs::path("AudioManifest.txt") : fs::path(options.outDir) / "AudioManifest.txt").generic_string();
+
+	// 入力 → 出力の組を作る
+	std::vector<Job> jobs;
+	for (const std::string& input : inputs) {
+		std::error_code ec;
+		if (fs::is_directory(input, ec)) {
+			std::vector<fs::path> files;
+			for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, ec)) {
+				if (entry.is_regular_file() && IsWav(entry.path()))
+					files.push_back(entry.path());
+			}
+			std::sort(files.begin(), files.end());
+			for (const fs::path& file : files) {
+				fs::path out = options.outDir.empty() ? file : fs::path(options.outDir) / fs::relative(file, input, ec);
+				if (options.adpcm)
+					out.replace_extension(".adpcm");
+				jobs.push_back({file.generic_string(), out.generic_string()});
+			}
+		} else {
+			fs::path out = options.outDir.empty() ? fs::path(input) : fs::path(options.outDir) / fs::path(input).filename();
+			if (options.adpcm)
+				out.replace_extension(".adpcm");
+			jobs.push_back({input, out.generic_string()});
+		}
+	}
+
+	std::vector<Result> results;
+	int failed = 0;
+	size_t bytesIn = 0u, bytesOut = 0u;
+	for (const Job& job : jobs) {
+		const auto t0 = std::chrono::steady_clock::now();
+		Result result;
+		std::string error;
+		if (!Convert(options, job, result, error)) {
+			std::fprintf(stderr, "error: %s: %s\n", job.input.c_str(), error.c_str());
+			failed++;
+			continue;
+		}
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		std::printf("%s: %s -> %s, %.2f s, %.1f -> %.1f LUFS (%+.2f dB, peak %.1f dBFS), %zu -> %zu bytes%s, %.1f ms\n", job.output.c_str(), FormatName(result.source).c_str(),
+		            OutputName(result).c_str(), result.seconds, result.loudnessIn, result.loudnessOut, result.gainDb, result.peakOutDb, result.bytesIn, result.bytesOut,
+		            result.changed ? "" : " (unchanged)", ms);
+		bytesIn += result.bytesIn;
+		bytesOut += result.bytesOut;
+		results.push_back(result);
+	}
+
+	if (options.manifest != "-" && !WriteManifest(options.manifest, options, results)) {
+		std::fprintf(stderr, "error: cannot write %s\n", options.manifest.c_str());
+		return 1;
+	}
+	std::printf("%zu files, %zu -> %zu bytes, manifest %s\n", results.size(), bytesIn, bytesOut, options.manifest.c_str());
+	return failed ? 1 : 0;
+}
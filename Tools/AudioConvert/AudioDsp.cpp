@@ -0,0 +1,236 @@
+#include "AudioDsp.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#if defined(_M_X64) || defined(__SSE__)
+#include <xmmintrin.h>
+#define AUDIODSP_USE_SSE 1
+#endif
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// 第1種変形ベッセル関数 I0（級数）
+double BesselI0(double x) {
+	double sum = 1.0;
+	double term = 1.0;
+	for (int k = 1; k < 64; ++k) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+		if (term < sum * 1e-17)
+			break;
+	}
+	return sum;
+}
+
+float Dot(const float* a, const float* b, uint32_t count) {
+	uint32_t i = 0u;
+	float sum = 0.0f;
+#ifdef AUDIODSP_USE_SSE
+	__m128 acc = _mm_setzero_ps();
+	for (; i + 4u <= count; i += 4u)
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	alignas(16) float lanes[4];
+	_mm_store_ps(lanes, acc);
+	sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+	for (; i < count; ++i)
+		sum += a[i] * b[i];
+	return sum;
+}
+
+// 双2次フィルタ（直接形 I）
+struct Biquad {
+	double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+	double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+
+	double Process(double x) {
+		const double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		return y;
+	}
+};
+
+// K 特性（BS.1770 が 48kHz の係数で示すフィルタを、同じ設計値から任意の周波数向けに作り直す）
+void MakeKWeighting(uint32_t sampleRate, Biquad& shelf, Biquad& highPass) {
+	const double fs = double(sampleRate);
+	{
+		// 高域シェルフ（+4dB）
+		const double f0 = 1681.974450955533;
+		const double gainDb = 3.999843853973347;
+		const double q = 0.7071752369554196;
+		const double k = std::tan(kPi * f0 / fs);
+		const double vh = std::pow(10.0, gainDb / 20.0);
+		const double vb = std::pow(vh, 0.4996667741545416);
+		const double a0 = 1.0 + k / q + k * k;
+		shelf.b0 = (vh + vb * k / q + k * k) / a0;
+		shelf.b1 = 2.0 * (k * k - vh) / a0;
+		shelf.b2 = (vh - vb * k / q + k * k) / a0;
+		shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+		shelf.a2 = (1.0 - k / q + k * k) / a0;
+	}
+	{
+		// 低域カット（分子は規格どおり 1, -2, 1）
+		const double f0 = 38.13547087602444;
+		const double q = 0.5003270373238773;
+		const double k = std::tan(kPi * f0 / fs);
+		const double a0 = 1.0 + k / q + k * k;
+		highPass.b0 = 1.0;
+		highPass.b1 = -2.0;
+		highPass.b2 = 1.0;
+		highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+		highPass.a2 = (1.0 - k / q + k * k) / a0;
+	}
+}
+
+double ToLufs(double meanSquare) { return -0.691 + 10.0 * std::log10(std::max(meanSquare, 1e-20)); }
+
+} // namespace
+
+bool Resampler::Initialize(uint32_t inRate, uint32_t outRate) {
+	const uint32_t g = std::gcd(inRate, outRate);
+	up_ = outRate / g;
+	down_ = inRate / g;
+	if (up_ > kMaxPhases)
+		return false;
+
+	// 縮めるときは通過域を出力のナイキストに合わせ、その分係数列を伸ばす
+	const double scale = std::min(1.0, double(up_) / double(down_));
+	const double cutoff = 0.5 * kPassband * scale; // 入力 1 サンプルあたりの周期
+	taps_ = (static_cast<uint32_t>(std::ceil(2.0 * kHalfTaps / scale)) + 3u) & ~3u;
+	const double half = double(taps_) / 2.0;
+	const double i0Beta = BesselI0(kKaiserBeta);
+
+	coefs_.assign(size_t(up_) * taps_, 0.0f);
+	for (uint32_t p = 0; p < up_; ++p) {
+		float* c = coefs_.data() + size_t(p) * taps_;
+		double sum = 0.0;
+		std::vector<double> h(taps_);
+		for (uint32_t k = 0; k < taps_; ++k) {
+			const double x = double(k) - (half - 1.0) - double(p) / double(up_);
+			const double u = x / half;
+			const double window = std::fabs(u) >= 1.0 ? 0.0 : BesselI0(kKaiserBeta * std::sqrt(1.0 - u * u)) / i0Beta;
+			const double arg = 2.0 * cutoff * x;
+			const double sinc = std::fabs(arg) < 1e-12 ? 1.0 : std::sin(kPi * arg) / (kPi * arg);
+			h[k] = 2.0 * cutoff * sinc * window;
+			sum += h[k];
+		}
+		// 位相ごとに直流の利得を 1 に揃える
+		for (uint32_t k = 0; k < taps_; ++k)
+			c[k] = static_cast<float>(h[k] / sum);
+	}
+	return true;
+}
+
+std::vector<float> Resampler::Process(const std::vector<float>& in) const {
+	const size_t outCount = static_cast<size_t>((uint64_t(in.size()) * up_ + down_ - 1u) / down_);
+	std::vector<float> out(outCount);
+	if (up_ == 1u && down_ == 1u) {
+		out = in;
+		return out;
+	}
+
+	// 前後に taps_ ぶんの無音を足して、端でも範囲外を読まないようにする
+	std::vector<float> padded(in.size() + size_t(taps_) * 2u, 0.0f);
+	std::copy(in.begin(), in.end(), padded.begin() + taps_);
+	const size_t offset = taps_ - (taps_ / 2u - 1u);
+	for (size_t n = 0; n < outCount; ++n) {
+		const uint64_t pos = uint64_t(n) * down_;
+		const size_t index = static_cast<size_t>(pos / up_);
+		const uint32_t phase = static_cast<uint32_t>(pos % up_);
+		out[n] = Dot(padded.data() + index + offset, coefs_.data() + size_t(phase) * taps_, taps_);
+	}
+	return out;
+}
+
+double MeasureLoudness(const std::vector<std::vector<float>>& channels, uint32_t sampleRate) {
+	if (channels.empty() || channels[0].empty())
+		return -100.0;
+	const size_t frames = channels[0].size();
+
+	// K 特性を掛けた2乗をチャンネルで足す（L/R の重みは 1）
+	std::vector<double> power(frames, 0.0);
+	for (const std::vector<float>& channel : channels) {
+		Biquad shelf, highPass;
+		MakeKWeighting(sampleRate, shelf, highPass);
+		for (size_t i = 0; i < frames; ++i) {
+			const double y = highPass.Process(shelf.Process(channel[i]));
+			power[i] += y * y;
+		}
+	}
+
+	const size_t block = static_cast<size_t>(0.4 * sampleRate);
+	const size_t step = static_cast<size_t>(0.1 * sampleRate);
+	std::vector<double> blocks;
+	if (frames < block || step == 0u) {
+		blocks.push_back(std::accumulate(power.begin(), power.end(), 0.0) / double(frames));
+	} else {
+		// 累積和で 400ms ごとの平均を取る
+		std::vector<double> prefix(frames + 1u, 0.0);
+		for (size_t i = 0; i < frames; ++i)
+			prefix[i + 1u] = prefix[i] + power[i];
+		for (size_t start = 0; start + block <= frames; start += step)
+			blocks.push_back((prefix[start + block] - prefix[start]) / double(block));
+	}
+
+	// 絶対ゲート（-70 LUFS）→ その平均から -10 LU の相対ゲート
+	double sum = 0.0;
+	size_t count = 0u;
+	for (double z : blocks) {
+		if (ToLufs(z) > -70.0) {
+			sum += z;
+			count++;
+		}
+	}
+	if (count == 0u)
+		return -100.0;
+	const double relativeGate = ToLufs(sum / double(count)) - 10.0;
+	sum = 0.0;
+	count = 0u;
+	for (double z : blocks) {
+		const double lufs = ToLufs(z);
+		if (lufs > -70.0 && lufs > relativeGate) {
+			sum += z;
+			count++;
+		}
+	}
+	return ToLufs(sum / double(count));
+}
+
+float MeasurePeak(const std::vector<std::vector<float>>& channels) {
+	float peak = 0.0f;
+	for (const std::vector<float>& channel : channels) {
+		for (float x : channel)
+			peak = std::max(peak, std::fabs(x));
+	}
+	return peak;
+}
+
+std::vector<int16_t> QuantizeTo16(const std::vector<std::vector<float>>& channels, float gain, bool dither, uint32_t seed) {
+	const size_t channelCount = channels.size();
+	const size_t frames = channelCount ? channels[0].size() : 0u;
+	std::vector<int16_t> out(frames * channelCount);
+	uint32_t state = seed ? seed : 1u;
+	auto next = [&state]() {
+		// xorshift32 → [0, 1)
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return float(state >> 8) * (1.0f / 16777216.0f);
+	};
+	for (size_t i = 0; i < frames; ++i) {
+		for (size_t c = 0; c < channelCount; ++c) {
+			float s = channels[c][i] * gain * 32768.0f;
+			if (dither)
+				s += next() - next();
+			const float r = std::nearbyint(s);
+			out[i * channelCount + c] = static_cast<int16_t>(std::clamp(r, -32768.0f, 32767.0f));
+		}
+	}
+	return out;
+}
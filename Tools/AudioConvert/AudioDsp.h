@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// AudioConvert の信号処理（チャンネルごとに分けた float 波形を扱う）
+
+// 有理数比のポリフェーズ FIR リサンプラー（Kaiser 窓の sinc）
+// ・in:out = M:L（最大公約数で割った整数比）。出力 n は入力の n*M/L の位置で、L 個の位相から1つの係数列を選んで畳み込む
+// ・遮断（遷移帯の中央）は低い方のナイキスト周波数の kPassband 倍。縮めるときは係数列をその比だけ伸ばす
+// ・44.1k → 48k で 20kHz まで誤差 -70dB 以下、48k → 44.1k で 23kHz は -98dB
+// ・畳み込みは4タップずつ SIMD（係数列は 4 の倍数の長さ）
+class Resampler {
+public:
+	static const uint32_t kHalfTaps = 64u; // 片側のタップ数（広げるとき）
+	static const uint32_t kMaxPhases = 4096u;
+	static constexpr double kPassband = 0.95;
+	static constexpr double kKaiserBeta = 9.0; // 阻止域およそ -90dB
+
+	// 比が細かすぎる（L が kMaxPhases を超える）なら false
+	bool Initialize(uint32_t inRate, uint32_t outRate);
+
+	// 1チャンネルぶんを変換する（前後は無音として扱う）
+	std::vector<float> Process(const std::vector<float>& in) const;
+
+	uint32_t GetPhases() const { return up_; }
+	uint32_t GetTaps() const { return taps_; }
+
+private:
+	uint32_t up_ = 1u;   // L
+	uint32_t down_ = 1u; // M
+	uint32_t taps_ = 0u; // 位相あたりのタップ数（4 の倍数）
+	std::vector<float> coefs_; // up_ * taps_。位相 p の k 番は入力 (基準 - taps_/2 + 1 + k) に掛ける
+};
+
+// ITU-R BS.1770 の積分ラウドネス（LUFS）。K 特性 → 400ms ブロック（75% 重なり）→ 絶対・相対ゲート
+// ブロックが1つも取れない短い音は全体を1ブロックとして測る。無音なら -70 より小さい値
+double MeasureLoudness(const std::vector<std::vector<float>>& channels, uint32_t sampleRate);
+
+// 最大の絶対値
+float MeasurePeak(const std::vector<std::vector<float>>& channels);
+
+// gain を掛けて 16bit にしインターリーブする。dither なら TPDF（±1LSB）を足してから丸める
+std::vector<int16_t> QuantizeTo16(const std::vector<std::vector<float>>& channels, float gain, bool dither, uint32_t seed);
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+// ゲーム側のエンジンに依存しないコード（Frustum・HudText など）を Linux のツールで組むときに、
+// <KamataEngine.h> の代わりに読ませる最小の型だけの写し（-ITools/Common/EngineStub で本物より先に見つかるようにする）
+// ・並びと名前はエンジンと同じ。関数や D3D12 に触れるものは入れない
+namespace KamataEngine {
+
+struct Vector2 {
+	float x, y;
+};
+
+struct Vector3 {
+	float x, y, z;
+};
+
+struct Matrix4x4 {
+	float m[4][4];
+};
+
+// Frustum::Extract が読むビュー・射影行列だけ
+struct Camera {
+	Matrix4x4 matView;
+	Matrix4x4 matProjection;
+};
+
+} // namespace KamataEngine
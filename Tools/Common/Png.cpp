@@ -0,0 +1,275 @@
+#include "Png.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <zlib.h>
+
+namespace Png {
+
+namespace {
+
+const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+uint32_t ReadBE32(const uint8_t* p) { return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]); }
+
+void WriteBE32(std::vector<uint8_t>& out, uint32_t v) {
+	out.push_back(static_cast<uint8_t>(v >> 24));
+	out.push_back(static_cast<uint8_t>(v >> 16));
+	out.push_back(static_cast<uint8_t>(v >> 8));
+	out.push_back(static_cast<uint8_t>(v));
+}
+
+bool ReadFile(const std::string& path, std::vector<uint8_t>& data) {
+	FILE* fp = std::fopen(path.c_str(), "rb");
+	if (!fp)
+		return false;
+	std::fseek(fp, 0, SEEK_END);
+	long size = std::ftell(fp);
+	std::fseek(fp, 0, SEEK_SET);
+	data.resize(size > 0 ? static_cast<size_t>(size) : 0u);
+	bool ok = data.empty() || std::fread(data.data(), 1, data.size(), fp) == data.size();
+	std::fclose(fp);
+	return ok;
+}
+
+int Paeth(int a, int b, int c) {
+	int p = a + b - c;
+	int pa = std::abs(p - a);
+	int pb = std::abs(p - b);
+	int pc = std::abs(p - c);
+	if (pa <= pb && pa <= pc)
+		return a;
+	return pb <= pc ? b : c;
+}
+
+// 1行ぶんのフィルタを戻す（prev は前の行。先頭行はゼロ）
+bool Unfilter(uint8_t filter, uint8_t* row, const uint8_t* prev, size_t rowBytes, size_t bpp) {
+	switch (filter) {
+	case 0:
+		return true;
+	case 1:
+		for (size_t i = bpp; i < rowBytes; ++i)
+			row[i] = static_cast<uint8_t>(row[i] + row[i - bpp]);
+		return true;
+	case 2:
+		for (size_t i = 0; i < rowBytes; ++i)
+			row[i] = static_cast<uint8_t>(row[i] + prev[i]);
+		return true;
+	case 3:
+		for (size_t i = 0; i < rowBytes; ++i) {
+			int left = i >= bpp ? row[i - bpp] : 0;
+			row[i] = static_cast<uint8_t>(row[i] + ((left + prev[i]) >> 1));
+		}
+		return true;
+	case 4:
+		for (size_t i = 0; i < rowBytes; ++i) {
+			int left = i >= bpp ? row[i - bpp] : 0;
+			int upLeft = i >= bpp ? prev[i - bpp] : 0;
+			row[i] = static_cast<uint8_t>(row[i] + Paeth(left, prev[i], upLeft));
+		}
+		return true;
+	default:
+		return false;
+	}
+}
+
+} // namespace
+
+bool Load(const std::string& path, Image& image, std::string& error) {
+	std::vector<uint8_t> file;
+	if (!ReadFile(path, file)) {
+		error = "cannot open " + path;
+		return false;
+	}
+	if (file.size() < 8u || std::memcmp(file.data(), kSignature, 8) != 0) {
+		error = path + ": not a PNG file";
+		return false;
+	}
+
+	uint32_t width = 0u, height = 0u;
+	uint8_t bitDepth = 0u, colorType = 0u, interlace = 0u;
+	std::vector<uint8_t> idat;
+	std::vector<uint8_t> palette;  // RGB * n
+	std::vector<uint8_t> paletteA; // tRNS
+
+	// チャンクを順に読む
+	size_t pos = 8u;
+	while (pos + 12u <= file.size()) {
+		const uint32_t length = ReadBE32(&file[pos]);
+		const char* type = reinterpret_cast<const char*>(&file[pos + 4u]);
+		const uint8_t* data = &file[pos + 8u];
+		if (pos + 12u + length > file.size()) {
+			error = path + ": truncated chunk";
+			return false;
+		}
+		if (std::memcmp(type, "IHDR", 4) == 0 && length >= 13u) {
+			width = ReadBE32(data);
+			height = ReadBE32(data + 4);
+			bitDepth = data[8];
+			colorType = data[9];
+			interlace = data[12];
+		} else if (std::memcmp(type, "PLTE", 4) == 0) {
+			palette.assign(data, data + length);
+		} else if (std::memcmp(type, "tRNS", 4) == 0) {
+			paletteA.assign(data, data + length);
+		} else if (std::memcmp(type, "IDAT", 4) == 0) {
+			idat.insert(idat.end(), data, data + length);
+		} else if (std::memcmp(type, "IEND", 4) == 0) {
+			break;
+		}
+		pos += 12u + length;
+	}
+
+	if (width == 0u || height == 0u) {
+		error = path + ": missing IHDR";
+		return false;
+	}
+	if (bitDepth != 8u || interlace != 0u) {
+		error = path + ": only 8-bit non-interlaced PNG is supported";
+		return false;
+	}
+
+	size_t channels = 0u;
+	switch (colorType) {
+	case 0: channels = 1u; break; // グレー
+	case 2: channels = 3u; break; // RGB
+	case 3: channels = 1u; break; // パレット
+	case 4: channels = 2u; break; // グレーα
+	case 6: channels = 4u; break; // RGBA
+	default:
+		error = path + ": unsupported color type";
+		return false;
+	}
+
+	// 展開（各行の先頭にフィルタ種別1バイト）
+	const size_t rowBytes = width * channels;
+	std::vector<uint8_t> raw((rowBytes + 1u) * height);
+	uLongf rawSize = static_cast<uLongf>(raw.size());
+	if (uncompress(raw.data(), &rawSize, idat.data(), static_cast<uLong>(idat.size())) != Z_OK || rawSize != raw.size()) {
+		error = path + ": corrupt image data";
+		return false;
+	}
+
+	std::vector<uint8_t> zeroRow(rowBytes, 0u);
+	for (uint32_t y = 0; y < height; ++y) {
+		uint8_t* row = &raw[y * (rowBytes + 1u) + 1u];
+		const uint8_t* prev = y > 0 ? &raw[(y - 1u) * (rowBytes + 1u) + 1u] : zeroRow.data();
+		if (!Unfilter(row[-1], row, prev, rowBytes, channels)) {
+			error = path + ": unknown filter type";
+			return false;
+		}
+	}
+
+	// RGBA8 へ変換
+	image.width = width;
+	image.height = height;
+	image.rgba.resize(static_cast<size_t>(width) * height * 4u);
+	for (uint32_t y = 0; y < height; ++y) {
+		const uint8_t* src = &raw[y * (rowBytes + 1u) + 1u];
+		for (uint32_t x = 0; x < width; ++x) {
+			uint8_t* dst = image.Pixel(x, y);
+			const uint8_t* s = src + x * channels;
+			switch (colorType) {
+			case 0: dst[0] = dst[1] = dst[2] = s[0]; dst[3] = 255u; break;
+			case 2: dst[0] = s[0]; dst[1] = s[1]; dst[2] = s[2]; dst[3] = 255u; break;
+			case 3: {
+				const size_t i = s[0];
+				if (i * 3u + 2u >= palette.size()) {
+					error = path + ": palette index out of range";
+					return false;
+				}
+				dst[0] = palette[i * 3u];
+				dst[1] = palette[i * 3u + 1u];
+				dst[2] = palette[i * 3u + 2u];
+				dst[3] = i < paletteA.size() ? paletteA[i] : 255u;
+				break;
+			}
+			case 4: dst[0] = dst[1] = dst[2] = s[0]; dst[3] = s[1]; break;
+			case 6: std::memcpy(dst, s, 4u); break;
+			}
+		}
+	}
+	return true;
+}
+
+bool Save(const std::string& path, const Image& image, std::string& error) {
+	if (image.width == 0u || image.height == 0u || image.rgba.size() != static_cast<size_t>(image.width) * image.height * 4u) {
+		error = "invalid image";
+		return false;
+	}
+
+	// 行ごとに絶対値和が最小になるフィルタを選ぶ
+	const size_t rowBytes = image.width * 4u;
+	std::vector<uint8_t> raw;
+	raw.reserve((rowBytes + 1u) * image.height);
+	std::vector<uint8_t> best(rowBytes), cand(rowBytes), zeroRow(rowBytes, 0u);
+	for (uint32_t y = 0; y < image.height; ++y) {
+		const uint8_t* row = image.Pixel(0, y);
+		const uint8_t* prev = y > 0 ? image.Pixel(0, y - 1u) : zeroRow.data();
+		uint64_t bestSum = UINT64_MAX;
+		uint8_t bestFilter = 0u;
+		for (uint8_t f = 0; f <= 4u; ++f) {
+			uint64_t sum = 0u;
+			for (size_t i = 0; i < rowBytes; ++i) {
+				int left = i >= 4u ? row[i - 4u] : 0;
+				int upLeft = i >= 4u ? prev[i - 4u] : 0;
+				int pred = 0;
+				switch (f) {
+				case 1: pred = left; break;
+				case 2: pred = prev[i]; break;
+				case 3: pred = (left + prev[i]) >> 1; break;
+				case 4: pred = Paeth(left, prev[i], upLeft); break;
+				}
+				cand[i] = static_cast<uint8_t>(row[i] - pred);
+				sum += static_cast<uint64_t>(std::abs(static_cast<int8_t>(cand[i])));
+			}
+			if (sum < bestSum) {
+				bestSum = sum;
+				bestFilter = f;
+				best.swap(cand);
+			}
+		}
+		raw.push_back(bestFilter);
+		raw.insert(raw.end(), best.begin(), best.end());
+	}
+
+	uLongf compSize = compressBound(static_cast<uLong>(raw.size()));
+	std::vector<uint8_t> comp(compSize);
+	if (compress2(comp.data(), &compSize, raw.data(), static_cast<uLong>(raw.size()), Z_BEST_COMPRESSION) != Z_OK) {
+		error = "compress failed";
+		return false;
+	}
+	comp.resize(compSize);
+
+	std::vector<uint8_t> out(kSignature, kSignature + 8);
+	auto writeChunk = [&out](const char* type, const uint8_t* data, size_t length) {
+		WriteBE32(out, static_cast<uint32_t>(length));
+		const size_t typePos = out.size();
+		out.insert(out.end(), type, type + 4);
+		if (length > 0u)
+			out.insert(out.end(), data, data + length);
+		uLong crc = crc32(0L, &out[typePos], static_cast<uInt>(4u + length));
+		WriteBE32(out, static_cast<uint32_t>(crc));
+	};
+
+	std::vector<uint8_t> ihdr;
+	WriteBE32(ihdr, image.width);
+	WriteBE32(ihdr, image.height);
+	ihdr.insert(ihdr.end(), {8u, 6u, 0u, 0u, 0u}); // 8bit RGBA
+	writeChunk("IHDR", ihdr.data(), ihdr.size());
+	writeChunk("IDAT", comp.data(), comp.size());
+	writeChunk("IEND", nullptr, 0u);
+
+	FILE* fp = std::fopen(path.c_str(), "wb");
+	if (!fp) {
+		error = "cannot write " + path;
+		return false;
+	}
+	bool ok = std::fwrite(out.data(), 1, out.size(), fp) == out.size();
+	std::fclose(fp);
+	if (!ok)
+		error = "write failed: " + path;
+	return ok;
+}
+
+} // namespace Png
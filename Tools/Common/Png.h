@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// オフラインツール用の最小 PNG 入出力（zlib 使用）
+// ・読み込み: 8bit / インターレースなしのグレー・RGB・パレット・グレーα・RGBA（出力は常に RGBA8）
+// ・書き込み: RGBA8 のみ
+namespace Png {
+
+struct Image {
+	uint32_t width = 0u;
+	uint32_t height = 0u;
+	std::vector<uint8_t> rgba; // width * height * 4
+
+	uint8_t* Pixel(uint32_t x, uint32_t y) { return &rgba[(static_cast<size_t>(y) * width + x) * 4u]; }
+	const uint8_t* Pixel(uint32_t x, uint32_t y) const { return &rgba[(static_cast<size_t>(y) * width + x) * 4u]; }
+};
+
+// 失敗したら false を返し、error に理由を入れる
+bool Load(const std::string& path, Image& image, std::string& error);
+bool Save(const std::string& path, const Image& image, std::string& error);
+
+} // namespace Png
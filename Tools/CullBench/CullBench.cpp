@@ -0,0 +1,135 @@
+// Frustum のベンチマーク（オフライン・Linux / Windows 共通）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -ITools/Common/EngineStub -IDirectXGame Tools/CullBench/CullBench.cpp DirectXGame/Frustum.cpp -o cullbench
+//   （Tools/Common/EngineStub は <KamataEngine.h> の代わりに Vector3 / Matrix4x4 / Camera だけを置いたもの）
+//
+// 使い方:
+//   cullbench [-n 球の数] [-a 一辺] [-r 半径]
+//   -n : 判定する球の数（既定 10000）
+//   -a : 球をばらまく正方形の一辺（xz 平面、原点中心。既定 120）
+//   -r : 球の半径（既定 0.75）
+//
+// ・カメラは GameScene と同じ（y = 40 から真下を見る、縦画角 45 度・16:9・near 0.1・far 1000）
+// ・CullSpheres（SoA を4個ずつ）と IsVisible を1個ずつ呼ぶのとで、1回あたりの時間と可視数を比べる
+// ・両者の判定が食い違った数も出す（0 のはず）
+#include "Frustum.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+void PrintUsage() { std::fprintf(stderr, "usage: cullbench [-n spheres] [-a area] [-r radius]\n"); }
+
+// GameScene のカメラ（translation {0, 40, 0}・rotation.x 90 度）のビュー行列と、エンジンの既定の射影行列
+void MakeGameCamera(Camera& camera) {
+	// ワールド行列は R(x 90 度) → T。ビューはその逆（回転の転置と、平行移動を戻す）
+	const float c = 0.0f;
+	const float s = 1.0f;
+	const float rotation[3][3] = {
+	    {1.0f, 0.0f, 0.0f},
+	    {0.0f, c, s},
+	    {0.0f, -s, c},
+	};
+	const float translation[3] = {0.0f, 40.0f, 0.0f};
+	camera.matView = {};
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			camera.matView.m[i][j] = rotation[j][i];
+	for (int j = 0; j < 3; ++j) {
+		float v = 0.0f;
+		for (int k = 0; k < 3; ++k)
+			v += translation[k] * camera.matView.m[k][j];
+		camera.matView.m[3][j] = -v;
+	}
+	camera.matView.m[3][3] = 1.0f;
+
+	const float fovY = 45.0f * 3.14159265f / 180.0f;
+	const float aspect = 16.0f / 9.0f;
+	const float nearZ = 0.1f;
+	const float farZ = 1000.0f;
+	const float scaleY = 1.0f / std::tan(fovY * 0.5f);
+	camera.matProjection = {};
+	camera.matProjection.m[0][0] = scaleY / aspect;
+	camera.matProjection.m[1][1] = scaleY;
+	camera.matProjection.m[2][2] = farZ / (farZ - nearZ);
+	camera.matProjection.m[2][3] = 1.0f;
+	camera.matProjection.m[3][2] = -nearZ * farZ / (farZ - nearZ);
+}
+
+// f を 0.2 秒以上かかるまで回数を増やしながら呼び、1回あたりの時間（マイクロ秒）を返す
+template<class F> double MeasureRepeated(F&& f) {
+	for (uint32_t repeat = 1u;; repeat *= 2u) {
+		const auto t0 = std::chrono::steady_clock::now();
+		for (uint32_t r = 0; r < repeat; ++r)
+			f();
+		const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+		if (us >= 200000.0)
+			return us / repeat;
+	}
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	size_t count = 10000u;
+	float area = 120.0f;
+	float radius = 0.75f;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			count = static_cast<size_t>(std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+			area = static_cast<float>(std::atof(argv[++i]));
+		} else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+			radius = static_cast<float>(std::atof(argv[++i]));
+		} else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (count == 0u || area <= 0.0f || radius < 0.0f) {
+		PrintUsage();
+		return 1;
+	}
+
+	Camera camera;
+	MakeGameCamera(camera);
+	Frustum frustum;
+	frustum.Extract(camera);
+
+	// GameScene と同じく、地面（y = 0）の上に敵や弾が散らばっているものとする
+	std::mt19937 rng(1u);
+	std::uniform_real_distribution<float> position(-area * 0.5f, area * 0.5f);
+	std::vector<float> xs(count), ys(count, 0.0f), zs(count), radii(count, radius);
+	for (size_t i = 0; i < count; ++i) {
+		xs[i] = position(rng);
+		zs[i] = position(rng);
+	}
+	std::vector<uint8_t> visible(count);
+	std::vector<uint8_t> reference(count);
+
+	size_t numVisible = 0u;
+	const double simdUs = MeasureRepeated([&] { numVisible = frustum.CullSpheres(xs.data(), ys.data(), zs.data(), radii.data(), count, visible.data()); });
+	size_t refVisible = 0u;
+	const double scalarUs = MeasureRepeated([&] {
+		refVisible = 0u;
+		for (size_t i = 0; i < count; ++i) {
+			reference[i] = frustum.IsVisible({xs[i], ys[i], zs[i]}, radii[i]) ? 1u : 0u;
+			refVisible += reference[i];
+		}
+	});
+
+	size_t mismatches = 0u;
+	for (size_t i = 0; i < count; ++i)
+		mismatches += visible[i] != reference[i];
+
+	std::printf("%zu spheres (r %.2f) in a %.0f x %.0f area, %zu visible\n", count, radius, area, area, numVisible);
+	std::printf("  CullSpheres : %.1f us, %.2f ns per sphere\n", simdUs, simdUs * 1000.0 / count);
+	std::printf("  IsVisible   : %.1f us, %.2f ns per sphere (%.2fx), %zu visible, %zu mismatches\n", scalarUs, scalarUs * 1000.0 / count, scalarUs / simdUs, refVisible, mismatches);
+	return mismatches == 0u ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+// FrameRingAllocator の検査（オフライン・Linux / Windows 共通。D3D12 は使わず、偽フェンスで GPU の遅れを作る）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -IDirectXGame Tools/FrameRingTest/FrameRingTest.cpp -o frameringtest
+//
+// 使い方:
+//   frameringtest [-f フレーム数] [-n 区画数]
+//   -f : 回すフレーム数（既定 100000）
+//   -n : 区画数（バックバッファ数、既定 3）
+//
+// ・偽フェンスは、GPU がフレームを 0 ～ 区画数+1 フレーム遅れて、ばらばらに終えていくように振る舞う
+// ・確保したスライスごとに「使ったフレームのフェンス値」を覚えておき、同じバイトを次に配ったとき GPU がそれを終えているかを見る
+// ・オフセットの配置境界・区画からのはみ出し・満杯時の失敗・区画が順に巡ること・待ちが必要なときだけ起きることも調べる
+// ・食い違いがあれば内容を表示して 1 を返す
+#include "FrameRingAllocator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// GPU の代わり。Signal した値を、乱数で決めた数ずつ遅れて完了させる
+class FakeFence : public FrameFence {
+public:
+	explicit FakeFence(uint32_t seed) : rng_(seed) {}
+
+	// CPU がフレームを出し終えた（このフレームの値を返す）
+	uint64_t Signal() { return ++submitted_; }
+
+	// GPU を進める（出したフレームから 0 ～ maxLag フレーム遅れたところまで。戻りはしない）
+	void Advance(uint32_t maxLag) {
+		const uint32_t lag = std::uniform_int_distribution<uint32_t>(0u, maxLag)(rng_);
+		const uint64_t target = submitted_ > lag ? submitted_ - lag : 0u;
+		if (target > completed_)
+			completed_ = target;
+	}
+
+	uint64_t GetCompletedValue() const override { return completed_; }
+
+	void Wait(uint64_t value) override {
+		if (value <= completed_)
+			unnecessaryWaits_++; // 終わっているのに待った
+		if (value > submitted_)
+			badWaits_++; // まだ出していない値を待った（永久に終わらない）
+		waits_++;
+		if (value > completed_)
+			completed_ = value;
+	}
+
+	uint32_t GetWaits() const { return waits_; }
+	uint32_t GetUnnecessaryWaits() const { return unnecessaryWaits_; }
+	uint32_t GetBadWaits() const { return badWaits_; }
+
+private:
+	std::mt19937 rng_;
+	uint64_t submitted_ = 0u;
+	uint64_t completed_ = 0u;
+	uint32_t waits_ = 0u;
+	uint32_t unnecessaryWaits_ = 0u;
+	uint32_t badWaits_ = 0u;
+};
+
+void PrintUsage() { std::fprintf(stderr, "usage: frameringtest [-f frames] [-n regions]\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+	uint32_t frames = 100000u;
+	uint32_t regions = 3u;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+			frames = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			regions = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (frames == 0u || regions == 0u) {
+		PrintUsage();
+		return 1;
+	}
+
+	// 1区画 64KiB（半端な値を渡して切り上げも見る）
+	const uint64_t requested = 64u * 1024u - 100u;
+	const uint64_t capacity = FrameRingAllocator::AlignUp(requested);
+	FrameRingAllocator ring;
+	ring.Initialize(requested, regions);
+	FakeFence fence(12345u);
+	std::mt19937 rng(67890u);
+	std::uniform_int_distribution<uint32_t> sizeDist(1u, 2048u);
+
+	// 256 バイトごとに、最後にそこを使ったフレームのフェンス値
+	const uint64_t slots = ring.GetTotalSize() / FrameRingAllocator::kAlignment;
+	std::vector<uint64_t> slotFence(slots, 0u);
+
+	uint32_t fails = 0u;
+	auto fail = [&](const char* what, uint32_t frame, uint64_t value) {
+		if (fails++ < 10u)
+			std::printf("FAIL frame %u: %s (%llu)\n", frame, what, static_cast<unsigned long long>(value));
+	};
+
+	if (ring.GetTotalSize() != capacity * regions)
+		fail("total size", 0u, ring.GetTotalSize());
+
+	uint64_t allocations = 0u;
+	uint64_t fullFailures = 0u;
+	uint32_t expectedIndex = 0u;
+	uint32_t neededWaits = 0u;
+	for (uint32_t frame = 0; frame < frames; ++frame) {
+		// 待ちが要るのは、これから使う区画の前回のフレームを GPU がまだ終えていないときだけ
+		fence.Advance(regions + 1u);
+		expectedIndex = (expectedIndex + 1u) % regions;
+		const uint64_t regionFence = slotFence[expectedIndex * capacity / FrameRingAllocator::kAlignment];
+		const uint32_t waitsBefore = fence.GetWaits();
+		if (regionFence != 0u && fence.GetCompletedValue() < regionFence)
+			neededWaits++;
+
+		ring.BeginFrame(fence);
+		if (ring.GetFrameIndex() != expectedIndex)
+			fail("frame index", frame, ring.GetFrameIndex());
+		if (ring.GetUsedThisFrame() != 0u)
+			fail("not rewound", frame, ring.GetUsedThisFrame());
+		if (fence.GetWaits() - waitsBefore > 1u)
+			fail("waited twice", frame, fence.GetWaits() - waitsBefore);
+
+		// 満杯になるまで（ときどきは途中でやめて）確保する
+		const uint64_t value = fence.Signal();
+		const bool fill = frame % 7u == 0u;
+		const uint32_t count = fill ? ~0u : sizeDist(rng) % 64u;
+		for (uint32_t n = 0; n < count; ++n) {
+			const uint64_t size = sizeDist(rng);
+			const uint64_t used = ring.GetUsedThisFrame();
+			const uint64_t offset = ring.Allocate(size);
+			if (offset == FrameRingAllocator::kInvalidOffset) {
+				if (used + FrameRingAllocator::AlignUp(size) <= capacity)
+					fail("failed with room left", frame, used);
+				fullFailures++;
+				break;
+			}
+			allocations++;
+			if (offset % FrameRingAllocator::kAlignment != 0u)
+				fail("misaligned", frame, offset);
+			if (offset < uint64_t(expectedIndex) * capacity || offset + size > uint64_t(expectedIndex + 1u) * capacity)
+				fail("outside the frame's region", frame, offset);
+
+			// 配ったバイトを前に使ったフレームは GPU が終えているはず
+			const uint64_t first = offset / FrameRingAllocator::kAlignment;
+			const uint64_t last = (offset + size - 1u) / FrameRingAllocator::kAlignment;
+			for (uint64_t s = first; s <= last; ++s) {
+				if (slotFence[s] == value)
+					fail("handed out twice in one frame", frame, offset);
+				else if (slotFence[s] > fence.GetCompletedValue())
+					fail("reused before the GPU finished", frame, slotFence[s]);
+				slotFence[s] = value;
+			}
+		}
+		// 区画の先頭はそのフレームの値（待ちの判定に使う）
+		slotFence[expectedIndex * capacity / FrameRingAllocator::kAlignment] = value;
+		ring.EndFrame(value);
+	}
+
+	if (fence.GetWaits() != neededWaits)
+		fail("waits", frames, fence.GetWaits());
+	if (fence.GetUnnecessaryWaits() != 0u)
+		fail("waited on a finished frame", frames, fence.GetUnnecessaryWaits());
+	if (fence.GetBadWaits() != 0u)
+		fail("waited on an unsubmitted value", frames, fence.GetBadWaits());
+
+	std::printf("%u frames over %u regions of %llu bytes: %llu allocations, %llu hit the end of a region, %u waits\n", frames, regions, static_cast<unsigned long long>(capacity),
+	            static_cast<unsigned long long>(allocations), static_cast<unsigned long long>(fullFailures), fence.GetWaits());
+	std::printf("fails=%u\n", fails);
+	return fails == 0u ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+// HUD の数値表示がフレームごとにヒープを使わないことの検査（オフライン・Linux / Windows 共通。描画はせず、文字矩形を配列へ積むだけ）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -ITools/Common/EngineStub -IDirectXGame Tools/HudAllocTest/HudAllocTest.cpp DirectXGame/HudText.cpp -o hudalloctest
+//   （Tools/Common/EngineStub は <KamataEngine.h> の代わりに Vector2 などの型だけを置いたもの）
+//
+// 使い方:
+//   hudalloctest [-f フレーム数]
+//   -f : 回すフレーム数（既定 36000 = 60fps で 10 分）
+//
+// ・グローバルの operator new を数えるものに置き換え、Hud::DrawTimer / DrawScore と同じ流れ
+//   （HudNumberText::Set → 文字矩形を SpriteBatch のように先に確保した配列へ積む）を毎フレーム回して、その間の確保回数を見る
+// ・タイマーは 60 フレームごとに 1 秒進め、スコアは乱数で増やす（コンボ中のように毎フレーム変わるところもある）
+// ・FormatInt が std::to_string と同じ文字列を作るか（INT_MIN・INT_MAX・範囲の総当たり）と、作り直した文字数も調べる
+// ・フレーム中に確保があったり、文字列が食い違ったりしたら内容を表示して 1 を返す
+#include "HudText.h"
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+size_t gAllocations = 0u;
+
+} // namespace
+
+// 確保の回数を数える（解放はそのまま）
+void* operator new(size_t size) {
+	gAllocations++;
+	if (void* p = std::malloc(size ? size : 1u))
+		return p;
+	throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// SpriteBatch に積む1枚ぶん
+struct Quad {
+	Vector2 pos;
+	Vector2 size;
+	Vector2 uvMin;
+	Vector2 uvMax;
+};
+
+// Hud::DrawNumber と同じ
+void PushNumber(const HudNumberText& text, std::vector<Quad>& quads) {
+	const HudNumberText::Glyph* glyphs = text.GetGlyphs();
+	for (size_t i = 0; i < text.GetLength(); ++i)
+		quads.push_back({glyphs[i].pos, text.GetGlyphSize(), glyphs[i].uvMin, glyphs[i].uvMax});
+}
+
+void PrintUsage() { std::fprintf(stderr, "usage: hudalloctest [-f frames]\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+	uint32_t frames = 36000u;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+			frames = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (frames == 0u) {
+		PrintUsage();
+		return 1;
+	}
+
+	uint32_t fails = 0u;
+
+	// FormatInt（ここは確保してもよい：比べる相手の std::to_string が確保する）
+	auto checkFormat = [&](int value) {
+		char text[kIntCharsMax];
+		const size_t length = FormatInt(value, text);
+		if (std::string(text, length) != std::to_string(value) && fails++ < 10u)
+			std::printf("FAIL FormatInt(%d) = %.*s\n", value, static_cast<int>(length), text);
+	};
+	for (int value : {0, 9, 10, 99, 100, 999, 1000, -1, -9, -10, -100, INT_MIN, INT_MIN + 1, INT_MAX, INT_MAX - 1})
+		checkFormat(value);
+	for (int value = -100000; value <= 2000000; ++value)
+		checkFormat(value);
+	for (int i = 0; i <= 31; ++i) {
+		checkFormat(static_cast<int>(1u << i));
+		checkFormat(-static_cast<int>((1u << i) - 1u));
+	}
+
+	// Hud::Initialize と同じ大きさ（数字 48x59 を等倍で表示、UI アトラスは 1024x512）
+	HudNumberText::Layout layout{};
+	layout.glyphSize = {48.0f, 59.0f};
+	layout.glyphTexSize = {48.0f, 59.0f};
+	layout.glyphsTexBase = {0.0f, 53.0f};
+	layout.textureSize = {1024.0f, 512.0f};
+	HudNumberText timerText;
+	HudNumberText scoreText;
+	layout.origin = {100.0f, 20.0f};
+	timerText.Initialize(layout);
+	layout.origin = {100.0f, 80.0f};
+	scoreText.Initialize(layout);
+
+	// SpriteBatch と同じく、積む先は最初に確保しておく
+	std::vector<Quad> quads;
+	quads.reserve(1024u);
+	std::mt19937 rng(1u);
+	std::uniform_int_distribution<int> gain(0, 3);
+
+	int score = 0;
+	uint32_t changedFrames = 0u;
+	size_t quadCount = 0u;
+	const size_t before = gAllocations;
+	for (uint32_t frame = 0; frame < frames; ++frame) {
+		quads.clear();
+		// 弾で倒すと +100、パドルで弾くとコンボの倍率つき
+		const int g = gain(rng);
+		if (g == 1)
+			score += 100;
+		else if (g == 2)
+			score += 50 + static_cast<int>(frame % 17u) * 10;
+		changedFrames += timerText.Set(static_cast<int>(frame / 60u)) ? 1u : 0u;
+		changedFrames += scoreText.Set(score) ? 1u : 0u;
+		PushNumber(timerText, quads);
+		PushNumber(scoreText, quads);
+		quadCount += quads.size();
+	}
+	const size_t frameAllocations = gAllocations - before;
+	if (frameAllocations != 0u) {
+		std::printf("FAIL %zu allocations in the frame loop\n", frameAllocations);
+		fails++;
+	}
+
+	const uint32_t rebuilt = timerText.GetRebuiltGlyphs() + scoreText.GetRebuiltGlyphs();
+	std::printf("%u frames: %zu allocations, %zu glyph quads pushed, %u value changes, %u glyphs rebuilt (%.3f per pushed glyph)\n", frames, frameAllocations, quadCount, changedFrames, rebuilt,
+	            double(rebuilt) / double(quadCount));
+	std::printf("fails=%u\n", fails);
+	return fails == 0u ? 0 : 1;
+}
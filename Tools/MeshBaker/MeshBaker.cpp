@@ -0,0 +1,578 @@
+// OBJ/MTL → 事前変換済みメッシュ（.mesh）変換ツール（オフライン・Linux / Windows 共通）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++17 -O2 -IDirectXGame Tools/MeshBaker/MeshBaker.cpp Tools/MeshBaker/MeshOptimizer.cpp -pthread -o meshbaker
+//
+// 使い方:
+//   meshbaker [-s] [-q] Resources/<name>/<name>.obj [-o 出力.mesh]
+//   meshbaker -b Resources/<name>/<name>.obj
+//   -s : Model::CreateFromOBJ(name, true) と同じく法線を平滑化する
+//   -q : 頂点を VertexQuant::Vertex（16 バイト）に量子化する。位置・法線・UV の最大誤差を表示する
+//   -b : 書き出さず、法線の平滑化を Mesh::AddSmoothData 方式（位置ごとの vector のハッシュ表）・CSR・CSR 並列で計って比べる
+//   出力を省くと OBJ と同じ場所に <name>.mesh を作る
+//
+// ・面の扱いは Model::CreateFromOBJ に合わせる（vt の v 反転、四角形は 0,1,2 / 2,3,0 に分割、usemtl ごとに別メッシュ）
+// ・同じ (v, vt, vn) の組は1頂点にまとめる
+// ・書き出す前に MeshOptimizer で、中身の同じ頂点の統合 → キャッシュ順への三角形の並べ替え → 参照順への頂点の並べ替え をする
+//   どの描画単位も頂点数が 65536 以下ならインデックスを 16bit にする
+// ・最適化前（面の順・32bit インデックス・float 頂点）と後の ACMR（FIFO 16 頂点）と頂点・インデックスのバイト数を表示する
+#include "MeshBlob.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Float3 {
+	float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+struct Float2 {
+	float x = 0.0f, y = 0.0f;
+};
+
+// 組み立て中のメッシュ（usemtl 1つぶん）
+struct BuildPart {
+	std::string material;
+	std::vector<MeshBlob::Vertex> vertices;
+	std::vector<uint32_t> indices;
+	std::vector<uint32_t> positionIndex; // 平滑化用：頂点 → v 番号
+	std::map<std::tuple<int, int, int>, uint32_t> lookup;
+};
+
+std::string DirectoryOf(const std::string& path) {
+	size_t slash = path.find_last_of("/\\");
+	return slash == std::string::npos ? std::string() : path.substr(0, slash + 1u);
+}
+
+std::string ReplaceExtension(const std::string& path, const std::string& ext) {
+	size_t dot = path.find_last_of('.');
+	size_t slash = path.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return path + ext;
+	return path.substr(0, dot) + ext;
+}
+
+void CopyName(char (&dst)[64], const std::string& src) {
+	std::memset(dst, 0, sizeof(dst));
+	std::strncpy(dst, src.c_str(), sizeof(dst) - 1u);
+}
+
+// 負の番号（末尾から）にも対応して 0 始まりへ
+int ResolveIndex(int index, size_t count) { return index < 0 ? static_cast<int>(count) + index : index - 1; }
+
+bool LoadMtl(const std::string& path, std::vector<MeshBlob::Material>& materials) {
+	std::ifstream file(path);
+	if (!file)
+		return false;
+
+	MeshBlob::Material* current = nullptr;
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream ls(line);
+		std::string key;
+		ls >> key;
+		if (key == "newmtl") {
+			MeshBlob::Material m{};
+			// Material のコンストラクタと同じ既定値
+			m.ambient[0] = m.ambient[1] = m.ambient[2] = 0.3f;
+			m.diffuse[0] = m.diffuse[1] = m.diffuse[2] = 0.8f;
+			m.alpha = 1.0f;
+			std::string name;
+			std::getline(ls >> std::ws, name);
+			CopyName(m.name, name);
+			materials.push_back(m);
+			current = &materials.back();
+		} else if (!current) {
+			continue;
+		} else if (key == "Ka") {
+			ls >> current->ambient[0] >> current->ambient[1] >> current->ambient[2];
+		} else if (key == "Kd") {
+			ls >> current->diffuse[0] >> current->diffuse[1] >> current->diffuse[2];
+		} else if (key == "Ks") {
+			ls >> current->specular[0] >> current->specular[1] >> current->specular[2];
+		} else if (key == "d") {
+			ls >> current->alpha;
+		} else if (key == "map_Kd") {
+			std::string tex;
+			std::getline(ls >> std::ws, tex);
+			// Model と同じく、フルパスで書かれていてもファイル名だけを使う（MTL と同じフォルダから読む）
+			const size_t slash = tex.find_last_of("/\\");
+			if (slash != std::string::npos)
+				tex = tex.substr(slash + 1u);
+			CopyName(current->textureFilename, tex);
+		}
+	}
+	return true;
+}
+
+// 平滑化の並列数（頂点の少ないメッシュはスレッドを立てるほうが遅い）
+unsigned SmoothThreads(size_t vertexCount) {
+	const size_t kParallelVertices = 1u << 16;
+	return vertexCount >= kParallelVertices ? std::max(1u, std::thread::hardware_concurrency()) : 1u;
+}
+
+bool LoadObj(const std::string& path, bool smoothing, std::vector<BuildPart>& parts, std::vector<MeshBlob::Material>& materials, std::string& error) {
+	std::ifstream file(path);
+	if (!file) {
+		error = "cannot open " + path;
+		return false;
+	}
+
+	std::vector<Float3> positions;
+	std::vector<Float3> normals;
+	std::vector<Float2> texcoords;
+	parts.emplace_back();
+
+	std::string line;
+	size_t lineNo = 0u;
+	while (std::getline(file, line)) {
+		++lineNo;
+		std::istringstream ls(line);
+		std::string key;
+		ls >> key;
+
+		if (key == "mtllib") {
+			std::string mtl;
+			std::getline(ls >> std::ws, mtl);
+			if (!LoadMtl(DirectoryOf(path) + mtl, materials)) {
+				error = "cannot open " + DirectoryOf(path) + mtl;
+				return false;
+			}
+		} else if (key == "v") {
+			Float3 p;
+			ls >> p.x >> p.y >> p.z;
+			positions.push_back(p);
+		} else if (key == "vt") {
+			Float2 t;
+			ls >> t.x >> t.y;
+			t.y = 1.0f - t.y; // 上下反転
+			texcoords.push_back(t);
+		} else if (key == "vn") {
+			Float3 n;
+			ls >> n.x >> n.y >> n.z;
+			normals.push_back(n);
+		} else if (key == "usemtl") {
+			std::string name;
+			std::getline(ls >> std::ws, name);
+			if (!parts.back().indices.empty())
+				parts.emplace_back();
+			parts.back().material = name;
+		} else if (key == "f") {
+			BuildPart& part = parts.back();
+			std::vector<uint32_t> corners;
+			std::string token;
+			while (ls >> token) {
+				int vi = 0, ti = 0, ni = 0;
+				if (std::sscanf(token.c_str(), "%d/%d/%d", &vi, &ti, &ni) != 3) {
+					error = path + ":" + std::to_string(lineNo) + ": faces must be v/vt/vn";
+					return false;
+				}
+				vi = ResolveIndex(vi, positions.size());
+				ti = ResolveIndex(ti, texcoords.size());
+				ni = ResolveIndex(ni, normals.size());
+				if (vi < 0 || ti < 0 || ni < 0 || vi >= static_cast<int>(positions.size()) || ti >= static_cast<int>(texcoords.size()) || ni >= static_cast<int>(normals.size())) {
+					error = path + ":" + std::to_string(lineNo) + ": index out of range";
+					return false;
+				}
+
+				auto key3 = std::make_tuple(vi, ti, ni);
+				auto it = part.lookup.find(key3);
+				uint32_t index = 0u;
+				if (it != part.lookup.end()) {
+					index = it->second;
+				} else {
+					MeshBlob::Vertex v{};
+					v.pos[0] = positions[vi].x;
+					v.pos[1] = positions[vi].y;
+					v.pos[2] = positions[vi].z;
+					v.normal[0] = normals[ni].x;
+					v.normal[1] = normals[ni].y;
+					v.normal[2] = normals[ni].z;
+					v.uv[0] = texcoords[ti].x;
+					v.uv[1] = texcoords[ti].y;
+					index = static_cast<uint32_t>(part.vertices.size());
+					part.vertices.push_back(v);
+					part.positionIndex.push_back(static_cast<uint32_t>(vi));
+					part.lookup.emplace(key3, index);
+				}
+				corners.push_back(index);
+			}
+			if (corners.size() < 3u || corners.size() > 4u) {
+				error = path + ":" + std::to_string(lineNo) + ": only triangles and quads are supported";
+				return false;
+			}
+			part.indices.insert(part.indices.end(), {corners[0], corners[1], corners[2]});
+			if (corners.size() == 4u)
+				part.indices.insert(part.indices.end(), {corners[2], corners[3], corners[0]});
+		}
+	}
+
+	// 空のメッシュを除く
+	std::vector<BuildPart> nonEmpty;
+	for (BuildPart& p : parts) {
+		if (!p.indices.empty())
+			nonEmpty.push_back(std::move(p));
+	}
+	parts.swap(nonEmpty);
+	if (parts.empty()) {
+		error = path + ": no faces";
+		return false;
+	}
+
+	if (smoothing) {
+		for (BuildPart& p : parts)
+			MeshOptimizer::SmoothNormals(p.vertices, p.positionIndex, SmoothThreads(p.vertices.size()));
+	}
+
+	// マテリアルがなければ既定のものを1つ
+	if (materials.empty()) {
+		MeshBlob::Material m{};
+		m.ambient[0] = m.ambient[1] = m.ambient[2] = 0.3f;
+		m.diffuse[0] = m.diffuse[1] = m.diffuse[2] = 0.8f;
+		m.alpha = 1.0f;
+		materials.push_back(m);
+	}
+	return true;
+}
+
+// 頂点・インデックスの量と ACMR
+struct MeshStats {
+	size_t vertices = 0u;
+	size_t indices = 0u;
+	size_t bytes = 0u;
+	double acmr = 0.0;
+};
+
+bool FitsIndex16(const std::vector<BuildPart>& parts) {
+	for (const BuildPart& p : parts) {
+		if (p.vertices.size() > 0x10000u)
+			return false;
+	}
+	return true;
+}
+
+MeshStats Measure(const std::vector<BuildPart>& parts, size_t vertexStride, size_t indexStride) {
+	MeshStats stats;
+	double misses = 0.0;
+	for (const BuildPart& p : parts) {
+		stats.vertices += p.vertices.size();
+		stats.indices += p.indices.size();
+		misses += MeshOptimizer::Acmr(p.indices, p.vertices.size()) * static_cast<double>(p.indices.size() / 3u);
+	}
+	stats.bytes = vertexStride * stats.vertices + indexStride * stats.indices;
+	stats.acmr = stats.indices >= 3u ? misses / static_cast<double>(stats.indices / 3u) : 0.0;
+	return stats;
+}
+
+// 統合 → 三角形の並べ替え → 頂点の並べ替え。統合した頂点数を返す
+size_t Optimize(BuildPart& part) {
+	const size_t welded = MeshOptimizer::Weld(part.vertices, part.indices);
+	MeshOptimizer::OptimizeVertexCache(part.indices, part.vertices.size());
+	MeshOptimizer::OptimizeVertexFetch(part.vertices, part.indices);
+	// 頂点の並びが変わったので OBJ の番号との対応は捨てる
+	part.positionIndex.clear();
+	part.lookup.clear();
+	return welded;
+}
+
+// half の UV と有限の位置でしか量子化できない
+bool CanQuantize(const std::vector<BuildPart>& parts, std::string& error) {
+	for (const BuildPart& p : parts) {
+		for (const MeshBlob::Vertex& v : p.vertices) {
+			for (float f : v.pos) {
+				if (!std::isfinite(f)) {
+					error = "position is not finite";
+					return false;
+				}
+			}
+			for (float f : v.uv) {
+				if (!std::isfinite(f) || std::fabs(f) > 65504.0f) {
+					error = "uv is out of half range";
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+// 全頂点の位置の範囲
+VertexQuant::Quantization Bounds(const std::vector<BuildPart>& parts) {
+	float minPos[3] = {HUGE_VALF, HUGE_VALF, HUGE_VALF};
+	float maxPos[3] = {-HUGE_VALF, -HUGE_VALF, -HUGE_VALF};
+	for (const BuildPart& p : parts) {
+		for (const MeshBlob::Vertex& v : p.vertices) {
+			for (int i = 0; i < 3; ++i) {
+				minPos[i] = std::min(minPos[i], v.pos[i]);
+				maxPos[i] = std::max(maxPos[i], v.pos[i]);
+			}
+		}
+	}
+	return VertexQuant::MakeQuantization(minPos, maxPos);
+}
+
+// 量子化 → 展開の最大誤差
+struct QuantError {
+	float position = 0.0f; // 距離
+	float normal = 0.0f;   // 度
+	float uv = 0.0f;
+};
+
+QuantError MeasureQuantError(const std::vector<BuildPart>& parts, const VertexQuant::Quantization& q) {
+	QuantError e;
+	for (const BuildPart& p : parts) {
+		for (const MeshBlob::Vertex& v : p.vertices) {
+			float pos[3], normal[3], uv[2];
+			VertexQuant::Decode(VertexQuant::Encode(v.pos, v.normal, v.uv, q), q, pos, normal, uv);
+			const float dx = pos[0] - v.pos[0], dy = pos[1] - v.pos[1], dz = pos[2] - v.pos[2];
+			e.position = std::max(e.position, std::sqrt(dx * dx + dy * dy + dz * dz));
+
+			// 元の法線は正規化されていないこともあるので、なす角で測る
+			const float cx = normal[1] * v.normal[2] - normal[2] * v.normal[1];
+			const float cy = normal[2] * v.normal[0] - normal[0] * v.normal[2];
+			const float cz = normal[0] * v.normal[1] - normal[1] * v.normal[0];
+			const float dot = normal[0] * v.normal[0] + normal[1] * v.normal[1] + normal[2] * v.normal[2];
+			const float angle = std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) * (180.0f / 3.14159265f);
+			e.normal = std::max(e.normal, angle);
+
+			e.uv = std::max({e.uv, std::fabs(uv[0] - v.uv[0]), std::fabs(uv[1] - v.uv[1])});
+		}
+	}
+	return e;
+}
+
+bool WriteBlob(const std::string& path, bool smoothing, bool quantize, const std::vector<BuildPart>& parts, const std::vector<MeshBlob::Material>& materials) {
+	MeshBlob::Header h{};
+	h.magic = MeshBlob::kMagic;
+	h.version = MeshBlob::kVersion;
+	h.flags = smoothing ? MeshBlob::kFlagSmoothed : 0u;
+	if (FitsIndex16(parts))
+		h.flags |= MeshBlob::kFlagIndex16;
+	VertexQuant::Quantization q{};
+	if (quantize) {
+		h.flags |= MeshBlob::kFlagQuantized;
+		q = Bounds(parts);
+		std::memcpy(h.quantOffset, q.offset, sizeof(h.quantOffset));
+		std::memcpy(h.quantScale, q.scale, sizeof(h.quantScale));
+	}
+	h.partCount = static_cast<uint32_t>(parts.size());
+	h.materialCount = static_cast<uint32_t>(materials.size());
+
+	std::vector<MeshBlob::Part> blobParts;
+	std::vector<MeshBlob::Vertex> vertices;
+	std::vector<uint32_t> indices;
+	for (const BuildPart& p : parts) {
+		MeshBlob::Part bp{};
+		bp.vertexStart = static_cast<uint32_t>(vertices.size());
+		bp.vertexCount = static_cast<uint32_t>(p.vertices.size());
+		bp.indexStart = static_cast<uint32_t>(indices.size());
+		bp.indexCount = static_cast<uint32_t>(p.indices.size());
+		for (uint32_t i = 0; i < materials.size(); ++i) {
+			if (p.material == materials[i].name) {
+				bp.materialIndex = i;
+				break;
+			}
+		}
+		vertices.insert(vertices.end(), p.vertices.begin(), p.vertices.end());
+		indices.insert(indices.end(), p.indices.begin(), p.indices.end());
+		blobParts.push_back(bp);
+	}
+	h.vertexCount = static_cast<uint32_t>(vertices.size());
+	h.indexCount = static_cast<uint32_t>(indices.size());
+
+	size_t offset = MeshBlob::AlignUp(sizeof(h));
+	h.partsOffset = static_cast<uint32_t>(offset);
+	offset = MeshBlob::AlignUp(offset + sizeof(MeshBlob::Part) * blobParts.size());
+	h.materialsOffset = static_cast<uint32_t>(offset);
+	offset = MeshBlob::AlignUp(offset + sizeof(MeshBlob::Material) * materials.size());
+	h.verticesOffset = static_cast<uint32_t>(offset);
+	offset = MeshBlob::AlignUp(offset + MeshBlob::VertexStride(h) * vertices.size());
+	h.indicesOffset = static_cast<uint32_t>(offset);
+	offset += MeshBlob::IndexStride(h) * indices.size();
+	h.fileSize = static_cast<uint32_t>(offset);
+
+	std::vector<uint8_t> blob(offset, 0u);
+	std::memcpy(blob.data(), &h, sizeof(h));
+	std::memcpy(blob.data() + h.partsOffset, blobParts.data(), sizeof(MeshBlob::Part) * blobParts.size());
+	std::memcpy(blob.data() + h.materialsOffset, materials.data(), sizeof(MeshBlob::Material) * materials.size());
+	if (quantize) {
+		std::vector<VertexQuant::Vertex> packed;
+		packed.reserve(vertices.size());
+		for (const MeshBlob::Vertex& v : vertices)
+			packed.push_back(VertexQuant::Encode(v.pos, v.normal, v.uv, q));
+		std::memcpy(blob.data() + h.verticesOffset, packed.data(), sizeof(VertexQuant::Vertex) * packed.size());
+	} else {
+		std::memcpy(blob.data() + h.verticesOffset, vertices.data(), sizeof(MeshBlob::Vertex) * vertices.size());
+	}
+	if (h.flags & MeshBlob::kFlagIndex16) {
+		std::vector<uint16_t> indices16(indices.begin(), indices.end());
+		std::memcpy(blob.data() + h.indicesOffset, indices16.data(), sizeof(uint16_t) * indices16.size());
+	} else {
+		std::memcpy(blob.data() + h.indicesOffset, indices.data(), sizeof(uint32_t) * indices.size());
+	}
+
+	if (!MeshBlob::Validate(blob.data(), blob.size()))
+		return false;
+
+	FILE* fp = std::fopen(path.c_str(), "wb");
+	if (!fp)
+		return false;
+	bool ok = std::fwrite(blob.data(), 1, blob.size(), fp) == blob.size();
+	return std::fclose(fp) == 0 && ok;
+}
+
+// Mesh::AddSmoothData / CalculateSmoothedVertexNormals と同じ作り（比較用）
+void SmoothNormalsHashed(std::vector<MeshBlob::Vertex>& vertices, const std::vector<uint32_t>& positionIndex) {
+	std::unordered_map<uint32_t, std::vector<uint32_t>> smoothData;
+	for (uint32_t i = 0; i < positionIndex.size(); ++i)
+		smoothData[positionIndex[i]].push_back(i);
+
+	for (const auto& g : smoothData) {
+		Float3 n;
+		for (uint32_t v : g.second) {
+			n.x += vertices[v].normal[0];
+			n.y += vertices[v].normal[1];
+			n.z += vertices[v].normal[2];
+		}
+		float len = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+		if (len > 1e-6f) {
+			n.x /= len;
+			n.y /= len;
+			n.z /= len;
+		}
+		for (uint32_t v : g.second) {
+			vertices[v].normal[0] = n.x;
+			vertices[v].normal[1] = n.y;
+			vertices[v].normal[2] = n.z;
+		}
+	}
+}
+
+// 平滑化の3方式を、平滑化前の頂点から繰り返して計る（1方式あたり 0.5 秒以上）
+int BenchmarkSmoothing(const std::vector<BuildPart>& parts) {
+	using Clock = std::chrono::steady_clock;
+	const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+	size_t vertexCount = 0u;
+	for (const BuildPart& p : parts)
+		vertexCount += p.vertices.size();
+
+	struct Method {
+		const char* name;
+		void (*smooth)(BuildPart& part, unsigned threads);
+	};
+	const Method methods[] = {
+	    {"hashed", [](BuildPart& p, unsigned) { SmoothNormalsHashed(p.vertices, p.positionIndex); }},
+	    {"csr", [](BuildPart& p, unsigned) { MeshOptimizer::SmoothNormals(p.vertices, p.positionIndex, 1u); }},
+	    {"csr-parallel", [](BuildPart& p, unsigned t) { MeshOptimizer::SmoothNormals(p.vertices, p.positionIndex, t); }},
+	};
+
+	std::vector<BuildPart> reference;
+	double baseline = 0.0;
+	bool allSame = true;
+	for (const Method& m : methods) {
+		std::vector<BuildPart> work;
+		size_t runs = 0u;
+		double elapsed = 0.0;
+		while (elapsed < 0.5 || runs < 3u) {
+			work = parts;
+			const Clock::time_point t0 = Clock::now();
+			for (BuildPart& p : work)
+				m.smooth(p, threads);
+			elapsed += std::chrono::duration<double>(Clock::now() - t0).count();
+			runs++;
+		}
+		const double ms = elapsed * 1000.0 / static_cast<double>(runs);
+		if (reference.empty()) {
+			reference = work;
+			baseline = ms;
+		}
+
+		// 足す順は同じなのでビット単位で一致するはず
+		bool same = true;
+		for (size_t i = 0; i < work.size(); ++i)
+			same = same && std::memcmp(work[i].vertices.data(), reference[i].vertices.data(), sizeof(MeshBlob::Vertex) * work[i].vertices.size()) == 0;
+		allSame = allSame && same;
+		std::printf("%-13s %9.3f ms  %7.2fx  %s\n", m.name, ms, baseline / ms, same ? "same" : "DIFFERENT");
+	}
+	std::printf("%zu vertices, %zu parts, %u threads\n", vertexCount, parts.size(), threads);
+	return allSame ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	bool smoothing = false;
+	bool quantize = false;
+	bool benchmark = false;
+	std::string input, output;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "-s") {
+			smoothing = true;
+		} else if (arg == "-q") {
+			quantize = true;
+		} else if (arg == "-b") {
+			benchmark = true;
+		} else if (arg == "-o" && i + 1 < argc) {
+			output = argv[++i];
+		} else {
+			input = arg;
+		}
+	}
+	if (input.empty()) {
+		std::fprintf(stderr, "usage: meshbaker [-s] [-q] model.obj [-o model.mesh] | meshbaker -b model.obj\n");
+		return 1;
+	}
+	if (output.empty())
+		output = ReplaceExtension(input, ".mesh");
+
+	std::vector<BuildPart> parts;
+	std::vector<MeshBlob::Material> materials;
+	std::string error;
+	if (!LoadObj(input, smoothing && !benchmark, parts, materials, error)) {
+		std::fprintf(stderr, "error: %s\n", error.c_str());
+		return 1;
+	}
+	if (benchmark)
+		return BenchmarkSmoothing(parts);
+
+	if (quantize && !CanQuantize(parts, error)) {
+		std::fprintf(stderr, "error: %s: cannot quantize: %s\n", input.c_str(), error.c_str());
+		return 1;
+	}
+
+	const MeshStats before = Measure(parts, sizeof(MeshBlob::Vertex), sizeof(uint32_t));
+	size_t welded = 0u;
+	for (BuildPart& p : parts)
+		welded += Optimize(p);
+	const bool index16 = FitsIndex16(parts);
+	const MeshStats after = Measure(parts, quantize ? sizeof(VertexQuant::Vertex) : sizeof(MeshBlob::Vertex), index16 ? sizeof(uint16_t) : sizeof(uint32_t));
+
+	if (!WriteBlob(output, smoothing, quantize, parts, materials)) {
+		std::fprintf(stderr, "error: cannot write %s\n", output.c_str());
+		return 1;
+	}
+
+	std::printf("%s: %zu parts, %zu indices, vertices %zu -> %zu (%zu welded), ACMR %.3f -> %.3f, %u-bit indices, %zu -> %zu bytes (%.1f%% saved)\n", output.c_str(), parts.size(),
+	            after.indices, before.vertices, after.vertices, welded, before.acmr, after.acmr, index16 ? 16u : 32u, before.bytes, after.bytes,
+	            before.bytes ? 100.0 * (1.0 - static_cast<double>(after.bytes) / static_cast<double>(before.bytes)) : 0.0);
+	if (quantize) {
+		const VertexQuant::Quantization q = Bounds(parts);
+		const QuantError e = MeasureQuantError(parts, q);
+		std::printf("  quantized: %zu-byte vertices, max error position %g (extent %g x %g x %g), normal %.4f deg, uv %g\n", sizeof(VertexQuant::Vertex), e.position, q.scale[0],
+		            q.scale[1], q.scale[2], e.normal, e.uv);
+	}
+	return 0;
+}
@@ -0,0 +1,257 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+namespace MeshOptimizer {
+
+namespace {
+
+// Forsyth のスコア（"Linear-Speed Vertex Cache Optimisation" の既定値）
+const uint32_t kCacheSize = 32u; // スコア計算で想定するキャッシュの大きさ
+const float kCacheDecayPower = 1.5f;
+const float kLastTriangleScore = 0.75f;
+const float kValenceBoostScale = 2.0f;
+const float kValenceBoostPower = 0.5f;
+
+// cachePosition は -1 ならキャッシュ外。remaining はまだ出力していない三角形の数
+float VertexScore(int cachePosition, uint32_t remaining) {
+	if (remaining == 0u)
+		return -1.0f;
+	float score = 0.0f;
+	if (cachePosition >= 0) {
+		// 直前の三角形の3頂点は同じ点（どれから使っても同じなので）
+		if (cachePosition < 3)
+			score = kLastTriangleScore;
+		else
+			score = std::pow(1.0f - static_cast<float>(cachePosition - 3) / static_cast<float>(kCacheSize - 3u), kCacheDecayPower);
+	}
+	// 残りの少ない頂点を先に片付ける（孤立した三角形を残さない）
+	return score + kValenceBoostScale * std::pow(static_cast<float>(remaining), -kValenceBoostPower);
+}
+
+// CSR 表の [begin, end) の位置ぶん法線を平均する
+void SmoothRange(std::vector<MeshBlob::Vertex>& vertices, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& members, size_t begin, size_t end) {
+	for (size_t p = begin; p < end; ++p) {
+		const uint32_t* first = members.data() + offsets[p];
+		const uint32_t* last = members.data() + offsets[p + 1u];
+		if (first == last)
+			continue;
+
+		float n[3] = {0.0f, 0.0f, 0.0f};
+		for (const uint32_t* it = first; it != last; ++it) {
+			n[0] += vertices[*it].normal[0];
+			n[1] += vertices[*it].normal[1];
+			n[2] += vertices[*it].normal[2];
+		}
+		const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (len > 1e-6f) {
+			n[0] /= len;
+			n[1] /= len;
+			n[2] /= len;
+		}
+		for (const uint32_t* it = first; it != last; ++it)
+			std::memcpy(vertices[*it].normal, n, sizeof(n));
+	}
+}
+
+} // namespace
+
+void SmoothNormals(std::vector<MeshBlob::Vertex>& vertices, const std::vector<uint32_t>& positionIndex, unsigned threads) {
+	const size_t vertexCount = std::min(vertices.size(), positionIndex.size());
+	if (vertexCount == 0u)
+		return;
+	const size_t positionCount = static_cast<size_t>(*std::max_element(positionIndex.begin(), positionIndex.begin() + vertexCount)) + 1u;
+
+	// 位置番号 → 頂点の CSR 表（数え上げソート。同じ位置の中は頂点番号の昇順）
+	std::vector<uint32_t> offsets(positionCount + 1u, 0u);
+	for (size_t v = 0; v < vertexCount; ++v)
+		offsets[positionIndex[v] + 1u]++;
+	for (size_t p = 0; p < positionCount; ++p)
+		offsets[p + 1u] += offsets[p];
+	std::vector<uint32_t> members(vertexCount);
+	{
+		std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+		for (size_t v = 0; v < vertexCount; ++v)
+			members[cursor[positionIndex[v]]++] = static_cast<uint32_t>(v);
+	}
+
+	// 位置のグループどうしは頂点を共有しないので、位置の範囲で分ければ書き込みはぶつからない
+	// 範囲は頂点数がそろうように CSR の offsets で切る
+	threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(positionCount)));
+	if (threads == 1u) {
+		SmoothRange(vertices, offsets, members, 0u, positionCount);
+		return;
+	}
+	std::vector<size_t> bounds(threads + 1u, positionCount);
+	bounds[0] = 0u;
+	for (unsigned t = 1; t < threads; ++t) {
+		const uint32_t target = static_cast<uint32_t>(vertexCount * t / threads);
+		bounds[t] = static_cast<size_t>(std::lower_bound(offsets.begin(), offsets.end() - 1, target) - offsets.begin());
+	}
+	std::vector<std::thread> workers;
+	workers.reserve(threads);
+	for (unsigned t = 0; t < threads; ++t) {
+		const size_t begin = bounds[t], end = std::max(bounds[t], bounds[t + 1u]);
+		workers.emplace_back([&, begin, end]() { SmoothRange(vertices, offsets, members, begin, end); });
+	}
+	for (std::thread& w : workers)
+		w.join();
+}
+
+size_t Weld(std::vector<MeshBlob::Vertex>& vertices, std::vector<uint32_t>& indices) {
+	// バイト列の順に並べ、隣り合う同じものをまとめる
+	std::vector<uint32_t> order(vertices.size());
+	std::iota(order.begin(), order.end(), 0u);
+	auto less = [&](uint32_t a, uint32_t b) { return std::memcmp(&vertices[a], &vertices[b], sizeof(MeshBlob::Vertex)) < 0; };
+	std::stable_sort(order.begin(), order.end(), less);
+
+	// 同じ中身の組は一番若い番号に寄せる（stable_sort なので組の先頭が一番若い）
+	std::vector<uint32_t> remap(vertices.size());
+	for (size_t i = 0; i < order.size(); ++i) {
+		const bool same = i > 0u && std::memcmp(&vertices[order[i - 1u]], &vertices[order[i]], sizeof(MeshBlob::Vertex)) == 0;
+		remap[order[i]] = same ? remap[order[i - 1u]] : order[i];
+	}
+	for (uint32_t& index : indices)
+		index = remap[index];
+
+	// 使われなくなった頂点は OptimizeVertexFetch で詰める
+	size_t removed = 0u;
+	for (size_t v = 0; v < remap.size(); ++v) {
+		if (remap[v] != v)
+			removed++;
+	}
+	return removed;
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+	const size_t triangleCount = indices.size() / 3u;
+	if (triangleCount == 0u)
+		return;
+
+	// 頂点 → 三角形の表（頂点ごとの先頭 offsets[v]、まだ出していない三角形が前の remaining[v] 個）
+	std::vector<uint32_t> remaining(vertexCount, 0u);
+	for (size_t i = 0; i < triangleCount * 3u; ++i)
+		remaining[indices[i]]++;
+	std::vector<uint32_t> offsets(vertexCount + 1u, 0u);
+	for (size_t v = 0; v < vertexCount; ++v)
+		offsets[v + 1u] = offsets[v] + remaining[v];
+	std::vector<uint32_t> triangles(offsets[vertexCount]);
+	{
+		std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3u; ++i)
+			triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3u);
+	}
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+		vertexScore[v] = VertexScore(-1, remaining[v]);
+
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	int best = -1;
+	for (size_t t = 0; t < triangleCount; ++t) {
+		triangleScore[t] = vertexScore[indices[t * 3u]] + vertexScore[indices[t * 3u + 1u]] + vertexScore[indices[t * 3u + 2u]];
+		if (best < 0 || triangleScore[t] > triangleScore[best])
+			best = static_cast<int>(t);
+	}
+
+	std::vector<uint32_t> out;
+	out.reserve(triangleCount * 3u);
+	std::vector<uint32_t> cache, next;
+	cache.reserve(kCacheSize + 3u);
+	next.reserve(kCacheSize + 3u);
+	size_t scan = 0u; // 候補が尽きたときに未出力の三角形を探す位置
+
+	for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+		if (best < 0) {
+			while (emitted[scan])
+				scan++;
+			best = static_cast<int>(scan);
+		}
+
+		const uint32_t* tri = &indices[best * 3u];
+		emitted[best] = true;
+		out.insert(out.end(), tri, tri + 3);
+
+		// 出した三角形を各頂点の表から外す
+		for (int k = 0; k < 3; ++k) {
+			const uint32_t v = tri[k];
+			uint32_t* begin = &triangles[offsets[v]];
+			uint32_t* end = begin + remaining[v];
+			uint32_t* it = std::find(begin, end, static_cast<uint32_t>(best));
+			std::swap(*it, *(end - 1));
+			remaining[v]--;
+		}
+
+		// キャッシュの先頭へ入れ、はみ出した頂点はキャッシュ外へ
+		next.assign(tri, tri + 3);
+		for (uint32_t v : cache) {
+			if (v != tri[0] && v != tri[1] && v != tri[2])
+				next.push_back(v);
+		}
+		for (size_t i = 0; i < next.size(); ++i) {
+			const uint32_t v = next[i];
+			cachePosition[v] = i < kCacheSize ? static_cast<int>(i) : -1;
+			vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+		}
+
+		// 動いた頂点の三角形だけ点を付け直し、その中から次を選ぶ
+		best = -1;
+		for (uint32_t v : next) {
+			for (uint32_t i = 0; i < remaining[v]; ++i) {
+				const uint32_t t = triangles[offsets[v] + i];
+				triangleScore[t] = vertexScore[indices[t * 3u]] + vertexScore[indices[t * 3u + 1u]] + vertexScore[indices[t * 3u + 2u]];
+				if (best < 0 || triangleScore[t] > triangleScore[best])
+					best = static_cast<int>(t);
+			}
+		}
+
+		if (next.size() > kCacheSize)
+			next.resize(kCacheSize);
+		cache.swap(next);
+	}
+
+	// 3 で割り切れない端数はそのまま後ろに残す
+	out.insert(out.end(), indices.begin() + triangleCount * 3u, indices.end());
+	indices.swap(out);
+}
+
+void OptimizeVertexFetch(std::vector<MeshBlob::Vertex>& vertices, std::vector<uint32_t>& indices) {
+	const uint32_t kUnused = ~0u;
+	std::vector<uint32_t> remap(vertices.size(), kUnused);
+	std::vector<MeshBlob::Vertex> out;
+	out.reserve(vertices.size());
+	for (uint32_t& index : indices) {
+		if (remap[index] == kUnused) {
+			remap[index] = static_cast<uint32_t>(out.size());
+			out.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	vertices.swap(out);
+}
+
+double Acmr(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+	const size_t triangleCount = indices.size() / 3u;
+	if (triangleCount == 0u)
+		return 0.0;
+
+	// FIFO：ミスのたびに1つ進む時刻で、入ってから cacheSize 回以内なら残っている
+	const uint64_t kNever = ~0ull;
+	std::vector<uint64_t> insertedAt(vertexCount, kNever);
+	uint64_t misses = 0u;
+	for (size_t i = 0; i < triangleCount * 3u; ++i) {
+		const uint32_t v = indices[i];
+		if (insertedAt[v] == kNever || misses - insertedAt[v] >= cacheSize) {
+			insertedAt[v] = misses;
+			misses++;
+		}
+	}
+	return static_cast<double>(misses) / static_cast<double>(triangleCount);
+}
+
+} // namespace MeshOptimizer
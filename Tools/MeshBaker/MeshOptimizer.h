@@ -0,0 +1,28 @@
+#pragma once
+#include "MeshBlob.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// メッシュの最適化（MeshBaker が .mesh に書く前に描画単位ごとにかける）
+// ・インデックスは 0 始まり（描画単位の先頭頂点から）の三角形リスト
+namespace MeshOptimizer {
+
+// 同じ位置（positionIndex[v] が同じ）を共有する頂点の法線を平均する（Mesh::CalculateSmoothedVertexNormals 相当）
+// ・位置番号で数え上げソートした CSR 表を作り、1回の走査で足し込む（位置ごとの vector もハッシュも使わない）
+// ・threads > 1 なら位置の範囲を分けて並列に足し込む。グループ内の足す順は同じなので結果はビット単位で一致する
+void SmoothNormals(std::vector<MeshBlob::Vertex>& vertices, const std::vector<uint32_t>& positionIndex, unsigned threads = 1u);
+
+// 中身（位置・法線・UV）がビット単位で同じ頂点を1つにまとめる。減った頂点数を返す
+size_t Weld(std::vector<MeshBlob::Vertex>& vertices, std::vector<uint32_t>& indices);
+
+// 頂点変換キャッシュに当たりやすい三角形順に並べ替える（Forsyth の線形時間アルゴリズム）
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+// 頂点を三角形から初めて参照される順に並べ替え、使われていない頂点を捨てる
+void OptimizeVertexFetch(std::vector<MeshBlob::Vertex>& vertices, std::vector<uint32_t>& indices);
+
+// 平均キャッシュミス率（三角形あたりの頂点変換回数。FIFO キャッシュで数える。最良 0.5 前後、最悪 3）
+double Acmr(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = 16u);
+
+} // namespace MeshOptimizer
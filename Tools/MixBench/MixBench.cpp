@@ -0,0 +1,141 @@
+// AudioMixer のベンチマーク（オフライン・Linux / Windows 共通。音は出さずにバッファへ混ぜるだけ）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -IDirectXGame Tools/MixBench/MixBench.cpp DirectXGame/AudioMixer.cpp DirectXGame/Adpcm.cpp DirectXGame/WaveFile.cpp DirectXGame/FileBytes.cpp -o mixbench
+//   -DMIXER_NO_SSE を付けると SIMD なしの AudioMixer で計れる
+//
+// 使い方:
+//   mixbench [-v ボイス数] [-s 秒] DirectXGame/Resources/mokugyo.wav DirectXGame/Resources/fanfare.adpcm ...
+//   -v : 同時に鳴らすボイス数（既定 256）
+//   -s : 混ぜる長さ（出力の秒数、既定 10）
+//
+// ・VoicePool と同じく 48kHz ステレオへ 480 フレーム（10ms）ずつ混ぜる
+// ・各ボイスは与えた WAV から順に選び、音量・パンはばらけさせる。鳴り終わったらすぐ次を鳴らして常に全ボイスを埋める
+// ・1 ブロックあたりの時間・実時間に対する倍率・ボイス 1 フレームあたりの時間を表示する
+// ・IMA-ADPCM（.adpcm）を与えると、先にその展開だけの速さ（音 1 秒あたり、SIMD と1列ずつ）と 16bit PCM に対する大きさも表示する
+#include "Adpcm.h"
+#include "AudioMixer.h"
+#include "FileBytes.h"
+#include "WaveFile.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint32_t kOutputRate = 48000u;
+const uint32_t kBlockFrames = 480u;
+
+struct Sound {
+	std::string path;
+	std::vector<uint8_t> bytes;
+	WaveView wave;
+};
+
+void PrintUsage() { std::fprintf(stderr, "usage: mixbench [-v voices] [-s seconds] file.wav ...\n"); }
+
+// 全ブロックの展開を繰り返して、音 1 秒あたりの時間（マイクロ秒）を返す
+double MeasureDecode(const WaveView& wave, bool simd) {
+	const WaveFormat& f = wave.format;
+	const uint32_t frames = Adpcm::CountFrames(f, wave.samples.size());
+	const uint32_t blocks = static_cast<uint32_t>((wave.samples.size() + f.blockAlign - 1u) / f.blockAlign);
+	std::vector<int16_t> out(size_t(blocks) * f.samplesPerBlock * f.channels);
+	// 0.2 秒以上かかるまで回数を増やす
+	for (uint32_t repeat = 1u;; repeat *= 2u) {
+		const auto t0 = std::chrono::steady_clock::now();
+		for (uint32_t r = 0; r < repeat; ++r) {
+			if (simd)
+				Adpcm::DecodeBlocks(f, wave.samples.data(), wave.samples.size(), 0u, blocks, out.data());
+			else
+				Adpcm::DecodeBlocksScalar(f, wave.samples.data(), wave.samples.size(), 0u, blocks, out.data());
+		}
+		const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+		if (us >= 200000.0)
+			return us / repeat / (double(frames) / f.sampleRate);
+	}
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	uint32_t voiceCount = 256u;
+	double seconds = 10.0;
+	std::vector<Sound> sounds;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "-v") == 0 && i + 1 < argc) {
+			voiceCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+			seconds = std::atof(argv[++i]);
+		} else {
+			sounds.emplace_back();
+			sounds.back().path = argv[i];
+		}
+	}
+	if (sounds.empty() || voiceCount == 0u || seconds <= 0.0) {
+		PrintUsage();
+		return 1;
+	}
+
+	for (Sound& sound : sounds) {
+		if (!ReadFileBytes(sound.path, sound.bytes) || !ParseWave(sound.bytes, sound.wave) || !AudioMixer::IsSupported(sound.wave.format)) {
+			std::fprintf(stderr, "cannot use %s\n", sound.path.c_str());
+			return 1;
+		}
+		const WaveFormat& f = sound.wave.format;
+		const uint32_t frames = AudioMixer::CountFrames(sound.wave);
+		std::printf("%s: %u ch, %u Hz, %u bit%s, %.2f s\n", sound.path.c_str(), f.channels, f.sampleRate, f.bitsPerSample,
+		            f.formatTag == 3u ? " float" : (f.formatTag == Adpcm::kFormatTag ? " adpcm" : ""), double(frames) / f.sampleRate);
+		if (f.formatTag == Adpcm::kFormatTag) {
+			const size_t pcmBytes = size_t(frames) * f.channels * 2u;
+			std::printf("  adpcm decode: %.1f us per second of audio (scalar %.1f us), %zu bytes resident vs %zu as 16bit PCM (%.2fx)\n", MeasureDecode(sound.wave, true),
+			            MeasureDecode(sound.wave, false), sound.wave.samples.size(), pcmBytes, double(pcmBytes) / double(sound.wave.samples.size()));
+		}
+	}
+
+	AudioMixer mixer;
+	mixer.Initialize(voiceCount, kOutputRate, kBlockFrames);
+	uint32_t next = 0u;
+	uint32_t started = 0u;
+	auto startVoice = [&](uint32_t voice) {
+		// 音量 0.1～0.5・パン -1～1 をボイス番号と回数からばらけさせる
+		const float volume = 0.1f + 0.4f * float((started * 7u + voice) % 16u) / 15.0f;
+		const float pan = -1.0f + 2.0f * float((started * 13u + voice * 5u) % 17u) / 16.0f;
+		mixer.Start(voice, sounds[next].wave, volume, pan);
+		next = (next + 1u) % static_cast<uint32_t>(sounds.size());
+		started++;
+	};
+	for (uint32_t v = 0; v < voiceCount; ++v)
+		startVoice(v);
+
+	std::vector<float> out(kBlockFrames * AudioMixer::kChannels);
+	const uint32_t blocks = static_cast<uint32_t>(seconds * kOutputRate / kBlockFrames);
+	double mixMs = 0.0;
+	double worstMs = 0.0;
+	double checksum = 0.0;
+	for (uint32_t b = 0; b < blocks; ++b) {
+		const auto t0 = std::chrono::steady_clock::now();
+		mixer.Mix(out.data(), kBlockFrames);
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		mixMs += ms;
+		worstMs = std::max(worstMs, ms);
+		checksum += out[b % out.size()];
+
+		// 鳴り終わったボイスは次を鳴らす（計測の外）
+		for (uint32_t v = 0; v < voiceCount; ++v) {
+			if (!mixer.IsActive(v))
+				startVoice(v);
+		}
+	}
+
+	const AudioMixer::Stats& stats = mixer.GetStats();
+	const double audioMs = double(stats.framesMixed) * 1000.0 / kOutputRate;
+	std::printf("voices %u, %u blocks of %u frames (%.1f s of output), %u sounds started\n", voiceCount, blocks, kBlockFrames, audioMs / 1000.0, started);
+	std::printf("mix: %.4f ms/block avg, %.4f ms worst, %.1fx realtime, %.2f ns per voice-frame\n", mixMs / blocks, worstMs, audioMs / mixMs, mixMs * 1e6 / double(stats.voiceFrames));
+	std::printf("limiter: %u of %u blocks reduced, gain now %.3f (checksum %.3f)\n", stats.limited, blocks, stats.gain, checksum);
+	if (stats.adpcmBlocks)
+		std::printf("adpcm: %llu blocks decoded\n", static_cast<unsigned long long>(stats.adpcmBlocks));
+	return 0;
+}
@@ -0,0 +1,220 @@
+// アセットパック（.pak）作成ツール（オフライン・Linux / Windows 共通）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++17 -O2 -IDirectXGame Tools/PackBuilder/PackBuilder.cpp DirectXGame/Hash.cpp DirectXGame/Lz.cpp DirectXGame/FileBytes.cpp -o packbuilder
+//
+// 使い方:
+//   packbuilder -C DirectXGame -o DirectXGame/Resources.pak [-z] [-e mesh,png,...] Resources ...
+//   -C : 実行ディレクトリ（パック内のパスはここからの相対パス。ゲームは "Resources/..." で引く）
+//   -z : エントリごとに Lz 圧縮を試し、1/8 以上縮むものだけ圧縮して入れる（無圧縮のものはメモリマップ上を直接使える）
+//        .wav と .adpcm は圧縮しない（BGM は StreamingVoice がマップ上を少しずつ読み、効果音はミキサーがマップ上を直接鳴らす）
+//   -e : 入れる拡張子（既定 mesh,obj,mtl,png,jpg,dds,wav,adpcm,csv）
+//
+// ・ディレクトリは再帰的にたどる。パスは PackBlob::NormalizePath で正規化し、ハッシュ順に並べる
+// ・データは 16 バイト境界に置く
+#include "FileBytes.h"
+#include "Hash.h"
+#include "Lz.h"
+#include "PackBlob.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct Input {
+	std::string name; // 正規化したパス
+	std::string path; // 読み込むファイル
+	uint64_t hash = 0u;
+	std::vector<uint8_t> data; // 格納するデータ
+	uint32_t rawSize = 0u;
+	uint8_t compression = PackBlob::kStored;
+};
+
+void PrintUsage() { std::fprintf(stderr, "usage: packbuilder -C root -o out.pak [-z] [-e ext,ext,...] path ...\n"); }
+
+std::set<std::string> SplitExtensions(const std::string& list) {
+	std::set<std::string> out;
+	std::stringstream ss(list);
+	std::string ext;
+	while (std::getline(ss, ext, ','))
+		out.insert("." + PackBlob::NormalizePath(ext));
+	return out;
+}
+
+// マップ上をそのまま読むもの（圧縮すると丸ごと展開しないと読めない）
+bool IsReadInPlace(const std::string& name) {
+	const fs::path ext = fs::path(name).extension();
+	return ext == ".wav" || ext == ".adpcm";
+}
+
+void Collect(const fs::path& root, const fs::path& target, const std::set<std::string>& extensions, std::vector<Input>& inputs) {
+	auto add = [&](const fs::path& file) {
+		if (!extensions.count(PackBlob::NormalizePath(file.extension().string())))
+			return;
+		Input input;
+		input.path = file.string();
+		input.name = PackBlob::NormalizePath(fs::relative(file, root).generic_string());
+		inputs.push_back(std::move(input));
+	};
+
+	std::error_code ec;
+	const fs::path full = root / target;
+	if (!fs::is_directory(full, ec)) {
+		add(full);
+		return;
+	}
+	for (const fs::directory_entry& entry : fs::recursive_directory_iterator(full, ec)) {
+		if (entry.is_regular_file())
+			add(entry.path());
+	}
+}
+
+bool WriteAll(FILE* fp, const void* data, size_t size) { return size == 0u || std::fwrite(data, 1, size, fp) == size; }
+
+bool WritePadding(FILE* fp, size_t from, size_t to) {
+	static const uint8_t kZeros[PackBlob::kAlignment] = {};
+	return WriteAll(fp, kZeros, to - from);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	std::string root = ".", outPath;
+	bool compress = false;
+	std::set<std::string> extensions = SplitExtensions("mesh,obj,mtl,png,jpg,dds,wav,adpcm,csv");
+	std::vector<std::string> targets;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "-C" && i + 1 < argc) {
+			root = argv[++i];
+		} else if (arg == "-o" && i + 1 < argc) {
+			outPath = argv[++i];
+		} else if (arg == "-e" && i + 1 < argc) {
+			extensions = SplitExtensions(argv[++i]);
+		} else if (arg == "-z") {
+			compress = true;
+		} else if (!arg.empty() && arg[0] == '-') {
+			PrintUsage();
+			return 1;
+		} else {
+			targets.push_back(arg);
+		}
+	}
+	if (outPath.empty() || targets.empty()) {
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<Input> inputs;
+	for (const std::string& target : targets)
+		Collect(root, target, extensions, inputs);
+	if (inputs.empty()) {
+		std::fprintf(stderr, "error: no input files\n");
+		return 1;
+	}
+
+	// 読み込み・圧縮
+	uint64_t rawTotal = 0u, storedTotal = 0u;
+	uint32_t compressedCount = 0u;
+	for (Input& input : inputs) {
+		if (!ReadFileBytes(input.path, input.data) || input.data.size() > 0xFFFFFFFFu) {
+			std::fprintf(stderr, "error: cannot read %s\n", input.path.c_str());
+			return 1;
+		}
+		input.hash = HashBytes(input.name.data(), input.name.size());
+		input.rawSize = static_cast<uint32_t>(input.data.size());
+
+		if (compress && !input.data.empty() && !IsReadInPlace(input.name)) {
+			std::vector<uint8_t> packed;
+			Lz::Compress(input.data.data(), input.data.size(), packed);
+			if (packed.size() <= input.data.size() - input.data.size() / 8u) {
+				input.data = std::move(packed);
+				input.compression = PackBlob::kLz;
+				compressedCount++;
+			}
+		}
+		rawTotal += input.rawSize;
+		storedTotal += input.data.size();
+	}
+
+	// ハッシュ順（同じハッシュは名前順）。同じパスが2回入っていないか
+	std::sort(inputs.begin(), inputs.end(), [](const Input& a, const Input& b) { return a.hash != b.hash ? a.hash < b.hash : a.name < b.name; });
+	for (size_t i = 1; i < inputs.size(); ++i) {
+		if (inputs[i].name == inputs[i - 1u].name) {
+			std::fprintf(stderr, "error: duplicate path %s\n", inputs[i].name.c_str());
+			return 1;
+		}
+	}
+
+	// 配置
+	PackBlob::Header header{};
+	header.magic = PackBlob::kMagic;
+	header.version = PackBlob::kVersion;
+	header.entryCount = static_cast<uint32_t>(inputs.size());
+	header.entriesOffset = static_cast<uint32_t>(PackBlob::AlignUp(sizeof(PackBlob::Header)));
+	header.namesOffset = static_cast<uint32_t>(PackBlob::AlignUp(header.entriesOffset + sizeof(PackBlob::Entry) * inputs.size()));
+
+	std::vector<PackBlob::Entry> entries(inputs.size());
+	std::string names;
+	for (size_t i = 0; i < inputs.size(); ++i) {
+		if (inputs[i].name.size() > 0xFFFFu) {
+			std::fprintf(stderr, "error: path too long %s\n", inputs[i].name.c_str());
+			return 1;
+		}
+		entries[i].nameOffset = static_cast<uint32_t>(names.size());
+		entries[i].nameLength = static_cast<uint16_t>(inputs[i].name.size());
+		names += inputs[i].name;
+	}
+	header.namesSize = static_cast<uint32_t>(names.size());
+
+	uint64_t offset = PackBlob::AlignUp(header.namesOffset + names.size());
+	for (size_t i = 0; i < inputs.size(); ++i) {
+		PackBlob::Entry& e = entries[i];
+		e.pathHash = inputs[i].hash;
+		e.offset = static_cast<uint32_t>(offset);
+		e.size = static_cast<uint32_t>(inputs[i].data.size());
+		e.rawSize = inputs[i].rawSize;
+		e.compression = inputs[i].compression;
+		offset = PackBlob::AlignUp(offset + e.size);
+	}
+	if (offset > 0xFFFFFFFFu) {
+		std::fprintf(stderr, "error: pack exceeds 4 GB\n");
+		return 1;
+	}
+	// 最後のデータの終わりまで（末尾は詰めない）
+	header.fileSize = entries.back().offset + entries.back().size;
+
+	// 書き出し
+	FILE* fp = std::fopen(outPath.c_str(), "wb");
+	if (!fp) {
+		std::fprintf(stderr, "error: cannot write %s\n", outPath.c_str());
+		return 1;
+	}
+	bool ok = WriteAll(fp, &header, sizeof(header));
+	ok = ok && WritePadding(fp, sizeof(header), header.entriesOffset);
+	ok = ok && WriteAll(fp, entries.data(), sizeof(PackBlob::Entry) * entries.size());
+	ok = ok && WritePadding(fp, header.entriesOffset + sizeof(PackBlob::Entry) * entries.size(), header.namesOffset);
+	ok = ok && WriteAll(fp, names.data(), names.size());
+	size_t written = header.namesOffset + names.size();
+	for (size_t i = 0; ok && i < inputs.size(); ++i) {
+		ok = WritePadding(fp, written, entries[i].offset) && WriteAll(fp, inputs[i].data.data(), inputs[i].data.size());
+		written = entries[i].offset + inputs[i].data.size();
+	}
+	ok = (std::fclose(fp) == 0) && ok;
+	if (!ok) {
+		std::fprintf(stderr, "error: write failed %s\n", outPath.c_str());
+		return 1;
+	}
+
+	std::printf("%zu files, %llu bytes -> %u bytes pack (%u compressed, data %llu bytes)\n", inputs.size(), static_cast<unsigned long long>(rawTotal), header.fileSize, compressedCount,
+	            static_cast<unsigned long long>(storedTotal));
+	return 0;
+}
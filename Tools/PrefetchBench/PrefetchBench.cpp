@@ -0,0 +1,167 @@
+// 先読み（AssetCache::Prefetch*・UpdateLoading）の流れを JobSystem で再現して、フレーム時間への影響を計る（オフライン・Linux / Windows 共通）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -IDirectXGame Tools/PrefetchBench/PrefetchBench.cpp DirectXGame/JobSystem.cpp DirectXGame/Hash.cpp DirectXGame/FileBytes.cpp -pthread -o prefetchbench
+//
+// 使い方:
+//   prefetchbench [-j ワーカー数] [-f フレーム ms] [-n ジョブ数] [-w ジョブ ms] [-u 仕上げ ms] [-b 予算 ms] [ファイル ...]
+//   -j : ワーカー数（既定 0 = 論理コア数 - 1、最低1。main.cpp と同じ）
+//   -f : 1フレームの描画などにかかる時間（既定 16。眠って待つ）
+//   -n / -w : ファイルを与えないときの読み込みジョブの数と長さ（既定 3 本・150ms。ディスク待ちのように眠る）
+//   -u : 1件をメインスレッドで仕上げる時間（GPU 転送などの代わり、既定 1。回して待つ）
+//   -b : UpdateLoading の1フレームの予算（既定 4）
+//   ファイル : 与えると、ジョブは AssetCache と同じく ReadFileBytes + HashBytes をする（ファイルごとに1本）
+//
+// ・先読み：ジョブをワーカーへ投げ、毎フレーム「描画 → 読み終わったものを予算まで仕上げる」を全部仕上がるまで回す
+//   フレーム数・一番長かったフレーム・全体の時間を出す
+// ・比べる相手：先読みしない場合（シーンの切り替えで、同じ読み込みと仕上げを1フレームの中でメインスレッドがする）のそのフレームの時間
+#include "FileBytes.h"
+#include "Hash.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+// 回して待つ（眠るとほかのスレッドに譲ってしまい、メインスレッドの仕事の重さにならない）
+void Spin(double ms) {
+	const Clock::time_point t0 = Clock::now();
+	while (MsSince(t0) < ms) {
+	}
+}
+
+// AssetCache::Pending の代わり
+struct Pending {
+	std::string path; // 空ならただ眠るジョブ
+	JobSystem::Counter counter;
+	std::vector<uint8_t> bytes;
+	uint64_t contentHash = 0u;
+};
+
+// ワーカー（またはメインスレッド）でする読み込み
+void Load(Pending& pending, double jobMs) {
+	if (pending.path.empty()) {
+		std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(jobMs));
+		return;
+	}
+	if (ReadFileBytes(pending.path, pending.bytes))
+		pending.contentHash = HashBytes(pending.bytes.data(), pending.bytes.size());
+}
+
+void PrintUsage() { std::fprintf(stderr, "usage: prefetchbench [-j workers] [-f frame-ms] [-n jobs] [-w job-ms] [-u finish-ms] [-b budget-ms] [file ...]\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+	uint32_t workers = 0u;
+	double frameMs = 16.0;
+	uint32_t jobCount = 3u;
+	double jobMs = 150.0;
+	double finishMs = 1.0;
+	double budgetMs = 4.0;
+	std::vector<std::string> files;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+			workers = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+			frameMs = std::atof(argv[++i]);
+		} else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			jobCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+			jobMs = std::atof(argv[++i]);
+		} else if (std::strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+			finishMs = std::atof(argv[++i]);
+		} else if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+			budgetMs = std::atof(argv[++i]);
+		} else if (argv[i][0] == '-') {
+			PrintUsage();
+			return 1;
+		} else {
+			files.push_back(argv[i]);
+		}
+	}
+	const uint32_t count = files.empty() ? jobCount : static_cast<uint32_t>(files.size());
+	if (count == 0u || frameMs < 0.0 || jobMs < 0.0 || finishMs < 0.0 || budgetMs < 0.0) {
+		PrintUsage();
+		return 1;
+	}
+
+	auto makePending = [&](uint32_t i) {
+		std::unique_ptr<Pending> pending = std::make_unique<Pending>();
+		if (!files.empty())
+			pending->path = files[i];
+		return pending;
+	};
+
+	// 先読みしない場合：切り替えのフレームで全部をメインスレッドが読み、仕上げる
+	const Clock::time_point syncStart = Clock::now();
+	std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(frameMs));
+	uint64_t syncBytes = 0u;
+	for (uint32_t i = 0; i < count; ++i) {
+		std::unique_ptr<Pending> pending = makePending(i);
+		Load(*pending, jobMs);
+		Spin(finishMs);
+		syncBytes += pending->bytes.size();
+	}
+	const double syncFrameMs = MsSince(syncStart);
+
+	// 先読み：ワーカーで読み、毎フレーム予算の中で仕上げる（AssetCache::UpdateLoading と同じ回し方）
+	JobSystem* jobs = JobSystem::GetInstance();
+	jobs->Initialize(workers);
+	const Clock::time_point start = Clock::now();
+	std::deque<std::unique_ptr<Pending>> pendings;
+	for (uint32_t i = 0; i < count; ++i) {
+		pendings.push_back(makePending(i));
+		Pending* pending = pendings.back().get();
+		jobs->Submit([pending, jobMs] { Load(*pending, jobMs); }, &pending->counter);
+	}
+
+	uint32_t frames = 0u;
+	uint32_t finished = 0u;
+	uint64_t bytes = 0u;
+	double worstMs = 0.0;
+	while (!pendings.empty()) {
+		const Clock::time_point frameStart = Clock::now();
+		std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(frameMs));
+
+		// 依頼順に、読み終わっているものだけ仕上げる
+		const Clock::time_point updateStart = Clock::now();
+		for (auto it = pendings.begin(); it != pendings.end();) {
+			if (!jobs->IsDone((*it)->counter)) {
+				++it;
+				continue;
+			}
+			Spin(finishMs);
+			bytes += (*it)->bytes.size();
+			it = pendings.erase(it);
+			finished++;
+			if (MsSince(updateStart) >= budgetMs)
+				break;
+		}
+
+		frames++;
+		worstMs = (std::max)(worstMs, MsSince(frameStart));
+	}
+	const double totalMs = MsSince(start);
+	jobs->Finalize();
+
+	if (files.empty())
+		std::printf("%u jobs of %.0f ms, %.1f ms to finish each, %.0f ms frames, %.0f ms budget\n", count, jobMs, finishMs, frameMs, budgetMs);
+	else
+		std::printf("%u files (%llu bytes), %.1f ms to finish each, %.0f ms frames, %.0f ms budget\n", count, static_cast<unsigned long long>(bytes), finishMs, frameMs, budgetMs);
+	std::printf("  prefetch    : %u frames, worst frame %.1f ms, all finished after %.1f ms\n", frames, worstMs, totalMs);
+	std::printf("  synchronous : one %.1f ms frame at the scene switch\n", syncFrameMs);
+	return finished == count && bytes == syncBytes ? 0 : 1;
+}
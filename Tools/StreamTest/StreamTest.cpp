@@ -0,0 +1,217 @@
+// StreamingVoice の検査（オフライン・Linux / Windows 共通。NullAudioSink で流すので音は出ない）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -IDirectXGame Tools/StreamTest/StreamTest.cpp DirectXGame/StreamingVoice.cpp DirectXGame/NullAudioSink.cpp DirectXGame/WaveFile.cpp DirectXGame/AssetPack.cpp DirectXGame/MappedFile.cpp DirectXGame/Lz.cpp DirectXGame/Hash.cpp DirectXGame/FileBytes.cpp -pthread -o streamtest
+//
+// 使い方:
+//   streamtest [-l ループ数] [作業フォルダ]
+//   -l : ループ再生で流す長さ（元の波形の何周ぶんか、既定 3.5）
+//   作業フォルダ : 試験用の WAV を Resources/BGM/ に書くところ（既定は一時フォルダの streamtest）
+//
+// ・乱数の波形（2 秒 + 端数フレームの 16bit ステレオ。fmt の後ろに LIST チャンクも挟む）の WAV を書き、StreamingVoice で鳴らす
+// ・ループ：出力先を手で少しずつ（乱数の長さで）進め、再生した波形が元の波形を周回したものとバイト単位で一致するか（継ぎ目も含めて）と、
+//   ループ回数・アンダーラン 0 を調べる
+// ・ループなし：出力先が受け取ったそばから再生し終えたことにして、ちょうど data チャンクぶんで終わるか
+// ・アンダーラン：渡したバッファを埋め直しを待たずに使い切ったとき、1回と数えられるか（20 回繰り返し、裏のスレッドが間に合ったものは数えない）
+// ・ないファイルの Play が false を返すか
+// ・食い違いがあれば内容を表示して 1 を返す
+#include "NullAudioSink.h"
+#include "StreamingVoice.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+const char* kTestWave = "BGM/streamtest.wav";
+
+void Put16(std::vector<uint8_t>& out, uint16_t value) {
+	out.push_back(static_cast<uint8_t>(value));
+	out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void Put32(std::vector<uint8_t>& out, uint32_t value) {
+	for (int i = 0; i < 4; ++i)
+		out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void PutTag(std::vector<uint8_t>& out, const char* tag) { out.insert(out.end(), tag, tag + 4); }
+
+// 44.1kHz 16bit ステレオの WAV を path に書く。data チャンクの中身を pcm に返す
+bool WriteTestWave(const fs::path& path, uint32_t frames, std::vector<uint8_t>& pcm) {
+	std::mt19937 rng(7u);
+	pcm.resize(size_t(frames) * 4u);
+	for (uint8_t& b : pcm)
+		b = static_cast<uint8_t>(rng());
+
+	std::vector<uint8_t> file;
+	PutTag(file, "RIFF");
+	Put32(file, 0u); // あとで埋める
+	PutTag(file, "WAVE");
+	PutTag(file, "fmt ");
+	Put32(file, 18u); // cbSize つき
+	Put16(file, 1u);  // PCM
+	Put16(file, 2u);
+	Put32(file, 44100u);
+	Put32(file, 44100u * 4u);
+	Put16(file, 4u);
+	Put16(file, 16u);
+	Put16(file, 0u);
+	// 読み飛ばすチャンク（奇数長なので詰め物の 1 バイトが付く）
+	PutTag(file, "LIST");
+	Put32(file, 5u);
+	file.insert(file.end(), {'a', 'b', 'c', 'd', 'e', 0});
+	PutTag(file, "data");
+	Put32(file, static_cast<uint32_t>(pcm.size()));
+	file.insert(file.end(), pcm.begin(), pcm.end());
+	const uint32_t riffSize = static_cast<uint32_t>(file.size() - 8u);
+	std::memcpy(&file[4], &riffSize, sizeof(riffSize));
+
+	FILE* fp = std::fopen(path.string().c_str(), "wb");
+	if (!fp)
+		return false;
+	const bool ok = std::fwrite(file.data(), 1, file.size(), fp) == file.size();
+	return std::fclose(fp) == 0 && ok;
+}
+
+// 再生した波形が、元の波形を先頭から周回したものと一致するか。食い違った最初の位置（なければ played.size()）
+size_t FindMismatch(const std::vector<uint8_t>& played, const std::vector<uint8_t>& pcm) {
+	for (size_t i = 0; i < played.size(); ++i) {
+		if (played[i] != pcm[i % pcm.size()])
+			return i;
+	}
+	return played.size();
+}
+
+void PrintUsage() { std::fprintf(stderr, "usage: streamtest [-l loops] [work-dir]\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+	double loops = 3.5;
+	fs::path workDir;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+			loops = std::atof(argv[++i]);
+		} else if (argv[i][0] == '-') {
+			PrintUsage();
+			return 1;
+		} else {
+			workDir = argv[i];
+		}
+	}
+	if (loops <= 0.0) {
+		PrintUsage();
+		return 1;
+	}
+
+	// StreamingVoice は Resources/ から読むので、作業フォルダへ移ってから書く
+	std::error_code ec;
+	if (workDir.empty())
+		workDir = fs::temp_directory_path(ec) / "streamtest";
+	fs::create_directories(workDir / "Resources" / "BGM", ec);
+	fs::current_path(workDir, ec);
+	if (ec) {
+		std::fprintf(stderr, "cannot use %s\n", workDir.string().c_str());
+		return 1;
+	}
+	std::vector<uint8_t> pcm;
+	if (!WriteTestWave(fs::path("Resources") / kTestWave, 44100u * 2u + 123u, pcm)) {
+		std::fprintf(stderr, "cannot write the test wave\n");
+		return 1;
+	}
+
+	uint32_t fails = 0u;
+	auto check = [&](bool ok, const char* what) {
+		std::printf("  %-44s %s\n", what, ok ? "OK" : "FAIL");
+		if (!ok)
+			fails++;
+	};
+
+	// ループ：手で進める（毎回、スレッドが全部埋め直すのを待ってから）
+	{
+		StreamingVoice voice;
+		NullAudioSink* sink = new NullAudioSink(false);
+		std::vector<uint8_t> played;
+		sink->SetCapture(&played);
+		if (!voice.Play(kTestWave, std::unique_ptr<AudioSink>(sink), true, 0.5f)) {
+			std::fprintf(stderr, "cannot play %s\n", kTestWave);
+			return 1;
+		}
+		std::mt19937 rng(3u);
+		const size_t target = static_cast<size_t>(double(pcm.size()) * loops);
+		while (played.size() < target) {
+			while (sink->GetQueuedCount() < StreamingVoice::kBufferCount)
+				std::this_thread::yield();
+			sink->Consume(1u + rng() % 100000u);
+		}
+		const StreamingVoice::Stats stats = voice.GetStats();
+		const size_t mismatch = FindMismatch(played, pcm);
+		std::printf("loop: %zu bytes played (%.2f times the %zu-byte data chunk), %u loops, %u buffers, %u underruns\n", played.size(), double(played.size()) / double(pcm.size()), pcm.size(),
+		            stats.loops, stats.buffersSubmitted, stats.underruns);
+		if (mismatch != played.size())
+			std::printf("  first mismatch at byte %zu (loop %zu, offset %zu)\n", mismatch, mismatch / pcm.size(), mismatch % pcm.size());
+		check(mismatch == played.size(), "byte-exact across every loop seam");
+		check(stats.loops >= static_cast<uint32_t>(played.size() / pcm.size()), "loops counted");
+		check(stats.underruns == 0u, "no underrun while the sink waits for refills");
+		check(voice.IsPlaying() && sink->GetVolume() == 0.5f, "still playing at the requested volume");
+		voice.Stop();
+		check(!voice.IsPlaying(), "Stop ends playback");
+	}
+
+	// ループなし：受け取ったそばから再生し終えたことにする
+	{
+		StreamingVoice voice;
+		NullAudioSink* sink = new NullAudioSink(true);
+		std::vector<uint8_t> played;
+		sink->SetCapture(&played);
+		voice.Play(kTestWave, std::unique_ptr<AudioSink>(sink), false);
+		const auto t0 = std::chrono::steady_clock::now();
+		while (voice.IsPlaying())
+			std::this_thread::yield();
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		std::printf("one-shot: %zu bytes in %.2f ms\n", played.size(), ms);
+		check(played == pcm, "plays exactly the data chunk");
+		check(sink->IsStreamEnded(), "last buffer marked as end of stream");
+	}
+
+	// アンダーラン：渡した分を、埋め直しを待たずにまとめて使い切る
+	// 使い切った直後に裏のスレッドが1つ渡し終えていると尽きなかった扱いになるので、何度か繰り返して数える
+	{
+		const uint32_t kDrains = 20u;
+		uint32_t counted = 0u;
+		uint32_t overCounted = 0u;
+		for (uint32_t i = 0; i < kDrains; ++i) {
+			StreamingVoice voice;
+			NullAudioSink* sink = new NullAudioSink(false);
+			voice.Play(kTestWave, std::unique_ptr<AudioSink>(sink), true);
+			sink->Consume(StreamingVoice::kBufferBytes * StreamingVoice::kBufferCount);
+			// 裏のスレッドが埋め直すまで待つ（尽きたことはその前に数えられている）
+			while (sink->GetQueuedCount() < StreamingVoice::kBufferCount)
+				std::this_thread::yield();
+			const uint32_t underruns = voice.GetStats().underruns;
+			counted += underruns == 1u ? 1u : 0u;
+			overCounted += underruns > 1u ? 1u : 0u;
+		}
+		std::printf("starve: %u of %u drains counted as one underrun\n", counted, kDrains);
+		check(counted > 0u, "draining the sink counts an underrun");
+		check(overCounted == 0u, "one drain is never counted twice");
+	}
+
+	// ないファイル
+	{
+		StreamingVoice voice;
+		check(!voice.Play("BGM/none.wav", std::make_unique<NullAudioSink>(), true), "missing file fails to play");
+	}
+
+	std::printf("fails=%u\n", fails);
+	return fails == 0u ? 0 : 1;
+}
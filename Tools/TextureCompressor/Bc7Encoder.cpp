@@ -0,0 +1,86 @@
+#include "Bc7Encoder.h"
+#include <BC.h>
+#include <algorithm>
+
+namespace Bc7 {
+
+namespace {
+
+uint32_t FlagsOf(Search search) {
+	switch (search) {
+	case Search::kFast:
+		return DirectX::BC_FLAGS_FORCE_BC7_MODE6;
+	case Search::kMax:
+		return DirectX::BC_FLAGS_USE_3SUBSETS;
+	default:
+		return DirectX::BC_FLAGS_NONE;
+	}
+}
+
+// ブロック行 by を encode（画像の外は端の画素で埋める）
+void EncodeRow(const uint8_t* rgba, size_t width, size_t height, size_t rowPitch, uint8_t* blockRow, size_t by, uint32_t flags) {
+	const float kInv255 = 1.0f / 255.0f;
+	const size_t blocksX = (width + 3u) / 4u;
+	DirectX::XMVECTOR colors[DirectX::NUM_PIXELS_PER_BLOCK];
+
+	for (size_t bx = 0; bx < blocksX; ++bx) {
+		for (size_t py = 0; py < 4u; ++py) {
+			const size_t y = (std::min)(by * 4u + py, height - 1u);
+			const uint8_t* row = rgba + y * rowPitch;
+			for (size_t px = 0; px < 4u; ++px) {
+				const size_t x = (std::min)(bx * 4u + px, width - 1u);
+				const uint8_t* p = row + x * 4u;
+				colors[py * 4u + px] = DirectX::XMVectorSet(p[0] * kInv255, p[1] * kInv255, p[2] * kInv255, p[3] * kInv255);
+			}
+		}
+		DirectX::D3DXEncodeBC7(blockRow + bx * 16u, colors, flags);
+	}
+}
+
+} // namespace
+
+const char* SearchName(Search search) {
+	switch (search) {
+	case Search::kFast:
+		return "fast";
+	case Search::kMax:
+		return "max";
+	default:
+		return "normal";
+	}
+}
+
+void AppendRowTasks(const uint8_t* rgba, size_t width, size_t height, size_t rowPitch, uint8_t* blocks, size_t blockRowPitch, Search search, std::vector<StealingPool::Task>& tasks) {
+	const uint32_t flags = FlagsOf(search);
+	const size_t blocksY = (height + 3u) / 4u;
+	for (size_t by = 0; by < blocksY; ++by) {
+		uint8_t* blockRow = blocks + by * blockRowPitch;
+		tasks.push_back([=] { EncodeRow(rgba, width, height, rowPitch, blockRow, by, flags); });
+	}
+}
+
+HRESULT Compress(const DirectX::ScratchImage& source, DXGI_FORMAT format, Search search, StealingPool& pool, DirectX::ScratchImage& out) {
+	const DirectX::TexMetadata& meta = source.GetMetadata();
+	if (meta.format != DXGI_FORMAT_R8G8B8A8_UNORM && meta.format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
+		return E_INVALIDARG;
+	if (format != DXGI_FORMAT_BC7_UNORM && format != DXGI_FORMAT_BC7_UNORM_SRGB)
+		return E_INVALIDARG;
+
+	HRESULT hr = out.Initialize2D(format, meta.width, meta.height, 1u, meta.mipLevels);
+	if (FAILED(hr))
+		return hr;
+
+	// 全ミップのブロック行をまとめて配る（小さいミップも大きいミップの隙間で片付く）
+	std::vector<StealingPool::Task> tasks;
+	for (size_t mip = 0; mip < meta.mipLevels; ++mip) {
+		const DirectX::Image* src = source.GetImage(mip, 0, 0);
+		const DirectX::Image* dst = out.GetImage(mip, 0, 0);
+		if (!src || !dst)
+			return E_FAIL;
+		AppendRowTasks(src->pixels, src->width, src->height, src->rowPitch, dst->pixels, dst->rowPitch, search, tasks);
+	}
+	pool.Run(tasks);
+	return S_OK;
+}
+
+} // namespace Bc7
@@ -0,0 +1,27 @@
+#pragma once
+#include "StealingPool.h"
+#include <DirectXTex.h>
+#include <cstddef>
+#include <cstdint>
+
+// D3DXEncodeBC7 を 4x4 ブロックの行単位でスレッドへ配る BC7 エンコーダ
+// ・全ミップの全ブロック行を1つのタスク列にして StealingPool で回す
+// ・入力は RGBA8（sRGB 版も同じ値のまま渡す。DirectXTex の Compress と同じく色空間の変換はしない）
+namespace Bc7 {
+
+// モード・分割の探索範囲
+enum class Search {
+	kFast,   // モード6のみ（TEX_COMPRESS_BC7_QUICK 相当）
+	kNormal, // 3分割のモード0/2を除く（DirectXTex の既定）
+	kMax     // 全モード
+};
+
+const char* SearchName(Search search);
+
+// 1ミップぶんのブロック行を encode するタスクを積む（rgba は rowPitch バイト間隔、blocks は blockRowPitch バイト間隔）
+void AppendRowTasks(const uint8_t* rgba, size_t width, size_t height, size_t rowPitch, uint8_t* blocks, size_t blockRowPitch, Search search, std::vector<StealingPool::Task>& tasks);
+
+// RGBA8 のミップチェーン全体を BC7 にする（format は BC7_UNORM か BC7_UNORM_SRGB）
+HRESULT Compress(const DirectX::ScratchImage& source, DXGI_FORMAT format, Search search, StealingPool& pool, DirectX::ScratchImage& out);
+
+} // namespace Bc7
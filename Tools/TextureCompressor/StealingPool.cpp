@@ -0,0 +1,97 @@
+#include "StealingPool.h"
+
+StealingPool::StealingPool(uint32_t workers) {
+	for (uint32_t i = 0; i <= workers; ++i)
+		queues_.push_back(std::make_unique<Queue>());
+	for (uint32_t i = 0; i < workers; ++i)
+		threads_.emplace_back([this, i] { WorkerMain(i); });
+}
+
+StealingPool::~StealingPool() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		quit_ = true;
+	}
+	wake_.notify_all();
+	for (std::thread& t : threads_)
+		t.join();
+}
+
+void StealingPool::Run(std::vector<Task>& tasks) {
+	if (tasks.empty())
+		return;
+
+	std::atomic<size_t> remaining{tasks.size()};
+
+	// 先に数を足してから積む（取り出し側の引き算が先に来て 0 を下回らないように）
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		queued_.fetch_add(tasks.size(), std::memory_order_release);
+	}
+
+	// 各キューへ順に配る（呼び出しごとに開始位置をずらす）
+	const size_t queueCount = queues_.size();
+	size_t q = nextQueue_.fetch_add(1u, std::memory_order_relaxed);
+	for (Task& task : tasks) {
+		Queue& queue = *queues_[q++ % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.items.push_back({&task, &remaining});
+	}
+	wake_.notify_all();
+
+	// 呼び出し側は最後のキューを自分のものとして手伝う
+	Item item;
+	while (remaining.load(std::memory_order_acquire) != 0u) {
+		if (TryPop(queueCount - 1u, item))
+			Execute(item);
+		else
+			std::this_thread::yield();
+	}
+}
+
+bool StealingPool::TryPop(size_t self, Item& item) {
+	{
+		Queue& own = *queues_[self];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.items.empty()) {
+			item = own.items.front();
+			own.items.pop_front();
+			queued_.fetch_sub(1u, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// 隣から順に盗む
+	const size_t queueCount = queues_.size();
+	for (size_t i = 1; i < queueCount; ++i) {
+		Queue& victim = *queues_[(self + i) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.items.empty()) {
+			item = victim.items.back();
+			victim.items.pop_back();
+			queued_.fetch_sub(1u, std::memory_order_relaxed);
+			steals_.fetch_add(1u, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void StealingPool::Execute(const Item& item) {
+	(*item.task)();
+	item.remaining->fetch_sub(1u, std::memory_order_release);
+}
+
+void StealingPool::WorkerMain(size_t self) {
+	Item item;
+	for (;;) {
+		if (TryPop(self, item)) {
+			Execute(item);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		wake_.wait(lock, [this] { return quit_ || queued_.load(std::memory_order_acquire) != 0u; });
+		if (quit_ && queued_.load(std::memory_order_acquire) == 0u)
+			return;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ワークスティーリング方式のスレッドプール（オフラインツール用）
+// ・Run に渡したタスクを各キューへ順に配り、各スレッドは自分のキューの先頭から取り、空なら他のキューの末尾から盗む
+// ・Run は複数スレッドから同時に呼んでよい。呼び出し側も実行に加わり、渡した分が全部終わるまで返らない
+class StealingPool {
+public:
+	using Task = std::function<void()>;
+
+	// workers は呼び出し側以外のスレッド数（0 なら呼び出し側だけで実行）
+	explicit StealingPool(uint32_t workers);
+	~StealingPool();
+	StealingPool(const StealingPool&) = delete;
+	StealingPool& operator=(const StealingPool&) = delete;
+
+	void Run(std::vector<Task>& tasks);
+
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+	// 盗んで実行した数（偏りの確認用）
+	uint64_t GetSteals() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+	struct Item {
+		Task* task = nullptr;
+		std::atomic<size_t>* remaining = nullptr;
+	};
+
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Item> items;
+	};
+
+	// self のキューの先頭、なければ他のキューの末尾から取る
+	bool TryPop(size_t self, Item& item);
+	static void Execute(const Item& item);
+	void WorkerMain(size_t self);
+
+	std::vector<std::unique_ptr<Queue>> queues_; // ワーカーごと + 呼び出し側用に1つ
+	std::vector<std::thread> threads_;
+	std::atomic<size_t> queued_{0u};
+	std::atomic<size_t> nextQueue_{0u};
+	std::atomic<uint64_t> steals_{0u};
+	std::mutex sleepMutex_;
+	std::condition_variable wake_;
+	bool quit_ = false;
+};
@@ -0,0 +1,342 @@
+// テクスチャ圧縮ツール（オフライン・Linux / Windows 共通、DirectXTex 使用）
+//
+// ビルド例（リポジトリ直下で）:
+//   Linux  : DirectXTex を CMake でビルドし、DirectX-Headers（$DXH）・DirectXMath（$DXMATH）と合わせて使う（1行で）
+//     g++ -std=c++17 -O2 -ITools/Common -IExternal/DirectXTex/include -I$DXH/include -I$DXH/include/wsl/stubs -I$DXMATH/Inc
+//         Tools/TextureCompressor/*.cpp Tools/Common/Png.cpp -L$DXTEX_LIB -lDirectXTex -lz -pthread -o texcompress
+//   Windows: 同じソースを DirectXTex.lib とリンクする（BC.h の D3DXEncodeBC7 も DirectXTex.lib に入っている）
+//
+// 使い方:
+//   texcompress [-q minPsnr] [-j threads] [-bc7 fast|normal|max] [-linear] [-n] [-bench] 画像.png|ディレクトリ ...
+//   -q      : 採用する最低 PSNR（dB、既定 40）。どの形式も届かなければ RGBA8 のまま DDS にする
+//   -j      : 並列数（既定は論理コア数）
+//   -bc7    : BC7 のモード・分割の探索範囲（既定 normal。fast はモード6のみ、max は全モード）
+//   -linear : 色をリニアとして扱う（既定は sRGB。TextureManager が PNG を sRGB で読むのに合わせる）
+//   -n      : 書き出さずに結果だけ表示
+//   -bench  : 書き出さず、入力の最上段を BC7 にする速度（メガピクセル/秒）を1スレッドと並列で比べる
+//
+// ・α の使い方で候補を決め、先頭から PSNR を満たした形式を採る
+//     不透明 → BC1 → BC7 / 0 か 255 だけ → BC1（1bit α）→ BC7 / 半透明あり → BC3 → BC7
+// ・ミップマップは全段作り、同じ場所に同じ名前の .dds を書く（実行時は TextureFile.h で .dds を優先する）
+// ・ファイル単位で並列に処理する。ファイル数が並列数より少ないときは DirectXTex 側の並列圧縮を使う
+// ・BC7 は遅いので Bc7Encoder でブロック行に分けてワークスティーリングのプールへ配る（ファイルをまたいで共有）
+#include "Bc7Encoder.h"
+#include "Png.h"
+#include <DirectXTex.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// α の使い方
+enum class AlphaUsage {
+	kOpaque, // 全て 255
+	kBinary, // 0 か 255 のみ
+	kBlended // 中間値あり
+};
+
+struct Options {
+	float minPsnr = 40.0f;
+	uint32_t threads = 0u;
+	Bc7::Search bc7 = Bc7::Search::kNormal;
+	bool srgb = true;
+	bool dryRun = false;
+	bool bench = false;
+};
+
+struct Result {
+	std::string path;
+	uint32_t width = 0u;
+	uint32_t height = 0u;
+	size_t mips = 0u;
+	AlphaUsage alpha = AlphaUsage::kOpaque;
+	DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+	float psnr = 0.0f;
+	uintmax_t pngBytes = 0u;
+	uintmax_t ddsBytes = 0u;
+	std::string error;
+};
+
+void PrintUsage() { std::fprintf(stderr, "usage: texcompress [-q minPsnr] [-j threads] [-bc7 fast|normal|max] [-linear] [-n] [-bench] image.png|directory ...\n"); }
+
+const char* AlphaName(AlphaUsage alpha) {
+	switch (alpha) {
+	case AlphaUsage::kOpaque:
+		return "opaque";
+	case AlphaUsage::kBinary:
+		return "1bit";
+	default:
+		return "blend";
+	}
+}
+
+const char* FormatName(DXGI_FORMAT format) {
+	switch (format) {
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+		return "BC1";
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+		return "BC3";
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return "BC7";
+	case DXGI_FORMAT_R8G8B8A8_UNORM:
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+		return "RGBA8";
+	default:
+		return "?";
+	}
+}
+
+AlphaUsage AnalyzeAlpha(const Png::Image& image) {
+	AlphaUsage usage = AlphaUsage::kOpaque;
+	for (size_t i = 3; i < image.rgba.size(); i += 4u) {
+		const uint8_t a = image.rgba[i];
+		if (a == 255u)
+			continue;
+		if (a != 0u)
+			return AlphaUsage::kBlended;
+		usage = AlphaUsage::kBinary;
+	}
+	return usage;
+}
+
+// 誤差（0～1 の二乗平均）→ PSNR
+float PsnrOf(float mse) { return mse > 0.0f ? 10.0f * std::log10(1.0f / mse) : 99.0f; }
+
+void Process(const std::string& path, const Options& options, bool parallelCompress, StealingPool& pool, Result& result) {
+	result.path = path;
+	std::error_code ec;
+	result.pngBytes = fs::file_size(path, ec);
+
+	Png::Image png;
+	if (!Png::Load(path, png, result.error))
+		return;
+	result.width = png.width;
+	result.height = png.height;
+	result.alpha = AnalyzeAlpha(png);
+
+	// RGBA8 の元画像
+	const DXGI_FORMAT sourceFormat = options.srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+	DirectX::ScratchImage source;
+	if (FAILED(source.Initialize2D(sourceFormat, png.width, png.height, 1u, 1u))) {
+		result.error = "Initialize2D failed";
+		return;
+	}
+	const DirectX::Image* base = source.GetImage(0, 0, 0);
+	for (uint32_t y = 0; y < png.height; ++y)
+		std::copy_n(png.Pixel(0u, y), static_cast<size_t>(png.width) * 4u, base->pixels + y * base->rowPitch);
+
+	// ミップマップ（1x1 は1段のみ）
+	DirectX::ScratchImage mipChain;
+	if (png.width > 1u || png.height > 1u) {
+		if (FAILED(DirectX::GenerateMipMaps(*base, DirectX::TEX_FILTER_DEFAULT, 0u, mipChain))) {
+			result.error = "GenerateMipMaps failed";
+			return;
+		}
+	} else {
+		mipChain = std::move(source);
+	}
+	result.mips = mipChain.GetMetadata().mipLevels;
+
+	// 候補（先頭から試す）
+	const DXGI_FORMAT bc1 = options.srgb ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+	const DXGI_FORMAT bc3 = options.srgb ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+	const DXGI_FORMAT bc7 = options.srgb ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+	const DXGI_FORMAT candidates[2] = {result.alpha == AlphaUsage::kBlended ? bc3 : bc1, bc7};
+
+	DirectX::TEX_COMPRESS_FLAGS flags = DirectX::TEX_COMPRESS_DEFAULT;
+	if (parallelCompress)
+		flags |= DirectX::TEX_COMPRESS_PARALLEL;
+
+	DirectX::ScratchImage chosen;
+	for (DXGI_FORMAT format : candidates) {
+		DirectX::ScratchImage compressed;
+		const HRESULT hr = format == bc7 ? Bc7::Compress(mipChain, format, options.bc7, pool, compressed)
+		                                 : DirectX::Compress(mipChain.GetImages(), mipChain.GetImageCount(), mipChain.GetMetadata(), format, flags, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+		if (FAILED(hr)) {
+			result.error = std::string("Compress ") + FormatName(format) + " failed";
+			return;
+		}
+
+		// 最上段で比べる（ComputeMSE が BC を展開して比較する）
+		float mse = 0.0f;
+		if (FAILED(DirectX::ComputeMSE(*mipChain.GetImage(0, 0, 0), *compressed.GetImage(0, 0, 0), mse, nullptr))) {
+			result.error = "ComputeMSE failed";
+			return;
+		}
+		const float psnr = PsnrOf(mse);
+		if (psnr >= options.minPsnr) {
+			result.format = format;
+			result.psnr = psnr;
+			chosen = std::move(compressed);
+			break;
+		}
+	}
+
+	// どれも届かなければ無圧縮
+	if (result.format == DXGI_FORMAT_UNKNOWN) {
+		result.format = sourceFormat;
+		result.psnr = 99.0f;
+		chosen = std::move(mipChain);
+	}
+
+	if (options.dryRun)
+		return;
+
+	const fs::path ddsPath = fs::path(path).replace_extension(".dds");
+	if (FAILED(DirectX::SaveToDDSFile(chosen.GetImages(), chosen.GetImageCount(), chosen.GetMetadata(), DirectX::DDS_FLAGS_NONE, ddsPath.wstring().c_str()))) {
+		result.error = "SaveToDDSFile failed: " + ddsPath.string();
+		return;
+	}
+	result.ddsBytes = fs::file_size(ddsPath, ec);
+}
+
+// 最上段の BC7 化の速度を1スレッドとプールで比べる
+int Bench(const std::vector<std::string>& inputs, uint32_t threads) {
+	std::vector<Png::Image> images;
+	double megapixels = 0.0;
+	for (const std::string& path : inputs) {
+		Png::Image image;
+		std::string error;
+		if (!Png::Load(path, image, error)) {
+			std::fprintf(stderr, "skip: %s\n", error.c_str()); // 速度比較なので読めないものは飛ばす
+			continue;
+		}
+		megapixels += static_cast<double>(image.width) * image.height / 1.0e6;
+		images.push_back(std::move(image));
+	}
+	if (images.empty())
+		return 1;
+
+	StealingPool single(0u);
+	StealingPool parallel(threads > 1u ? threads - 1u : 0u);
+	std::printf("%zu textures, %.2f MP, %u threads\n", images.size(), megapixels, threads);
+
+	for (Bc7::Search search : {Bc7::Search::kFast, Bc7::Search::kNormal}) {
+		double seconds[2] = {};
+		StealingPool* pools[2] = {&single, &parallel};
+		for (int p = 0; p < 2; ++p) {
+			std::vector<std::vector<uint8_t>> outputs(images.size());
+			std::vector<StealingPool::Task> tasks;
+			for (size_t i = 0; i < images.size(); ++i) {
+				const Png::Image& image = images[i];
+				const size_t blockRowPitch = (image.width + 3u) / 4u * 16u;
+				outputs[i].resize(blockRowPitch * ((image.height + 3u) / 4u));
+				Bc7::AppendRowTasks(image.rgba.data(), image.width, image.height, image.width * 4u, outputs[i].data(), blockRowPitch, search, tasks);
+			}
+			const auto start = std::chrono::steady_clock::now();
+			pools[p]->Run(tasks);
+			seconds[p] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+		std::printf("bc7 %-6s  1 thread %8.3f MP/s  %2u threads %8.3f MP/s  x%.2f (steals %llu)\n", Bc7::SearchName(search), megapixels / seconds[0], threads, megapixels / seconds[1],
+		            seconds[0] / seconds[1], static_cast<unsigned long long>(parallel.GetSteals()));
+	}
+	return 0;
+}
+
+void CollectInputs(const std::string& arg, std::vector<std::string>& inputs) {
+	std::error_code ec;
+	if (!fs::is_directory(arg, ec)) {
+		inputs.push_back(arg);
+		return;
+	}
+	for (const fs::directory_entry& entry : fs::recursive_directory_iterator(arg, ec)) {
+		if (entry.is_regular_file() && entry.path().extension() == ".png")
+			inputs.push_back(entry.path().generic_string());
+	}
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	std::vector<std::string> inputs;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "-q" && i + 1 < argc) {
+			options.minPsnr = static_cast<float>(std::atof(argv[++i]));
+		} else if (arg == "-j" && i + 1 < argc) {
+			options.threads = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+		} else if (arg == "-bc7" && i + 1 < argc) {
+			std::string v = argv[++i];
+			if (v == "fast")
+				options.bc7 = Bc7::Search::kFast;
+			else if (v == "max")
+				options.bc7 = Bc7::Search::kMax;
+			else if (v == "normal")
+				options.bc7 = Bc7::Search::kNormal;
+			else
+				return PrintUsage(), 1;
+		} else if (arg == "-bench") {
+			options.bench = true;
+		} else if (arg == "-linear") {
+			options.srgb = false;
+		} else if (arg == "-n") {
+			options.dryRun = true;
+		} else if (!arg.empty() && arg[0] == '-') {
+			PrintUsage();
+			return 1;
+		} else {
+			CollectInputs(arg, inputs);
+		}
+	}
+	if (inputs.empty()) {
+		PrintUsage();
+		return 1;
+	}
+	std::sort(inputs.begin(), inputs.end());
+
+	const uint32_t maxThreads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+	if (options.bench)
+		return Bench(inputs, maxThreads);
+
+	// BC7 のブロック行を配るプール（ファイル処理のスレッドも Run の中で手伝う）
+	StealingPool bc7Pool(maxThreads - 1u);
+	const uint32_t threads = std::min<uint32_t>(maxThreads, static_cast<uint32_t>(inputs.size()));
+	const bool parallelCompress = inputs.size() < maxThreads;
+
+	// ファイル単位で取り合う
+	std::vector<Result> results(inputs.size());
+	std::atomic<size_t> next{0u};
+	auto worker = [&] {
+		for (size_t i = next++; i < inputs.size(); i = next++)
+			Process(inputs[i], options, parallelCompress, bc7Pool, results[i]);
+	};
+	std::vector<std::thread> pool;
+	for (uint32_t t = 1; t < threads; ++t)
+		pool.emplace_back(worker);
+	worker();
+	for (std::thread& t : pool)
+		t.join();
+
+	// 結果
+	int failed = 0;
+	uintmax_t pngTotal = 0u, ddsTotal = 0u, vramBefore = 0u;
+	for (const Result& r : results) {
+		if (!r.error.empty()) {
+			std::fprintf(stderr, "error: %s: %s\n", r.path.c_str(), r.error.c_str());
+			failed++;
+			continue;
+		}
+		std::printf("%-48s %5ux%-5u mips %2zu %-6s %-5s %6.2f dB  png %8ju  dds %8ju\n", r.path.c_str(), r.width, r.height, r.mips, AlphaName(r.alpha), FormatName(r.format), r.psnr,
+		            r.pngBytes, r.ddsBytes);
+		pngTotal += r.pngBytes;
+		ddsTotal += r.ddsBytes;
+		vramBefore += static_cast<uintmax_t>(r.width) * r.height * 4u;
+	}
+	std::printf("%zu textures, %d failed, png %ju bytes, dds %ju bytes (RGBA8 top mip was %ju bytes)\n", results.size(), failed, pngTotal, ddsTotal, vramBefore);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,270 @@
+// TileMap のベンチマーク（オフライン・Linux / Windows 共通）
+//
+// ビルド例（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -IDirectXGame Tools/TileBench/TileBench.cpp DirectXGame/TileMap.cpp DirectXGame/FileBytes.cpp -o tilebench
+//   -DTILEMAP_NO_SWAR を付けると CSV を1セルずつだけで読む TileMap で計れる
+//
+// 使い方:
+//   tilebench [-g 幅x高さ] [-d 密度] [-r レイ数] [-l 長さ] [DirectXGame/Resources/blocks.csv]
+//   -g : CSV の代わりに乱数で埋めたマップを作る（CSV に書き出してから読むので、読む速さも計れる）
+//   -d : -g で埋める割合（既定 0.1）
+//   -r : 撃つレイの数（既定 4000000）。箱・空きマス探しも同じ数だけ引く
+//   -l : レイの長さの上限（マス、既定 32）
+//
+// ・CSV を繰り返し読み、1回あたりの時間と MB/s を表示する
+// ・マップの少し外まで含めた範囲から乱数でレイ（線分）を作り、TileMap::Raycast と1マスずつ歩く DDA で撃って時間を比べる
+//   結果（当たったマス・面、t は 1e-4 まで）が食い違ったものの数も出す（食い違うのは角のごく近くを通り、丸めでどちらのマスを先に見るかが変わったものだけ）
+// ・同じく箱の重なり（一辺 8 マスまで）と、埋まりマスからの最寄りの空きマス探しの時間を出す
+#include "FileBytes.h"
+#include "TileMap.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Segment {
+	float x0, y0, x1, y1;
+};
+
+void PrintUsage() { std::fprintf(stderr, "usage: tilebench [-g WxH] [-d density] [-r rays] [-l length] [file.csv]\n"); }
+
+// 比べる相手：1マスずつ歩く DDA（境目の t は t0 + i * tDelta、横と縦が同時なら縦が先）
+bool RaycastPerCell(const TileMap& map, const Segment& s, TileMap::RayHit& hit) {
+	const int32_t width = static_cast<int32_t>(map.GetWidth());
+	const int32_t height = static_cast<int32_t>(map.GetHeight());
+	const float dx = s.x1 - s.x0;
+	const float dy = s.y1 - s.y0;
+	float tEnter = 0.0f;
+	float tExit = 1.0f;
+	int32_t enterAxis = -1;
+	auto clip = [&](float origin, float delta, float size, int32_t axis) {
+		if (delta == 0.0f)
+			return origin >= 0.0f && origin < size;
+		float ta = (0.0f - origin) / delta;
+		float tb = (size - origin) / delta;
+		if (ta > tb)
+			std::swap(ta, tb);
+		if (ta > tEnter) {
+			tEnter = ta;
+			enterAxis = axis;
+		}
+		tExit = (std::min)(tExit, tb);
+		return true;
+	};
+	if (!clip(s.x0, dx, float(width), 0) || !clip(s.y0, dy, float(height), 1) || tEnter >= tExit)
+		return false;
+
+	const int32_t stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+	const int32_t stepY = dy > 0.0f ? 1 : (dy < 0.0f ? -1 : 0);
+	int32_t cx = std::clamp(static_cast<int32_t>(std::floor(s.x0 + dx * tEnter)), 0, width - 1);
+	int32_t cy = std::clamp(static_cast<int32_t>(std::floor(s.y0 + dy * tEnter)), 0, height - 1);
+	const float kInfinity = std::numeric_limits<float>::infinity();
+	const float tDeltaX = stepX ? 1.0f / std::abs(dx) : kInfinity;
+	const float tDeltaY = stepY ? 1.0f / std::abs(dy) : kInfinity;
+	const float tX0 = stepX ? (float(stepX > 0 ? cx + 1 : cx) - s.x0) / dx : kInfinity;
+	const float tY0 = stepY ? (float(stepY > 0 ? cy + 1 : cy) - s.y0) / dy : kInfinity;
+	int32_t ix = 0;
+	int32_t iy = 0;
+	hit = {tEnter, cx, cy, enterAxis == 0 ? -stepX : 0, enterAxis == 1 ? -stepY : 0};
+	for (;;) {
+		if (map.IsSolid(cx, cy)) {
+			hit.x = cx;
+			hit.y = cy;
+			return true;
+		}
+		const float tX = stepX ? tX0 + float(ix) * tDeltaX : kInfinity;
+		const float tY = stepY ? tY0 + float(iy) * tDeltaY : kInfinity;
+		if ((std::min)(tX, tY) >= tExit)
+			return false;
+		if (tX < tY) {
+			cx += stepX;
+			++ix;
+			hit = {tX, 0, 0, -stepX, 0};
+			if (cx < 0 || cx >= width)
+				return false;
+		} else {
+			cy += stepY;
+			++iy;
+			hit = {tY, 0, 0, 0, -stepY};
+			if (cy < 0 || cy >= height)
+				return false;
+		}
+	}
+}
+
+// f を 0.2 秒以上かかるまで回数を増やしながら呼び、1回あたりの時間（マイクロ秒）を返す
+template<class F> double MeasureRepeated(F&& f) {
+	for (uint32_t repeat = 1u;; repeat *= 2u) {
+		const auto t0 = std::chrono::steady_clock::now();
+		for (uint32_t r = 0; r < repeat; ++r)
+			f();
+		const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+		if (us >= 200000.0)
+			return us / repeat;
+	}
+}
+
+template<class F> double MeasureOnce(F&& f) {
+	const auto t0 = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	uint32_t genWidth = 0u;
+	uint32_t genHeight = 0u;
+	double density = 0.1;
+	uint32_t rayCount = 4000000u;
+	float maxLength = 32.0f;
+	std::string path;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+			if (std::sscanf(argv[++i], "%ux%u", &genWidth, &genHeight) != 2) {
+				PrintUsage();
+				return 1;
+			}
+		} else if (std::strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+			density = std::atof(argv[++i]);
+		} else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+			rayCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+			maxLength = static_cast<float>(std::atof(argv[++i]));
+		} else {
+			path = argv[i];
+		}
+	}
+	if ((path.empty() && genWidth == 0u) || rayCount == 0u || maxLength <= 0.0f) {
+		PrintUsage();
+		return 1;
+	}
+
+	std::mt19937 rng(12345u);
+	std::vector<uint8_t> csv;
+	if (genWidth) {
+		// 0/1 の CSV を作る
+		std::bernoulli_distribution solid(density);
+		csv.reserve(size_t(genWidth) * genHeight * 2u);
+		for (uint32_t y = 0; y < genHeight; ++y) {
+			for (uint32_t x = 0; x < genWidth; ++x) {
+				csv.push_back(solid(rng) ? '1' : '0');
+				csv.push_back(x + 1u < genWidth ? ',' : '\n');
+			}
+		}
+		path = std::to_string(genWidth) + "x" + std::to_string(genHeight) + " generated";
+	} else if (!ReadFileBytes(path, csv)) {
+		std::fprintf(stderr, "cannot read %s\n", path.c_str());
+		return 1;
+	}
+
+	TileMap map;
+	if (!map.Parse(csv)) {
+		std::fprintf(stderr, "cannot parse %s\n", path.c_str());
+		return 1;
+	}
+	const double parseUs = MeasureRepeated([&] { map.Parse(csv); });
+	std::vector<TileMap::Span> spans;
+	map.GetSpans(spans);
+	std::printf("%s: %u x %u, %u solid, %zu spans\n", path.c_str(), map.GetWidth(), map.GetHeight(), map.CountSolid(), spans.size());
+	std::printf("parse: %.2f us per parse, %.0f MB/s (%zu bytes)\n", parseUs, double(csv.size()) / parseUs, csv.size());
+
+	// マップの外に少しはみ出す範囲から始点を選び、向きと長さは一様に
+	const float margin = 2.0f;
+	std::uniform_real_distribution<float> ux(-margin, float(map.GetWidth()) + margin);
+	std::uniform_real_distribution<float> uy(-margin, float(map.GetHeight()) + margin);
+	std::uniform_real_distribution<float> ua(0.0f, 6.2831853f);
+	std::uniform_real_distribution<float> ul(0.0f, maxLength);
+	std::vector<Segment> segments(rayCount);
+	for (Segment& s : segments) {
+		s.x0 = ux(rng);
+		s.y0 = uy(rng);
+		const float a = ua(rng);
+		const float l = ul(rng);
+		s.x1 = s.x0 + std::cos(a) * l;
+		s.y1 = s.y0 + std::sin(a) * l;
+	}
+
+	uint32_t hits = 0u;
+	double tSum = 0.0;
+	const double rayMs = MeasureOnce([&] {
+		TileMap::RayHit hit;
+		for (const Segment& s : segments) {
+			if (map.Raycast(s.x0, s.y0, s.x1, s.y1, &hit)) {
+				hits++;
+				tSum += hit.t;
+			}
+		}
+	});
+	uint32_t refHits = 0u;
+	const double refMs = MeasureOnce([&] {
+		TileMap::RayHit hit;
+		for (const Segment& s : segments) {
+			if (RaycastPerCell(map, s, hit))
+				refHits++;
+		}
+	});
+	// 食い違いは時間の外で数える
+	uint32_t mismatches = 0u;
+	for (const Segment& s : segments) {
+		TileMap::RayHit a;
+		TileMap::RayHit b;
+		const bool hitA = map.Raycast(s.x0, s.y0, s.x1, s.y1, &a);
+		const bool hitB = RaycastPerCell(map, s, b);
+		if (hitA != hitB || (hitA && (a.x != b.x || a.y != b.y || std::abs(a.t - b.t) > 1e-4f || a.normalX != b.normalX || a.normalY != b.normalY)))
+			mismatches++;
+	}
+	std::printf("raycast: %u rays up to %.0f cells, %u hit (t sum %.1f)\n", rayCount, maxLength, hits, tSum);
+	std::printf("  word spans : %.1f ms, %.1f ns per ray, %.1f M rays/s\n", rayMs, rayMs * 1e6 / rayCount, rayCount / rayMs / 1000.0);
+	std::printf("  per cell   : %.1f ms, %.1f ns per ray (%.2fx), %u hit, %u mismatches\n", refMs, refMs * 1e6 / rayCount, refMs / rayMs, refHits, mismatches);
+
+	// 箱の重なり（一辺 0.5 ～ 8 マス）
+	std::uniform_real_distribution<float> ub(0.5f, 8.0f);
+	std::vector<Segment> boxes(rayCount);
+	for (Segment& b : boxes) {
+		b.x0 = ux(rng);
+		b.y0 = uy(rng);
+		b.x1 = b.x0 + ub(rng);
+		b.y1 = b.y0 + ub(rng);
+	}
+	uint32_t overlaps = 0u;
+	const double boxMs = MeasureOnce([&] {
+		for (const Segment& b : boxes)
+			overlaps += map.OverlapsBox(b.x0, b.y0, b.x1, b.y1);
+	});
+	std::printf("overlap: %.1f ns per box, %u of %u overlap\n", boxMs * 1e6 / rayCount, overlaps, rayCount);
+
+	// 埋まりマスから最寄りの空きマス
+	std::vector<int32_t> solids;
+	for (int32_t y = 0; y < static_cast<int32_t>(map.GetHeight()); ++y) {
+		for (int32_t x = 0; x < static_cast<int32_t>(map.GetWidth()); ++x) {
+			if (map.IsSolid(x, y)) {
+				solids.push_back(x);
+				solids.push_back(y);
+			}
+		}
+	}
+	if (!solids.empty()) {
+		const size_t count = solids.size() / 2u;
+		int64_t distanceSum = 0;
+		const double nearMs = MeasureOnce([&] {
+			for (uint32_t i = 0; i < rayCount; ++i) {
+				const size_t k = (size_t(i) * 2654435761u) % count;
+				int32_t fx = 0;
+				int32_t fy = 0;
+				if (map.FindNearestFree(solids[k * 2u], solids[k * 2u + 1u], fx, fy))
+					distanceSum += std::abs(fx - solids[k * 2u]) + std::abs(fy - solids[k * 2u + 1u]);
+			}
+		});
+		std::printf("nearest free: %.1f ns per query from a solid cell (mean |dx|+|dy| %.2f cells)\n", nearMs * 1e6 / rayCount, double(distanceSum) / rayCount);
+	}
+	return 0;
+}